@@ -0,0 +1,68 @@
+#define _POSIX_C_SOURCE 200809L
+#define CLI_THREADS 8
+#include <stdio.h>
+#include <time.h>
+
+#include "cli.h"
+
+// Startup of a tool with three independent initializations that wait on I/O
+// (simulated with 30 ms waits: load a model, open the output, warm a cache) and
+// 100 000 operands to scan. The initializations are done in the handlers, as they
+// are met, or started with `cliasync()`.
+
+#define OPERANDS 100000
+#define WAIT_MS  30
+
+static char *argv[OPERANDS + 8];
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static char *init(char *arg)
+{
+  (void)arg;
+  nanosleep(&(struct timespec){0, WAIT_MS * 1000000L}, NULL);
+  return NULL;
+}
+
+static int async;
+static long found;
+
+static int scan(int argc, char **argv)
+{
+  found = 0;
+  clioptions("b_async", argc, argv) {
+    cliopt("-m, --model file\tThe model")   { if (async) cliasync(init); else init(cliarg); }
+    cliopt("-o, --output file\tThe output") { if (async) cliasync(init); else init(cliarg); }
+    cliopt("-c, --cache dir\tThe cache")    { if (async) cliasync(init); else init(cliarg); }
+    cliopt() {
+      found += strlen(cliarg);
+    }
+  }
+  return 0;
+}
+
+int main(void)
+{
+  double t0, t1;
+  int argc = 1;
+
+  argv[0] = "b_async";
+  argv[argc++] = "-m"; argv[argc++] = "model.bin";
+  argv[argc++] = "-o"; argv[argc++] = "out.txt";
+  argv[argc++] = "-c"; argv[argc++] = "/tmp/cache";
+  for (int k = 0; k < OPERANDS; k++) argv[argc++] = "operand.txt";
+
+  printf("Startup with 3 independent initializations (%d ms each)\n", WAIT_MS);
+  for (async = 0; async <= 1; async++) {
+    t0 = now();
+    scan(argc, argv);
+    t1 = now();
+    printf("  %-22s %7.2f ms\n", async ? "cliasync (8 threads)" : "in the handlers", (t1 - t0) * 1e3);
+  }
+  return 0;
+}
@@ -0,0 +1,81 @@
+#define _POSIX_C_SOURCE 200809L
+#define CLI_THREADS 8
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "cli.h"
+
+// Checking that 200 000 file operands exist (with `stat()`) while scanning the
+// arguments, and deferring the checks to run them on `CLI_THREADS` threads.
+// The operands cycle through 1000 files created in a temporary directory.
+
+#define OPERANDS 200000
+#define FILES    1000
+
+static char names[FILES][64];
+static char *argv[OPERANDS + 1];
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static char *exists(char *arg)
+{
+  struct stat st;
+  return stat(arg, &st) == 0 ? NULL : "File not found";
+}
+
+static int defer;
+static int found;
+
+static int scan(int argc, char **argv)
+{
+  found = 0;
+  clioptions("b_defer", argc, argv) {
+    cliopt("-h, --help\tThis help") {
+      cliusage(CLIEXIT);
+    }
+    cliopt() {
+      if (defer) clidefer(exists);
+      else {
+        char *err = exists(cliarg);
+        if (err) clierror(err, cliarg);
+      }
+      found++;
+    }
+  }
+  return 0;
+}
+
+int main(void)
+{
+  char dir[] = "/tmp/b_deferXXXXXX";
+  double t0, t1;
+
+  if (mkdtemp(dir) == NULL) return 1;
+  for (int k = 0; k < FILES; k++) {
+    snprintf(names[k], sizeof(names[k]), "%s/file%04d", dir, k);
+    FILE *f = fopen(names[k], "w");
+    if (f) fclose(f);
+  }
+  argv[0] = "b_defer";
+  for (int k = 1; k <= OPERANDS; k++) argv[k] = names[k % FILES];
+
+  printf("Validation of %d file operands (stat)\n", OPERANDS);
+  for (defer = 0; defer <= 1; defer++) {
+    t0 = now();
+    scan(OPERANDS + 1, argv);
+    t1 = now();
+    printf("  %-22s %7.2f ms  (%d operands)\n", defer ? "deferred (8 threads)" : "immediate",
+                                                (t1 - t0) * 1e3, found);
+  }
+
+  for (int k = 0; k < FILES; k++) remove(names[k]);
+  rmdir(dir);
+  return 0;
+}
@@ -0,0 +1,357 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <time.h>
+
+#include "cli.h"
+
+// A program with 16 commands with 64 options each: time to define and check the
+// options for an invocation of one command, when all the options are in the same
+// `clioptions()` block, each command has its own (`clicommand()`) or each command is
+// an applet of a multi-call program invoked by its name (`cliapplet()`).
+
+#define RUNS 2000
+
+static int n_flags, n_values;
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int flat(int argc, char **argv)
+{
+  clioptions("b_family", argc, argv) {
+    cliopt("<f00>\tCommand f00") { }
+    cliopt("<f01>\tCommand f01") { }
+    cliopt("<f02>\tCommand f02") { }
+    cliopt("<f03>\tCommand f03") { }
+    cliopt("<f04>\tCommand f04") { }
+    cliopt("<f05>\tCommand f05") { }
+    cliopt("<f06>\tCommand f06") { }
+    cliopt("<f07>\tCommand f07") { }
+    cliopt("<f08>\tCommand f08") { }
+    cliopt("<f09>\tCommand f09") { }
+    cliopt("<f10>\tCommand f10") { }
+    cliopt("<f11>\tCommand f11") { }
+    cliopt("<f12>\tCommand f12") { }
+    cliopt("<f13>\tCommand f13") { }
+    cliopt("<f14>\tCommand f14") { }
+    cliopt("<f15>\tCommand f15") { }
+    {
+#define FAM "f00"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f01"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f02"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f03"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f04"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f05"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f06"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f07"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f08"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f09"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f10"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f11"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f12"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f13"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f14"
+#include "b_family.h"
+#undef FAM
+    }
+    {
+#define FAM "f15"
+#include "b_family.h"
+#undef FAM
+    }
+    cliopt();
+  }
+  return 0;
+}
+
+static int f00_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f00"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f01_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f01"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f02_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f02"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f03_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f03"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f04_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f04"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f05_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f05"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f06_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f06"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f07_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f07"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f08_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f08"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f09_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f09"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f10_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f10"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f11_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f11"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f12_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f12"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f13_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f13"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f14_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f14"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int f15_cli(int argc, char **argv)
+{
+  clioptions(argc, argv) {
+#define FAM "f15"
+#include "b_family.h"
+#undef FAM
+    cliopt();
+  }
+  return 0;
+}
+
+static int lazy(int argc, char **argv)
+{
+  clioptions("b_family", argc, argv) {
+    cliopt("<f00>\tCommand f00") { clicommand(f00_cli); }
+    cliopt("<f01>\tCommand f01") { clicommand(f01_cli); }
+    cliopt("<f02>\tCommand f02") { clicommand(f02_cli); }
+    cliopt("<f03>\tCommand f03") { clicommand(f03_cli); }
+    cliopt("<f04>\tCommand f04") { clicommand(f04_cli); }
+    cliopt("<f05>\tCommand f05") { clicommand(f05_cli); }
+    cliopt("<f06>\tCommand f06") { clicommand(f06_cli); }
+    cliopt("<f07>\tCommand f07") { clicommand(f07_cli); }
+    cliopt("<f08>\tCommand f08") { clicommand(f08_cli); }
+    cliopt("<f09>\tCommand f09") { clicommand(f09_cli); }
+    cliopt("<f10>\tCommand f10") { clicommand(f10_cli); }
+    cliopt("<f11>\tCommand f11") { clicommand(f11_cli); }
+    cliopt("<f12>\tCommand f12") { clicommand(f12_cli); }
+    cliopt("<f13>\tCommand f13") { clicommand(f13_cli); }
+    cliopt("<f14>\tCommand f14") { clicommand(f14_cli); }
+    cliopt("<f15>\tCommand f15") { clicommand(f15_cli); }
+    cliopt();
+  }
+  return 0;
+}
+
+static cli_applet_t applets[] = {
+  {"f00", f00_cli}, {"f01", f01_cli}, {"f02", f02_cli}, {"f03", f03_cli},
+  {"f04", f04_cli}, {"f05", f05_cli}, {"f06", f06_cli}, {"f07", f07_cli},
+  {"f08", f08_cli}, {"f09", f09_cli}, {"f10", f10_cli}, {"f11", f11_cli},
+  {"f12", f12_cli}, {"f13", f13_cli}, {"f14", f14_cli}, {"f15", f15_cli},
+};
+
+int main(void)
+{
+  char *argv[] = {"b_family", "f11", "--f11-opt00", "3", "--f11-opt63", "--f11-opt17", "x", NULL};
+  int argc = sizeof(argv) / sizeof(argv[0]) - 1;
+  double t0, t1;
+
+  printf("One command out of 16 (64 options each)\n");
+  t0 = now();
+  for (int k = 0; k < RUNS; k++) flat(argc, argv);
+  t1 = now();
+  printf("  %-22s %8.2f us\n", "one block", (t1 - t0) * 1e6 / RUNS);
+
+  t0 = now();
+  for (int k = 0; k < RUNS; k++) lazy(argc, argv);
+  t1 = now();
+  printf("  %-22s %8.2f us\n", "clicommand()", (t1 - t0) * 1e6 / RUNS);
+
+  argv[1] = "/usr/bin/f11";
+  t0 = now();
+  for (int k = 0; k < RUNS; k++) cliapplet(argc - 1, argv + 1, applets);
+  t1 = now();
+  printf("  %-22s %8.2f us\n", "cliapplet()", (t1 - t0) * 1e6 / RUNS);
+  return (n_flags + n_values) == 0;
+}
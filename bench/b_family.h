@@ -0,0 +1,66 @@
+// The options of a command family named `FAM` (included by b_family.c)
+
+cliopt("--" FAM "-opt00 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt01\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt02\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt03\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt04 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt05\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt06\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt07\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt08 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt09\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt10\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt11\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt12 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt13\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt14\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt15\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt16 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt17\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt18\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt19\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt20 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt21\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt22\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt23\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt24 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt25\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt26\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt27\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt28 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt29\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt30\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt31\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt32 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt33\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt34\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt35\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt36 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt37\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt38\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt39\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt40 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt41\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt42\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt43\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt44 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt45\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt46\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt47\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt48 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt49\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt50\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt51\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt52 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt53\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt54\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt55\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt56 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt57\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt58\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt59\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt60 n\tAn option with a value") { n_values++; }
+cliopt("--" FAM "-opt61\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt62\tA flag") { n_flags++; }
+cliopt("--" FAM "-opt63\tA flag") { n_flags++; }
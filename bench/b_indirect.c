@@ -0,0 +1,97 @@
+#define _POSIX_C_SOURCE 200809L
+#define CLI_INDIRECT
+#include <stdio.h>
+#include <time.h>
+
+#include "cli.h"
+
+// A tool that takes a 16 MB document as `--doc @file`: reading it in the handler with
+// `fopen()`/`fread()` compared with `cliargview()`, when the handler only needs the
+// value, when it reads it once and when the option is given but not used.
+
+#define SIZE (16 << 20)
+#define RUNS 50
+
+static char path[] = "/tmp/b_indirectXXXXXX";
+static int mode;         // 0: fread, 1: cliargview
+static int scan;         // Read the value once
+static int use = 1;      // Get the value at all
+static long braces;
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static char *read_file(char *name, size_t *len)
+{
+  FILE *f = fopen(name, "rb");
+  char *buf = NULL;
+  long n;
+  if (f == NULL) return NULL;
+  if (fseek(f, 0, SEEK_END) == 0 && (n = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0 &&
+      (buf = malloc((size_t)n + 1)) != NULL) {
+    *len = fread(buf, 1, (size_t)n, f);
+    buf[*len] = '\0';
+  }
+  fclose(f);
+  return buf;
+}
+
+static int tool(int argc, char **argv)
+{
+  clioptions("b_indirect", argc, argv) {
+    cliopt("-d, --doc @json\tThe document") {
+      char *doc = NULL;
+      size_t len = 0;
+      if (!use) continue;
+      if (mode == 0) doc = read_file(cliarg + 1, &len);
+      else doc = cliargview(&len);
+      if (doc == NULL) clierror("", cliarg);
+      if (scan) for (size_t k = 0; k < len; k++) braces += (doc[k] == '{');
+      if (mode == 0) free(doc);
+    }
+    cliopt("-v, --verbose\tMore output") { }
+    cliopt();
+  }
+  if (mode == 1) cliunmap();
+  return 0;
+}
+
+static double run(int m, int s, int u, char **args)
+{
+  double t0;
+  mode = m; scan = s; use = u;
+  tool(3, args);   // Warm up (and the file in the page cache)
+  t0 = now();
+  for (int k = 0; k < RUNS; k++) tool(3, args);
+  return (now() - t0) / RUNS;
+}
+
+int main(void)
+{
+  char arg[32], *args[] = {"b_indirect", "-d", arg, NULL};
+  char *chunk = "{\"id\": 12345, \"name\": \"a name\", \"tags\": [\"x\", \"y\"]},\n";
+  size_t n = strlen(chunk), len = 0;
+  int fd;
+  FILE *f;
+
+  if ((fd = mkstemp(path)) < 0 || (f = fdopen(fd, "wb")) == NULL) return 1;
+  while (len + n < SIZE) len += fwrite(chunk, 1, n, f);
+  fclose(f);
+  snprintf(arg, sizeof(arg), "@%s", path);
+
+  printf("A document of %zu bytes (`--doc @file`)\n", len);
+  printf("  %-28s %12s %12s\n", "", "fread", "cliargview");
+  printf("  %-28s %9.1f us %9.1f us\n", "get the value",
+         run(0, 0, 1, args) * 1e6, run(1, 0, 1, args) * 1e6);
+  printf("  %-28s %9.1f us %9.1f us\n", "get it and read it once",
+         run(0, 1, 1, args) * 1e6, run(1, 1, 1, args) * 1e6);
+  printf("  %-28s %9.1f us %9.1f us\n", "don't use it",
+         run(0, 0, 0, args) * 1e6, run(1, 0, 0, args) * 1e6);
+  printf("  (%ld)\n", braces);
+  remove(path);
+  return 0;
+}
@@ -0,0 +1,124 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <time.h>
+
+#include "cli.h"
+
+// The arguments of `b_scan.c` (300 000 of them, 24 options) scanned by a `clioptions()`
+// block and pulled one at a time with `clinext()`; then with 100 more options defined,
+// which `clinext()` finds in the index of the names.
+
+#define ARGS   300000
+#define ROUNDS 5
+#define EXTRA  100
+
+static char *argv[ARGS + 1];
+static int counts[8];
+
+static cli_optdef_t opts[24 + EXTRA + 1] = {
+  {"-a, --all\tAll"}, {"-b, --block-size size\tBlock size"}, {"-c, --ctime\tCtime"},
+  {"-d, --directory\tDirectories"}, {"-f, --full-time\tFull time"},
+  {"-g, --group-directories-first\tGroup"}, {"-i, --inode\tInode"}, {"-k, --kibibytes\tKB"},
+  {"-l, --long-listing-format\tLong"}, {"-m, --comma-separated\tCommas"},
+  {"-n, --numeric-uid-gid\tNumeric"}, {"-o, --omit-group\tOmit"},
+  {"-p, --indicator-style style\tStyle"}, {"-q, --hide-control-chars\tHide"},
+  {"-r, --reverse\tReverse"}, {"-s, --size\tSize"}, {"-t, --sort-by-time\tTime"},
+  {"-u, --access-time\tAccess"}, {"-w, --width cols\tWidth"}, {"-x, --across\tAcross"},
+  {"-z, --zero-terminated\tZero"}, {"--color [when]\tColor"}, {"--time-style style\tTime style"},
+  {NULL}
+};
+static int slot[] = {0, 1, 2, 2, 2, 2, 2, 2, 3, 2, 2, 2, 2, 2, 2, 2, 2, 2, 4, 2, 2, 5, 6};
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int scan(int argc, char **argv)
+{
+  clioptions("b_iter", argc, argv) {
+    cliopt("-a, --all\tAll") { counts[0]++; }
+    cliopt("-b, --block-size size\tBlock size") { counts[1]++; }
+    cliopt("-c, --ctime\tCtime") { counts[2]++; }
+    cliopt("-d, --directory\tDirectories") { counts[2]++; }
+    cliopt("-f, --full-time\tFull time") { counts[2]++; }
+    cliopt("-g, --group-directories-first\tGroup") { counts[2]++; }
+    cliopt("-i, --inode\tInode") { counts[2]++; }
+    cliopt("-k, --kibibytes\tKB") { counts[2]++; }
+    cliopt("-l, --long-listing-format\tLong") { counts[3]++; }
+    cliopt("-m, --comma-separated\tCommas") { counts[2]++; }
+    cliopt("-n, --numeric-uid-gid\tNumeric") { counts[2]++; }
+    cliopt("-o, --omit-group\tOmit") { counts[2]++; }
+    cliopt("-p, --indicator-style style\tStyle") { counts[2]++; }
+    cliopt("-q, --hide-control-chars\tHide") { counts[2]++; }
+    cliopt("-r, --reverse\tReverse") { counts[2]++; }
+    cliopt("-s, --size\tSize") { counts[2]++; }
+    cliopt("-t, --sort-by-time\tTime") { counts[2]++; }
+    cliopt("-u, --access-time\tAccess") { counts[2]++; }
+    cliopt("-w, --width cols\tWidth") { counts[4]++; }
+    cliopt("-x, --across\tAcross") { counts[2]++; }
+    cliopt("-z, --zero-terminated\tZero") { counts[2]++; }
+    cliopt("--color [when]\tColor") { counts[5]++; }
+    cliopt("--time-style style\tTime style") { counts[6]++; }
+    cliopt() { counts[7]++; }
+  }
+  return 0;
+}
+
+static int pull(int argc, char **argv)
+{
+  cli_iter_t it;
+  cli_event_t *ev;
+  cliiter(&it, opts, argc, argv);
+  while ((ev = clinext(&it)) != NULL) {
+    if (ev->err) clierror(ev->err, ev->arg, ev->len);
+    counts[ev->opt < 0 ? 7 : ev->opt < 23 ? slot[ev->opt] : 2]++;
+  }
+  return 0;
+}
+
+static double run(int (*fn)(int, char **), int argc, int *operands)
+{
+  double t0, t1, best = 1e9;
+  memset(counts, 0, sizeof(counts));
+  for (int r = 0; r < ROUNDS; r++) {
+    t0 = now();
+    fn(argc, argv);
+    t1 = now();
+    if (t1 - t0 < best) best = t1 - t0;
+  }
+  *operands = counts[7] / ROUNDS;
+  return best * 1e9 / (argc - 1);
+}
+
+int main(void)
+{
+  static char *pattern[] = {
+    "--long-listing-format", "--width=120", "-alr", "file.txt", "--time-style", "iso",
+    "--group-directories-first", "another/file", "--color=always", "-b", "4096"
+  };
+  static char names[EXTRA][32];
+  int n = sizeof(pattern) / sizeof(pattern[0]), ops[3];
+  double t[3];
+
+  argv[0] = "b_iter";
+  for (int k = 1; k <= ARGS; k++) argv[k] = pattern[(k - 1) % n];
+  int argc = ARGS - (ARGS % n) + 1;  // Ends with a complete pattern
+  argv[argc] = NULL;
+
+  t[0] = run(scan, argc, &ops[0]);
+  t[1] = run(pull, argc, &ops[1]);
+  for (int k = 0; k < EXTRA; k++) {
+    snprintf(names[k], sizeof(names[k]), "--extra-option-%d\tExtra", k);
+    opts[23 + k].def = names[k];
+  }
+  t[2] = run(pull, argc, &ops[2]);
+
+  printf("Scan of %d arguments\n", argc - 1);
+  printf("  %-30s %7.1f ns/argument (%d operands)\n", "clioptions(), 24 options", t[0], ops[0]);
+  printf("  %-30s %7.1f ns/argument (%d operands)\n", "clinext(), 24 options", t[1], ops[1]);
+  printf("  %-30s %7.1f ns/argument (%d operands)\n", "clinext(), 124 options", t[2], ops[2]);
+  return 0;
+}
@@ -0,0 +1,103 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <time.h>
+
+#include "cli.h"
+
+// Compare `cliints()` and `clifloats()` with the equivalent `strtoll()` and
+// `strtod()` loops on a list of 100 000 comma separated values, passed through
+// `clioptions()` as a program would get them.
+
+#define VALUES     100000
+#define ITERATIONS 50
+
+static char buf[VALUES * 24];
+static long long ids[VALUES];
+static double    wgt[VALUES];
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int strtoll_loop(char *s, long long *out, int max)
+{
+  int k = 0;
+  char *end;
+  while (*s && k < max) {
+    out[k++] = strtoll(s, &end, 10);
+    if (end == s) return -1;
+    s = end + (*end == ',');
+  }
+  return k;
+}
+
+static int strtod_loop(char *s, double *out, int max)
+{
+  int k = 0;
+  char *end;
+  while (*s && k < max) {
+    out[k++] = strtod(s, &end);
+    if (end == s) return -1;
+    s = end + (*end == ',');
+  }
+  return k;
+}
+
+#define report(name, t0, t1, n) \
+  printf("  %-14s %6.2f ns/value  (%d values)\n", name, ((t1)-(t0))*1e9/(ITERATIONS*(double)VALUES), n)
+
+static int bench(int argc, char **argv)
+{
+  double t0, t1;
+  int n = 0;
+
+  clioptions("b_list") {
+    cliopt("-i ids") {
+      printf("Integers (%.50s...)\n", cliarg);
+
+      t0 = now();
+      for (int k = 0; k < ITERATIONS; k++) n = strtoll_loop(cliarg, ids, VALUES);
+      t1 = now(); report("strtoll", t0, t1, n);
+
+      t0 = now();
+      for (int k = 0; k < ITERATIONS; k++) n = cliints(cliarg, ids, VALUES);
+      t1 = now(); report("cliints", t0, t1, n);
+      if (n < 0) clierror("", cliarg);
+    }
+
+    cliopt("-w weights") {
+      printf("Floats (%.50s...)\n", cliarg);
+
+      t0 = now();
+      for (int k = 0; k < ITERATIONS; k++) n = strtod_loop(cliarg, wgt, VALUES);
+      t1 = now(); report("strtod", t0, t1, n);
+
+      t0 = now();
+      for (int k = 0; k < ITERATIONS; k++) n = clifloats(cliarg, wgt, VALUES);
+      t1 = now(); report("clifloats", t0, t1, n);
+      if (n < 0) clierror("", cliarg);
+    }
+    cliopt();
+  }
+  return 0;
+}
+
+int main(void)
+{
+  unsigned long long x = 1;
+  int n = 0;
+
+  for (int k = 0; k < VALUES; k++, x = x * 6364136223846793005ULL + 1442695040888963407ULL)
+    n += sprintf(buf + n, "%s%llu", k ? "," : "", (x >> 20) % 1000000000);
+  bench(3, (char *[]){"b_list", "-i", buf, NULL});
+
+  n = 0;
+  for (int k = 0; k < VALUES; k++, x = x * 6364136223846793005ULL + 1442695040888963407ULL)
+    n += sprintf(buf + n, "%s%.6f", k ? "," : "", (double)((x >> 20) % 100000000) / 1000.0);
+  bench(3, (char *[]){"b_list", "-w", buf, NULL});
+
+  return 0;
+}
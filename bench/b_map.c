@@ -0,0 +1,83 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include "vrg.h"
+
+// Compare the code generated by `VRG_map()` with the equivalent `va_arg` loop.
+// Values are read from a volatile array to prevent the compiler from computing
+// the results at compile time.
+
+#define ITERATIONS 50000000
+
+static volatile int v[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Sum
+static int sum_va(int n, ...)
+{
+  va_list ap;
+  int s = 0;
+  va_start(ap, n);
+  while (n-- > 0) s += va_arg(ap, int);
+  va_end(ap);
+  return s;
+}
+
+#define sum_arg(x) (x)
+#define sum_vrg(...) (VRG_map(sum_arg, (+), __VA_ARGS__))
+
+// FNV-1a hash of each value
+static uint32_t hash_va(int n, ...)
+{
+  va_list ap;
+  uint32_t h = 2166136261u;
+  va_start(ap, n);
+  while (n-- > 0) h = (h ^ (uint32_t)va_arg(ap, int)) * 16777619u;
+  va_end(ap);
+  return h;
+}
+
+#define hash_arg(x) h = (h ^ (uint32_t)(x)) * 16777619u
+#define hash_vrg(...) do { VRG_foreach(hash_arg, __VA_ARGS__); } while (0)
+
+#define report(name, t0, t1, chk) \
+  printf("%-12s %6.2f ns/call  (check: %u)\n", name, ((t1)-(t0))*1e9/ITERATIONS, (unsigned)(chk))
+
+int main(void)
+{
+  double t0, t1;
+  uint32_t acc;
+
+  printf("VRG_map vs. va_arg loop (8 int arguments, %d calls)\n", ITERATIONS);
+
+  acc = 0; t0 = now();
+  for (int i = 0; i < ITERATIONS; i++) acc += sum_va(8, v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+  t1 = now(); report("sum va_arg", t0, t1, acc);
+
+  acc = 0; t0 = now();
+  for (int i = 0; i < ITERATIONS; i++) acc += sum_vrg(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+  t1 = now(); report("sum vrg", t0, t1, acc);
+
+  acc = 0; t0 = now();
+  for (int i = 0; i < ITERATIONS; i++) acc += hash_va(8, v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+  t1 = now(); report("hash va_arg", t0, t1, acc);
+
+  acc = 0; t0 = now();
+  for (int i = 0; i < ITERATIONS; i++) {
+    uint32_t h = 2166136261u;
+    hash_vrg(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7]);
+    acc += h;
+  }
+  t1 = now(); report("hash vrg", t0, t1, acc);
+
+  return 0;
+}
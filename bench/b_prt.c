@@ -0,0 +1,78 @@
+#define _POSIX_C_SOURCE 200809L
+#define PRT_FD 9
+#include <stdio.h>
+#include <fcntl.h>
+#include <time.h>
+
+#include "prt.h"
+
+// Formatting a line of text of integers and strings (and one with a `double` as well)
+// with `snprintf()` and with `prtto()` into a buffer, and with `fprintf()` and `prt()`
+// to a file descriptor (`/dev/null`, to measure the formatting and not the device).
+
+#define LINES 1000000
+#define RUNS  5
+
+static char *names[] = {"alpha", "beta", "gamma", "delta"};
+static char buf[1 << 16];
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double run(int mode, int real, FILE *f, size_t *chk)
+{
+  double t0 = now();
+  for (int r = 0; r < RUNS; r++) {
+    prt_out_t o = prtbuf(buf, sizeof(buf));
+    size_t n = 0;
+    for (int k = 0; k < LINES; k++) {
+      if (n > sizeof(buf) - 256) { *chk += n; n = 0; o.len = 0; }
+      if (real) switch (mode) {
+        case 0: n += snprintf(buf + n, sizeof(buf) - n, "id=%d temp=%d name=%s v=%.15g\n",
+                              k, k % 80 - 20, names[k & 3], k * 0.25); break;
+        case 1: n = prtto(&o, "id=", k, " temp=", k % 80 - 20, " name=", names[k & 3],
+                          " v=", k * 0.25, "\n"); break;
+        case 2: fprintf(f, "id=%d temp=%d name=%s v=%.15g\n", k, k % 80 - 20, names[k & 3], k * 0.25); break;
+        case 3: prt("id=", k, " temp=", k % 80 - 20, " name=", names[k & 3], " v=", k * 0.25, "\n"); break;
+      }
+      else switch (mode) {
+        case 0: n += snprintf(buf + n, sizeof(buf) - n, "id=%d temp=%d name=%s\n",
+                              k, k % 80 - 20, names[k & 3]); break;
+        case 1: n = prtto(&o, "id=", k, " temp=", k % 80 - 20, " name=", names[k & 3], "\n"); break;
+        case 2: fprintf(f, "id=%d temp=%d name=%s\n", k, k % 80 - 20, names[k & 3]); break;
+        case 3: prt("id=", k, " temp=", k % 80 - 20, " name=", names[k & 3], "\n"); break;
+      }
+    }
+    *chk += n;
+  }
+  fflush(f);
+  prtflush();
+  return (now() - t0) / RUNS / LINES;
+}
+
+int main(void)
+{
+  int fd = open("/dev/null", O_WRONLY);
+  FILE *f;
+  size_t chk[2] = {0, 0};
+
+  if (fd < 0 || dup2(fd, PRT_FD) != PRT_FD || (f = fdopen(fd, "w")) == NULL) return 1;
+  printf("Lines of text (`id=... temp=... name=...`, with ` v=...` for a double)\n");
+  printf("  %-22s %14s %14s\n", "", "snprintf()", "prtto()");
+  printf("  %-22s %8.1f ns/line %8.1f ns/line\n", "into a buffer",
+         run(0, 0, f, &chk[0]) * 1e9, run(1, 0, f, &chk[1]) * 1e9);
+  printf("  %-22s %8.1f ns/line %8.1f ns/line\n", "into a buffer, double",
+         run(0, 1, f, &chk[0]) * 1e9, run(1, 1, f, &chk[1]) * 1e9);
+  printf("  %-22s %14s %14s\n", "", "fprintf()", "prt()");
+  printf("  %-22s %8.1f ns/line %8.1f ns/line\n", "to a file",
+         run(2, 0, f, chk) * 1e9, run(3, 0, f, chk) * 1e9);
+  printf("  %-22s %8.1f ns/line %8.1f ns/line\n", "to a file, double",
+         run(2, 1, f, chk) * 1e9, run(3, 1, f, chk) * 1e9);
+  printf("  (%s)\n", chk[0] == chk[1] ? "same length" : "DIFFERENT LENGTH");
+  fclose(f);
+  return 0;
+}
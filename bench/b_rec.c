@@ -0,0 +1,164 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stddef.h>
+#include <time.h>
+
+#include "rec.h"
+
+// Encoding, decoding and writing as JSON a telemetry record of 9 fields with the
+// functions generated by `recdefine()`, compared with a generic serializer that walks
+// a table of the fields (name, type and offset) and produces the same output.
+// The generic functions are not inlined, as they would be in a library.
+
+#define RECORDS 200000
+#define RUNS    10
+
+recdefine(telemetry_t, (uint32_t, id), (uint64_t, ts), (int32_t, temp), (uint16_t, flags),
+                       (double, lat), (double, lon), (float, speed), (bool, ok), (rec_str_t, host));
+
+#if defined(__GNUC__) || defined(__clang__)
+#define NOINLINE __attribute__((noinline))
+#else
+#define NOINLINE
+#endif
+
+typedef enum { T_U16, T_U32, T_U64, T_I32, T_F32, T_F64, T_BOOL, T_STR } type_t;
+
+typedef struct {
+  const char *name;
+  type_t      type;
+  size_t      off;
+} field_t;
+
+#define FLD(t_, n_) {#n_, t_, offsetof(telemetry_t, n_)}
+
+static const field_t fields[] = {
+  FLD(T_U32, id), FLD(T_U64, ts), FLD(T_I32, temp), FLD(T_U16, flags), FLD(T_F64, lat),
+  FLD(T_F64, lon), FLD(T_F32, speed), FLD(T_BOOL, ok), FLD(T_STR, host)
+};
+#define NFIELDS (int)(sizeof(fields) / sizeof(fields[0]))
+
+static const size_t type_size[] = {2, 4, 8, 4, 4, 8, 1, 0};
+
+NOINLINE static size_t tbl_encode(const field_t *f, int nf, const void *r, unsigned char *p, size_t size)
+{
+  const char *b = (const char *)r;
+  size_t n = 0;
+  for (int k = 0; k < nf; k++)
+    n += f[k].type == T_STR ? rec_size_rec_str_t((const rec_str_t *)(b + f[k].off)) : type_size[f[k].type];
+  if (n > size) return n;
+  for (int k = 0; k < nf; k++) {
+    const void *x = b + f[k].off;
+    switch (f[k].type) {
+      case T_BOOL: p = rec_put__Bool(p, (const _Bool *)x); break;
+      case T_STR:  p = rec_put_rec_str_t(p, (const rec_str_t *)x); break;
+      default:     p = rec_put_raw(p, x, type_size[f[k].type]); break;
+    }
+  }
+  return n;
+}
+
+NOINLINE static size_t tbl_decode(const field_t *f, int nf, void *r, const unsigned char *buf, size_t len)
+{
+  const unsigned char *p = buf, *e = buf + len;
+  char *b = (char *)r;
+  for (int k = 0; k < nf; k++) {
+    void *x = b + f[k].off;
+    switch (f[k].type) {
+      case T_BOOL: p = rec_get__Bool(p, e, (_Bool *)x); break;
+      case T_STR:  p = rec_get_rec_str_t(p, e, (rec_str_t *)x); break;
+      default:     p = rec_get_raw(p, e, x, type_size[f[k].type]); break;
+    }
+  }
+  return p ? (size_t)(p - buf) : 0;
+}
+
+NOINLINE static size_t tbl_json(const field_t *f, int nf, const void *r, char *buf, size_t size)
+{
+  rec_out_t o = {buf, size, 0};
+  const char *b = (const char *)r;
+  rec_putn(&o, "{", 1);
+  for (int k = 0; k < nf; k++) {
+    const void *x = b + f[k].off;
+    if (k > 0) rec_putn(&o, ",", 1);
+    rec_putn(&o, "\"", 1);
+    rec_putn(&o, f[k].name, strlen(f[k].name));
+    rec_putn(&o, "\":", 2);
+    switch (f[k].type) {
+      case T_U16:  rec_json_uint16_t(&o, (const uint16_t *)x); break;
+      case T_U32:  rec_json_uint32_t(&o, (const uint32_t *)x); break;
+      case T_U64:  rec_json_uint64_t(&o, (const uint64_t *)x); break;
+      case T_I32:  rec_json_int32_t(&o, (const int32_t *)x); break;
+      case T_F32:  rec_json_float(&o, (const float *)x); break;
+      case T_F64:  rec_json_double(&o, (const double *)x); break;
+      case T_BOOL: rec_json__Bool(&o, (const _Bool *)x); break;
+      case T_STR:  rec_json_rec_str_t(&o, (const rec_str_t *)x); break;
+    }
+  }
+  rec_putn(&o, "}", 1);
+  rec_end(&o);
+  return o.len;
+}
+
+static telemetry_t recs[RECORDS];
+static unsigned char bin[RECORDS * 64];
+static size_t offs[RECORDS + 1];
+static char txt[256];
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(void)
+{
+  static char *hosts[] = {"node-1", "node-22", "edge-gateway-3", "db"};
+  double t0, t_enc[2], t_dec[2], t_json[2];
+  size_t total[2] = {0, 0}, chk[2] = {0, 0};
+  telemetry_t d;
+
+  for (int k = 0; k < RECORDS; k++)
+    recs[k] = (telemetry_t){(uint32_t)k, 1700000000000ULL + k, k % 80 - 20, (uint16_t)(k & 0xFF),
+                            45.0 + k * 1e-6, 7.5 - k * 1e-6, (float)(k % 130), k % 3 != 0, hosts[k % 4]};
+
+  for (int m = 0; m < 2; m++) {
+    t0 = now();
+    for (int r = 0; r < RUNS; r++) {
+      size_t n = 0;
+      for (int k = 0; k < RECORDS; k++) {
+        offs[k] = n;
+        n += m ? tbl_encode(fields, NFIELDS, &recs[k], bin + n, sizeof(bin) - n)
+               : recencode(telemetry_t, &recs[k], bin + n, sizeof(bin) - n);
+      }
+      offs[RECORDS] = total[m] = n;
+    }
+    t_enc[m] = (now() - t0) / RUNS / RECORDS;
+
+    t0 = now();
+    for (int r = 0; r < RUNS; r++)
+      for (int k = 0; k < RECORDS; k++) {
+        size_t len = offs[k + 1] - offs[k];
+        chk[m] += m ? tbl_decode(fields, NFIELDS, &d, bin + offs[k], len)
+                    : recdecode(telemetry_t, &d, bin + offs[k], len);
+        chk[m] += d.id;
+      }
+    t_dec[m] = (now() - t0) / RUNS / RECORDS;
+
+    t0 = now();
+    for (int r = 0; r < RUNS; r++)
+      for (int k = 0; k < RECORDS; k++)
+        chk[m] += m ? tbl_json(fields, NFIELDS, &recs[k], txt, sizeof(txt))
+                    : recjson(telemetry_t, &recs[k], txt, sizeof(txt));
+    t_json[m] = (now() - t0) / RUNS / RECORDS;
+  }
+
+  printf("Telemetry records of 9 fields (%zu bytes on average)\n", total[0] / RECORDS);
+  printf("  %-10s %14s %14s\n", "", "recdefine()", "table");
+  printf("  %-10s %8.1f ns/rec %8.1f ns/rec\n", "encode", t_enc[0] * 1e9, t_enc[1] * 1e9);
+  printf("  %-10s %8.1f ns/rec %8.1f ns/rec\n", "decode", t_dec[0] * 1e9, t_dec[1] * 1e9);
+  printf("  %-10s %8.1f ns/rec %8.1f ns/rec\n", "JSON", t_json[0] * 1e9, t_json[1] * 1e9);
+  printf("  (%s)\n", chk[0] == chk[1] && total[0] == total[1] ? "same output" : "DIFFERENT OUTPUT");
+  return 0;
+}
@@ -0,0 +1,78 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <time.h>
+
+#include "cli.h"
+
+// Scanning 300 000 arguments (long options with and without '=value', clusters of
+// short options and operands) with 24 options defined.
+
+#define ARGS   300000
+#define ROUNDS 5
+
+static char *argv[ARGS + 1];
+static int counts[8];
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int scan(int argc, char **argv)
+{
+  clioptions("b_scan", argc, argv) {
+    cliopt("-a, --all\tAll") { counts[0]++; }
+    cliopt("-b, --block-size size\tBlock size") { counts[1]++; }
+    cliopt("-c, --ctime\tCtime") { counts[2]++; }
+    cliopt("-d, --directory\tDirectories") { counts[2]++; }
+    cliopt("-f, --full-time\tFull time") { counts[2]++; }
+    cliopt("-g, --group-directories-first\tGroup") { counts[2]++; }
+    cliopt("-i, --inode\tInode") { counts[2]++; }
+    cliopt("-k, --kibibytes\tKB") { counts[2]++; }
+    cliopt("-l, --long-listing-format\tLong") { counts[3]++; }
+    cliopt("-m, --comma-separated\tCommas") { counts[2]++; }
+    cliopt("-n, --numeric-uid-gid\tNumeric") { counts[2]++; }
+    cliopt("-o, --omit-group\tOmit") { counts[2]++; }
+    cliopt("-p, --indicator-style style\tStyle") { counts[2]++; }
+    cliopt("-q, --hide-control-chars\tHide") { counts[2]++; }
+    cliopt("-r, --reverse\tReverse") { counts[2]++; }
+    cliopt("-s, --size\tSize") { counts[2]++; }
+    cliopt("-t, --sort-by-time\tTime") { counts[2]++; }
+    cliopt("-u, --access-time\tAccess") { counts[2]++; }
+    cliopt("-w, --width cols\tWidth") { counts[4]++; }
+    cliopt("-x, --across\tAcross") { counts[2]++; }
+    cliopt("-z, --zero-terminated\tZero") { counts[2]++; }
+    cliopt("--color [when]\tColor") { counts[5]++; }
+    cliopt("--time-style style\tTime style") { counts[6]++; }
+    cliopt() { counts[7]++; }
+  }
+  return 0;
+}
+
+int main(void)
+{
+  static char *pattern[] = {
+    "--long-listing-format", "--width=120", "-alr", "file.txt", "--time-style", "iso",
+    "--group-directories-first", "another/file", "--color=always", "-b", "4096"
+  };
+  int n = sizeof(pattern) / sizeof(pattern[0]);
+  double t0, t1, best = 1e9;
+
+  argv[0] = "b_scan";
+  for (int k = 1; k <= ARGS; k++) argv[k] = pattern[(k - 1) % n];
+  int argc = ARGS - (ARGS % n) + 1;  // Ends with a complete pattern
+  argv[argc] = NULL;
+
+  for (int r = 0; r < ROUNDS; r++) {
+    t0 = now();
+    scan(argc, argv);
+    t1 = now();
+    if (t1 - t0 < best) best = t1 - t0;
+  }
+  printf("Scan of %d arguments (24 options)\n", argc - 1);
+  printf("  %-22s %7.1f ns/argument (%d operands)\n", "clioptions()", best * 1e9 / (argc - 1),
+                                                      counts[7] / ROUNDS);
+  return 0;
+}
@@ -0,0 +1,87 @@
+#define _POSIX_C_SOURCE 200809L
+#define CLI_SERVE
+#include <stdio.h>
+#include <time.h>
+
+#include "cli.h"
+
+// Latency of one invocation of a tool that loads a 64MB "model" before running:
+// starting a new process each time (cold) vs forwarding the arguments to a server
+// that has already loaded it (warm, `cliforward()`/`cliserve()`).
+
+#define MODEL_SIZE (1 << 24)
+#define COLD_RUNS  20
+#define WARM_RUNS  500
+
+static unsigned int *model = NULL;
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void load_model(void)
+{
+  model = malloc(MODEL_SIZE * sizeof(unsigned int));
+  if (model == NULL) exit(1);
+  unsigned int x = 1;
+  for (int k = 0; k < MODEL_SIZE; k++) model[k] = (x = x * 1664525u + 1013904223u);
+}
+
+static int run(int argc, char **argv)
+{
+  int rays = 32;
+  clioptions("b_serve", argc, argv) {
+    cliopt("-x, --xray num-rays\tNumber of rays") {
+      rays = atoi(cliarg);
+    }
+    cliopt("datafile\tThe input file") { }
+    cliopt();
+  }
+  unsigned int sum = 0;
+  for (int k = 0; k < rays; k++) sum += model[(k * 7919u) % MODEL_SIZE];
+  return sum & 1;
+}
+
+int main(int argc, char *argv[])
+{
+  char sock[] = "/tmp/b_serve.sock";
+  char *args[] = {argv[0], "-x", "10", "data.txt", NULL};
+  double t0, t1;
+  pid_t pid;
+
+  if (argc > 1) {  // Cold run: this is the tool itself
+    load_model();
+    return run(argc, argv);
+  }
+
+  if ((pid = fork()) == 0) {
+    load_model();
+    cliserve(sock, run);
+    _exit(1);
+  }
+  while (cliforward(sock, 4, args) == -1)
+    nanosleep(&(struct timespec){0, 10000000}, NULL);
+
+  printf("Latency of an invocation (64MB model)\n");
+  t0 = now();
+  for (int k = 0; k < COLD_RUNS; k++) {
+    pid_t p = fork();
+    if (p == 0) { execv(argv[0], args); _exit(127); }
+    waitpid(p, NULL, 0);
+  }
+  t1 = now();
+  printf("  %-22s %8.1f us\n", "cold (fork + exec)", (t1 - t0) * 1e6 / COLD_RUNS);
+
+  t0 = now();
+  for (int k = 0; k < WARM_RUNS; k++) cliforward(sock, 4, args);
+  t1 = now();
+  printf("  %-22s %8.1f us\n", "warm (cliforward)", (t1 - t0) * 1e6 / WARM_RUNS);
+
+  kill(pid, SIGTERM);
+  waitpid(pid, NULL, 0);
+  unlink(sock);
+  return 0;
+}
@@ -0,0 +1,87 @@
+#define _POSIX_C_SOURCE 200809L
+#define CLI_SNAPSHOT
+#include <stdio.h>
+#include <time.h>
+
+#include "cli.h"
+
+// A worker started by a tool with 64 options, 40 arguments and a list of numbers from
+// the environment: time to parse its arguments again vs replaying the snapshot taken
+// by the parent (`clisnapshot()`/`clirestore()`).
+
+#define RUNS 20000
+
+static int n_flags, n_values;
+static long long sizes[64];
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static char *chk_sizes(char *arg)
+{
+  return cliints(arg, sizes, 64) < 0 ? "Invalid sizes" : NULL;
+}
+
+static int worker(int argc, char **argv)
+{
+  clioptions("b_snap", argc, argv) {
+    {
+#define FAM "w"
+#include "b_family.h"
+#undef FAM
+    }
+    cliopt("--sizes list ($B_SNAP_SIZES,64)\tSizes", chk_sizes) { n_values++; }
+    cliopt("--home dir ($HOME,/)\tHome directory") { n_values++; }
+    cliopt("input\tThe input file") { n_values++; }
+    cliopt();
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  char *args[64] = {"b_snap"};
+  char  vals[20][8];
+  int   n = 1;
+  double t0, t1, t_parse, t_replay;
+  size_t len;
+
+  setenv("B_SNAP_SIZES", "4,8,15,16,23,42,64,128,256,512,1024,2048,4096,8192,16384,32768", 1);
+  for (int k = 0; k < 20; k++) {
+    snprintf(vals[k], sizeof(vals[k]), "%d", k * 100);
+    args[n++] = (k % 4 == 0) ? "--w-opt00" : (k % 4 == 1) ? "--w-opt01" : (k % 4 == 2) ? "--w-opt09" : "--w-opt16";
+    if (k % 4 == 0 || k % 4 == 3) args[n++] = vals[k];
+  }
+  while (n < 40) args[n++] = "--w-opt63";
+  args[n++] = "data.bin";
+
+  worker(n, args);
+  char *blob = clisnapshot(&len);
+  char *snapshot = malloc(len);
+  if (blob == NULL || snapshot == NULL) return 1;
+  memcpy(snapshot, blob, len);
+
+  t0 = now();
+  for (int k = 0; k < RUNS; k++) worker(n, args);
+  t1 = now();
+  t_parse = (t1 - t0) / RUNS;
+
+  t0 = now();
+  for (int k = 0; k < RUNS; k++) {
+    clirestore(snapshot, len);
+    worker(1, args);
+  }
+  t1 = now();
+  t_replay = (t1 - t0) / RUNS;
+
+  printf("Options of a worker (%d arguments, snapshot of %zu bytes)\n", n - 1, len);
+  printf("  %-28s %8.2f us\n", "parse the arguments", t_parse * 1e6);
+  printf("  %-28s %8.2f us\n", "replay the snapshot", t_replay * 1e6);
+  printf("  (%d values, %d flags)\n", n_values, n_flags);
+  free(snapshot);
+  return 0;
+}
@@ -0,0 +1,118 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <time.h>
+
+#include "cli.h"
+
+// "Did you mean" suggestions for misspelled long options among 5000 options: a
+// scan of all the names with the textbook edit distance vs `clisuggest()`.
+
+#define OPTIONS 5000
+#define QUERIES 2000
+
+static cli_option_t opts[OPTIONS];
+static char defs[OPTIONS][40];
+static char queries[QUERIES][40];
+
+static unsigned int x = 1;
+static unsigned int rnd(unsigned int n) { return (x = x * 1664525u + 1013904223u) % n; }
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int levenshtein(const char *a, int m, const char *b, int n)
+{
+  int row[65];
+  for (int i = 0; i <= m; i++) row[i] = i;
+  for (int j = 1; j <= n; j++) {
+    int diag = row[0];
+    row[0] = j;
+    for (int i = 1; i <= m; i++) {
+      int up = row[i];
+      int d = diag + (a[i-1] != b[j-1]);
+      if (row[i-1] + 1 < d) d = row[i-1] + 1;
+      if (up + 1 < d) d = up + 1;
+      row[i] = d;
+      diag = up;
+    }
+  }
+  return row[m];
+}
+
+// The best name at distance 2 or less
+static char *scan(const char *arg)
+{
+  int m = (int)strlen(arg), best = 3;
+  char *found = NULL;
+  for (cli_option_t *opt = cli_head; opt != NULL; opt = opt->next) {
+    int d = levenshtein(arg, m, opt->def + opt->optname_offset, opt->optname_len);
+    if (d < best) { best = d; found = opt->def + opt->optname_offset; }
+  }
+  return found;
+}
+
+int main(int argc, char *argv[])
+{
+  static const char *syl[] = {"ra", "to", "ce", "li", "mo", "nu", "pe", "sa", "ki", "do",
+                              "ve", "gu", "ha", "zi", "fo", "be"};
+  double t0, t1;
+  char *names[1];
+  int hits = 0, queries_num = QUERIES;
+
+  clioptions("b_suggest", argc, argv) {
+    cliopt("-q, --queries num\tNumber of queries (at most 2000)") {
+      queries_num = atoi(cliarg);
+      if (queries_num < 1 || queries_num > QUERIES) clierror(CLI_STR_ERR_NUMBER, cliarg);
+    }
+    cliopt() { cliunknown(); }
+  }
+
+  // Names like "--tolimo-raki", from 6 to 16 chars
+  for (int k = 0; k < OPTIONS; k++) {
+    int n = sprintf(defs[k], "--");
+    for (int s = 2 + rnd(3); s > 0; s--) n += sprintf(defs[k] + n, "%s", syl[rnd(16)]);
+    if (rnd(2)) n += sprintf(defs[k] + n, "-");
+    for (int s = 1 + rnd(3); s > 0; s--) n += sprintf(defs[k] + n, "%s", syl[rnd(16)]);
+    sprintf(defs[k] + n, "\tOption %d", k);
+    cli_opt_define(defs[k], &opts[k], cli_chk_true, 0);
+  }
+
+  // One or two typos (a changed, a missing or an extra letter) in a random name
+  for (int q = 0; q < QUERIES; q++) {
+    char *d = defs[rnd(OPTIONS)], *s = queries[q];
+    int n = (int)(strchr(d, '\t') - d);
+    memcpy(s, d, n); s[n] = '\0';
+    for (int t = 1 + rnd(2); t > 0; t--) {
+      int p = 2 + rnd(n - 2);
+      switch (rnd(3)) {
+        case 0: s[p] = 'a' + rnd(26); break;
+        case 1: memmove(s + p, s + p + 1, n - p); n--; break;
+        case 2: memmove(s + p + 1, s + p, n - p + 1); s[p] = 'a' + rnd(26); n++; break;
+      }
+    }
+  }
+
+  printf("Suggestions for misspelled options (%d options)\n", OPTIONS);
+
+  t0 = now();
+  names[0] = NULL;
+  clisuggest("--", names, 1);  // Builds the tree
+  t1 = now();
+  printf("  %-24s %9.1f us\n", "clisuggest() first call", (t1 - t0) * 1e6);
+
+  t0 = now();
+  for (int q = 0; q < queries_num; q++) hits += scan(queries[q]) != NULL;
+  t1 = now();
+  printf("  %-24s %9.1f us/query (%d found)\n", "scan", (t1 - t0) * 1e6 / queries_num, hits);
+
+  hits = 0;
+  t0 = now();
+  for (int q = 0; q < queries_num; q++) hits += clisuggest(queries[q], names, 1);
+  t1 = now();
+  printf("  %-24s %9.1f us/query (%d found)\n", "clisuggest()", (t1 - t0) * 1e6 / queries_num, hits);
+  return 0;
+}
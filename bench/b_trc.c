@@ -0,0 +1,72 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <time.h>
+
+#include "trc.h"
+
+// Compare tracing with `fprintf()` on `stderr` (what `cli_trace()` does) with the
+// deferred traces of `trc.h`, writing to `/dev/null` (no I/O cost) and to a file.
+// The `trc` time includes the final flush.
+
+#define ITERATIONS 1000000
+
+static volatile int v = 42;
+static const char *name = "some_name";
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#define report(name, t0, t1) \
+  printf("  %-14s %7.2f ns/trace\n", name, ((t1)-(t0))*1e9/ITERATIONS)
+
+static void bench(const char *path)
+{
+  double t0, t1, t2;
+
+  printf("Output to %s\n", path);
+  if (freopen(path, "w", stderr) == NULL) return;
+
+  t0 = now();
+  for (int i = 0; i < ITERATIONS; i++)
+    fprintf(stderr, "INFO: i = %d, v = %d, name = %s :%s:%d\n", i, v, name, __FILE__, __LINE__);
+  t1 = now(); report("fprintf", t0, t1);
+
+  t0 = now();
+  for (int i = 0; i < ITERATIONS; i++)
+    trcinfo("i = %d, v = %d, name = %s", i, v, name);
+  t1 = now();
+  trcflush();
+  t2 = now();
+  report("trc", t0, t2);
+}
+
+int main(void)
+{
+  double t0, t1, rec = 0, tot = 0;
+
+  printf("fprintf vs. trc (%d traces with 3 arguments)\n", ITERATIONS);
+  bench("/dev/null");
+  bench("b_trc.out");
+  remove("b_trc.out");
+
+  // The cost paid by the traced thread if the rings are flushed by someone else
+  // (e.g. the background flusher): fill a ring, flush it outside the measurement.
+  for (int k = 0; k < ITERATIONS / TRC_RING_SIZE; k++) {
+    t0 = now();
+    for (int i = 0; i < TRC_RING_SIZE; i++)
+      trcinfo("i = %d, v = %d, name = %s", i, v, name);
+    t1 = now();
+    trcflush();
+    rec += t1 - t0;
+    tot += now() - t0;
+  }
+  printf("Recording only\n");
+  printf("  %-14s %7.2f ns/trace\n", "trc (record)", rec * 1e9 / (ITERATIONS / TRC_RING_SIZE * TRC_RING_SIZE));
+  printf("  %-14s %7.2f ns/trace\n", "trc (flush)", (tot - rec) * 1e9 / (ITERATIONS / TRC_RING_SIZE * TRC_RING_SIZE));
+
+  return 0;
+}
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <time.h>
+#include <vector>
+
+#include "vec.h"
+
+// Pushing ints one at a time: growing with a `realloc()` per element, `vec_t` and
+// `std::vector` (with the default allocator). Two workloads: many short vectors (the
+// common case for small lists of options, tokens, children of a node, ...) and one
+// long vector.
+
+#define SHORT_VECS  1000000
+#define SHORT_LEN   8
+#define LONG_LEN    20000000
+
+typedef vec_t(int) intvec_t;
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static volatile long sink;
+
+static long naive(int vecs, int len)
+{
+  long sum = 0;
+  for (int v = 0; v < vecs; v++) {
+    int *a = NULL;
+    size_t n = 0;
+    for (int k = 0; k < len; k++) {
+      int *p = (int *)realloc(a, (n + 1) * sizeof(int));
+      if (p == NULL) { free(a); return -1; }
+      a = p;
+      a[n++] = k ^ v;
+    }
+    sum += a[n - 1];
+    free(a);
+  }
+  return sum;
+}
+
+static long vec(int vecs, int len)
+{
+  long sum = 0;
+  for (int v = 0; v < vecs; v++) {
+    intvec_t a;
+    vecinit(&a);
+    for (int k = 0; k < len; k++) vecpush(&a, k ^ v);
+    sum += a.data[a.len - 1];
+    vecfree(&a);
+  }
+  return sum;
+}
+
+static long stdvec(int vecs, int len)
+{
+  long sum = 0;
+  for (int v = 0; v < vecs; v++) {
+    std::vector<int> a;
+    for (int k = 0; k < len; k++) a.push_back(k ^ v);
+    sum += a.back();
+  }
+  return sum;
+}
+
+// Bulk: the long vector filled 1000 elements at a time
+static long vec_bulk(int len)
+{
+  static int chunk[1000];
+  intvec_t a;
+  long sum;
+  for (int k = 0; k < 1000; k++) chunk[k] = k;
+  vecinit(&a);
+  for (int k = 0; k < len; k += 1000) vecpush(&a, chunk, 1000);
+  sum = a.data[a.len - 1];
+  vecfree(&a);
+  return sum;
+}
+
+static long stdvec_bulk(int len)
+{
+  static int chunk[1000];
+  std::vector<int> a;
+  for (int k = 0; k < 1000; k++) chunk[k] = k;
+  for (int k = 0; k < len; k += 1000) a.insert(a.end(), chunk, chunk + 1000);
+  return a.back();
+}
+
+#define MEASURE(label_, n_, expr_) do { \
+    double t0 = now(); sink = (expr_); double t1 = now(); \
+    printf("  %-28s %7.2f ns/push\n", label_, (t1 - t0) * 1e9 / (n_)); \
+  } while (0)
+
+int main(void)
+{
+  printf("%d vectors of %d ints\n", SHORT_VECS, SHORT_LEN);
+  MEASURE("realloc() per push", (double)SHORT_VECS * SHORT_LEN, naive(SHORT_VECS, SHORT_LEN));
+  MEASURE("vec_t (vecpush)", (double)SHORT_VECS * SHORT_LEN, vec(SHORT_VECS, SHORT_LEN));
+  MEASURE("std::vector (push_back)", (double)SHORT_VECS * SHORT_LEN, stdvec(SHORT_VECS, SHORT_LEN));
+
+  printf("1 vector of %d ints\n", LONG_LEN);
+  MEASURE("realloc() per push", (double)LONG_LEN, naive(1, LONG_LEN));
+  MEASURE("vec_t (vecpush)", (double)LONG_LEN, vec(1, LONG_LEN));
+  MEASURE("std::vector (push_back)", (double)LONG_LEN, stdvec(1, LONG_LEN));
+  MEASURE("vec_t (vecpush 1000 at once)", (double)LONG_LEN, vec_bulk(LONG_LEN));
+  MEASURE("std::vector (insert 1000)", (double)LONG_LEN, stdvec_bulk(LONG_LEN));
+  return 0;
+}
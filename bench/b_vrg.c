@@ -0,0 +1,112 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include "vrg.h"
+
+// Runtime cost of a call through `vrg()`, `vrg0()`, `vrg1()` and `vrg2()` compared
+// with a call to a variadic function that reads its arguments with `va_arg()`, and
+// of the defaults filled in by `VRG_defaults()` compared with a variadic function
+// that reads the arguments up to a sentinel and uses the defaults for the others.
+// All the target functions are out of line so that only the call overhead (and
+// the argument walk for the `va_list` versions) is measured.
+
+#define ITERATIONS 20000000
+
+#ifdef __GNUC__
+#define NOINLINE __attribute__((noinline))
+#else
+#define NOINLINE
+#endif
+
+static volatile int v = 1;
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+NOINLINE static int fn0(void)                      { return v; }
+NOINLINE static int fn1(int a)                     { return a; }
+NOINLINE static int fn3(int a, int b, int c)       { return a+b+c; }
+NOINLINE static int fn9(int a, int b, int c, int d, int e, int f, int g, int h, int i)
+                                                   { return a+b+c+d+e+f+g+h+i; }
+
+NOINLINE static int fnv(int n, ...)
+{
+  va_list ap;
+  int s = 0;
+  va_start(ap, n);
+  while (n-- > 0) s += va_arg(ap, int);
+  va_end(ap);
+  return s;
+}
+
+// Reads the arguments after `a` up to the sentinel `-1`
+NOINLINE static int fns(int a, ...)
+{
+  va_list ap;
+  int b = 2, c = 3, x;
+  va_start(ap, a);
+  if ((x = va_arg(ap, int)) != -1) {
+    b = x;
+    if ((x = va_arg(ap, int)) != -1) c = x;
+  }
+  va_end(ap);
+  return a+b+c;
+}
+
+#define f(...) vrg(f_, __VA_ARGS__)
+#define f_0()                   fn0()
+#define f_1(a)                  fn1(a)
+#define f_3(a,b,c)              fn3(a,b,c)
+#define f_9(a,b,c,d,e,f,g,h,i)  fn9(a,b,c,d,e,f,g,h,i)
+
+#define g0(...) vrg0(g_, __VA_ARGS__)
+#define g1(...) vrg1(g_, __VA_ARGS__)
+#define g2(...) vrg2(g_, __VA_ARGS__)
+#define g_0()       fn0()
+#define g_1(a)      fn1(a)
+#define g_2(a,b)    fn3(a,b,0)
+#define g__(...)    fnv(VRG_nargs(__VA_ARGS__), __VA_ARGS__)
+
+#define h(...) VRG_defaults(fn3, ((a), (b, 2), (c, 3)), __VA_ARGS__)
+
+#define bench(name, call) \
+  do { \
+    int acc = 0; double t0 = now(); \
+    for (int i = 0; i < ITERATIONS; i++) acc += call; \
+    double t1 = now(); \
+    printf("%-20s %6.2f ns/call  (check: %d)\n", name, (t1-t0)*1e9/ITERATIONS, acc); \
+  } while (0)
+
+int main(void)
+{
+  printf("vrg vs. va_list calls (%d calls)\n", ITERATIONS);
+
+  bench("vrg 0 args",        f());
+  bench("va_list 0 args",    fnv(0));
+  bench("vrg 1 arg",         f(v));
+  bench("va_list 1 arg",     fnv(1, v));
+  bench("vrg 3 args",        f(v, v, v));
+  bench("va_list 3 args",    fnv(3, v, v, v));
+  bench("vrg 9 args",        f(v, v, v, v, v, v, v, v, v));
+  bench("va_list 9 args",    fnv(9, v, v, v, v, v, v, v, v, v));
+  bench("vrg0 0 args",       g0());
+  bench("vrg0 3 args (f__)", g0(v, v, v));
+  bench("vrg1 1 arg",        g1(v));
+  bench("vrg1 3 args (f__)", g1(v, v, v));
+  bench("vrg2 2 args",       g2(v, v));
+  bench("vrg2 3 args (f__)", g2(v, v, v));
+
+
+  bench("defaults 1 of 3",   h(v));
+  bench("sentinel 1 of 3",   fns(v, -1));
+  bench("defaults 2 of 3",   h(v, v));
+  bench("sentinel 2 of 3",   fns(v, v, -1));
+
+  return 0;
+}
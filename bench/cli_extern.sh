@@ -0,0 +1,72 @@
+#!/bin/sh
+#  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+#  SPDX-License-Identifier: MIT
+
+# Measures the code duplicated by `cli.h` in a program made of many translation
+# units: a main file with `N` commands (see `clicommand()`), each in its own file
+# with a `clioptions()` block of 16 options. The program is compiled with:
+#
+#   static: the default, each file has its own copy of the parser
+#   extern: `CLI_IMPLEMENTATION` in the main file, `CLI_EXTERN` in the others
+#
+# It reports the size of `.text` in a command's object file and in all of them, the
+# size of the executable and the time to compile all the files. Both executables
+# must print the same output.
+#
+# Usage: N=32 ./cli_extern.sh
+
+CC=${CC:-cc}
+N=${N:-16}
+CFLAGS="-std=c11 -O2 -DNDEBUG -I../dist"
+
+k=0
+printf '#include "cli.h"\n' > gen_main.c
+while [ $k -lt $N ]; do
+  printf 'int cmd%d_cli(int argc, char **argv);\n' $k >> gen_main.c
+  k=$((k + 1))
+done
+printf 'int main(int argc, char **argv)\n{\n  clioptions("gen", argc, argv) {\n' >> gen_main.c
+k=0
+while [ $k -lt $N ]; do
+  printf '    cliopt("<cmd%d>\\tCommand %d") { clicommand(cmd%d_cli); }\n' $k $k $k >> gen_main.c
+  { printf '#include "cli.h"\n#include <stdio.h>\n\nint cmd%d_cli(int argc, char **argv)\n{\n' $k
+    printf '  int n = 0;\n  clioptions("Command %d", argc, argv) {\n' $k
+    j=0
+    while [ $j -lt 16 ]; do
+      if [ $((j % 4)) -eq 0 ]; then
+        printf '    cliopt("-%c, --opt%d n (%d)\\tAn option") { n += atoi(cliarg); }\n' $(printf "\\$(printf %o $((97 + j)))") $j $j
+      else
+        printf '    cliopt("-%c, --opt%d\\tA flag") { n++; }\n' $(printf "\\$(printf %o $((97 + j)))") $j
+      fi
+      j=$((j + 1))
+    done
+    printf '    cliopt("[file]\\tA file") { n++; }\n    cliopt();\n  }\n'
+    printf '  printf("%%d %%d\\n", %d, n);\n  return 0;\n}\n' $k
+  } > gen_cmd$k.c
+  k=$((k + 1))
+done
+printf '    cliopt();\n  }\n  return 0;\n}\n' >> gen_main.c
+
+printf "%-7s %9s %9s %11s %9s\n" mode "cmd .text" "all .text" "executable" compile
+for mode in static extern; do
+  case $mode in
+    static) main=""; cmd="" ;;
+    extern) main="-DCLI_IMPLEMENTATION"; cmd="-DCLI_EXTERN" ;;
+  esac
+  t0=$(date +%s%N)
+  $CC $CFLAGS $main -c -o gen_main.o gen_main.c || exit 1
+  k=0
+  while [ $k -lt $N ]; do
+    $CC $CFLAGS $cmd -c -o gen_cmd$k.o gen_cmd$k.c || exit 1
+    k=$((k + 1))
+  done
+  t1=$(date +%s%N)
+  $CC -s -o gen_$mode gen_main.o gen_cmd*.o || exit 1
+  one=$(size -A gen_cmd0.o | awk '$1 ~ /^\.text/ {t += $2} END {print t}')
+  all=$(size -A gen_main.o gen_cmd*.o | awk '$1 ~ /^\.text/ {t += $2} END {print t}')
+  printf "%-7s %9d %9d %11d %7dms\n" $mode $one $all $(wc -c < gen_$mode) $(( (t1 - t0) / 1000000 ))
+done
+./gen_static cmd3 -b -c --opt4 5 x > gen_static.out
+./gen_extern cmd3 -b -c --opt4 5 x > gen_extern.out
+cmp -s gen_static.out gen_extern.out || echo "Different output: $(cat gen_static.out) vs $(cat gen_extern.out)"
+rm -f gen_main.c gen_cmd*.c gen_*.o gen_static gen_extern gen_*.out
@@ -0,0 +1,51 @@
+#!/bin/sh
+#  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+#  SPDX-License-Identifier: MIT
+
+# Measures the footprint of `cli.h` in the full and in the minimal profiles by
+# compiling `demo/cli_ls.c` with:
+#
+#   full        : the default (hosted) profile
+#   freestanding: -DCLI_FREESTANDING (no stdio, exit() or getenv())
+#   no-usage    : -DCLI_FREESTANDING -DCLI_NO_USAGE
+#
+# For each profile it reports the size of `.text` in the object file, the size of
+# the dynamically and statically linked executables, the C library functions the
+# object file needs and the average time to run the static executable (`RUNS` times,
+# the dynamic one if static linking is not available).
+#
+# Usage: RUNS=1000 ./cli_profile.sh
+
+CC=${CC:-cc}
+RUNS=${RUNS:-500}
+CFLAGS="-std=c11 -O2 -DNDEBUG -I../dist"
+
+run_time() {
+  t0=$(date +%s%N)
+  i=0
+  while [ $i -lt $RUNS ]; do
+    "$@" > /dev/null 2>&1
+    i=$((i + 1))
+  done
+  t1=$(date +%s%N)
+  echo "$(( (t1 - t0) / RUNS / 1000 ))us"
+}
+
+printf "%-13s %7s %9s %9s %8s  %s\n" profile .text dynamic static run "needs"
+for profile in full freestanding no-usage; do
+  case $profile in
+    full)         flags="" ;;
+    freestanding) flags="-DCLI_FREESTANDING" ;;
+    no-usage)     flags="-DCLI_FREESTANDING -DCLI_NO_USAGE" ;;
+  esac
+  $CC $CFLAGS $flags -c -o prof.o ../demo/cli_ls.c || exit 1
+  $CC -s -o prof_dyn prof.o
+  static="-"
+  exe=./prof_dyn
+  $CC -static -s -o prof_static prof.o 2>/dev/null && static=$(wc -c < prof_static) && exe=./prof_static
+  text=$(size -A prof.o | awk '$1 == ".text" {print $2}')
+  needs=$(nm -u prof.o | awk '{printf "%s ", $2}')
+  t=$(run_time $exe -l -a --width 80 file1 file2)
+  printf "%-13s %7d %9d %9s %8s  %s\n" $profile $text $(wc -c < prof_dyn) $static $t "$needs"
+  rm -f prof.o prof_dyn prof_static
+done
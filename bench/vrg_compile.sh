@@ -0,0 +1,39 @@
+#!/bin/sh
+#  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+#  SPDX-License-Identifier: MIT
+
+# Measures the cost of `vrg()`, `vrg0()`, `vrg1()` and `vrg2()` at compile time.
+# For each size, it generates translation units with that many expansions and
+# reports the time to preprocess them (with `cc` and, if available, `clang`),
+# the time for a full `-O2` compilation and the size of the `.text` section.
+# The `direct` lines are for the same calls written by hand.
+#
+# Usage: SIZES="1000 10000" ./vrg_compile.sh
+
+CC=${CC:-cc}
+SIZES=${SIZES:-"1000 10000 100000"}
+MODES=${MODES:-"direct vrg vrg0 vrg1 vrg2"}
+CLANG=$(command -v clang)
+
+# Elapsed time in milliseconds
+elapsed() {
+  t0=$(date +%s%N)
+  "$@" > /dev/null 2>&1 || echo "FAILED: $*" >&2
+  t1=$(date +%s%N)
+  echo "$(( (t1 - t0) / 1000000 ))ms"
+}
+
+printf "%-7s %7s %9s %9s %9s %10s\n" mode n "cc -E" "clang -E" "cc -O2" ".text"
+for n in $SIZES; do
+  for mode in $MODES; do
+    src=gen_${mode}_$n.c
+    ./vrg_gen $n $mode > $src
+    t_cpp=$(elapsed $CC -E -I../dist $src)
+    t_clang="-"
+    [ -n "$CLANG" ] && t_clang=$(elapsed $CLANG -E -I../dist $src)
+    t_cc=$(elapsed $CC -O2 -c -I../dist -o gen.o $src)
+    text=$(size -A gen.o | awk '$1 == ".text" {print $2}')
+    printf "%-7s %7d %9s %9s %9s %10s\n" $mode $n $t_cpp $t_clang $t_cc $text
+    rm -f $src gen.o
+  done
+done
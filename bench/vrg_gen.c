@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Generates a translation unit with `n` expansions of `vrg()`, `vrg0()`, `vrg1()`
+// or `vrg2()`, cycling through all the arities from 0 to 9.
+// In `direct` mode, it generates the code that `vrg()` would have produced
+// to provide a baseline for the measures.
+//
+//   vrg_gen n (direct|vrg|vrg0|vrg1|vrg2)
+
+#define CALLS_PER_FUNCTION 100
+
+// The arguments are all different to avoid that the compiler merges identical functions
+static char *args(long i, int k)
+{
+  static char buf[128];
+  int n = 0;
+  buf[0] = '\0';
+  for (int j = 0; j < k; j++)
+    n += sprintf(buf+n, j == 0 ? "x" : ",%ld", i+j);
+  return buf;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 3) {
+    fprintf(stderr, "Usage: %s n (direct|vrg|vrg0|vrg1|vrg2)\n", argv[0]);
+    return 1;
+  }
+
+  long n = atol(argv[1]);
+  char *mode = argv[2];
+  int direct = (strcmp(mode, "direct") == 0);
+  int lim = 0; // Arities up to `lim` go to `f_<lim>`, the others to `f__`
+
+  if (strcmp(mode,"vrg0") == 0) lim = 0;
+  if (strcmp(mode,"vrg1") == 0) lim = 1;
+  if (strcmp(mode,"vrg2") == 0) lim = 2;
+
+  printf("#include \"vrg.h\"\n\n");
+  printf("extern int fn0(void);\n");
+  for (int k = 1; k <= 9; k++) {
+    printf("extern int fn%d(int a0", k);
+    for (int j = 1; j < k; j++) printf(", int a%d", j);
+    printf(");\n");
+  }
+  printf("extern int fna(const int *a);\n");
+  printf("extern int fnv(int a0, ...);\n\n");
+
+  for (int k = 0; k <= 9; k++)
+    printf("#define f_%d(...) fn%d(__VA_ARGS__)\n", k, k);
+  if (lim > 0) printf("#undef f_%d\n#define f_%d(...) fna((const int []){0, __VA_ARGS__ + 0})\n", lim, lim);
+  printf("#define f__(...) fnv(__VA_ARGS__)\n\n");
+
+  for (long i = 0; i < n; i++) {
+    int k = i % 10;
+    if (i % CALLS_PER_FUNCTION == 0) {
+      if (i > 0) printf("  return s;\n}\n\n");
+      printf("int chunk_%ld(int x)\n{\n  int s = 0;\n", i / CALLS_PER_FUNCTION);
+    }
+    if (direct)               printf("  s += fn%d(%s);\n", k, args(i,k));
+    else if (mode[3] == '\0') printf("  s += vrg(f_, %s);\n", args(i,k));
+    else                      printf("  s += %s(f_, %s);\n", mode, args(i,k));
+  }
+  if (n > 0) printf("  return s;\n}\n");
+  return 0;
+}
@@ -1,3 +1,10 @@
+#ifdef CLI_FREESTANDING
+/* Minimal profile of cli.h: no stdio, exit() or getenv() (see bench/cli_profile.sh) */
+#include <unistd.h>
+#define CLI_EXIT(n) _exit(n)
+static void ls_write(const char *s, int len) { if (write(2, s, len) < 0) return; }
+#endif
+
 #include "cli.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -64,6 +71,9 @@ static char *is_uint(char *s) {
 /* ---- Example CLI for `ls` ----------------------------------------------- */
 
 int main(int argc, char **argv) {
+#ifdef CLI_FREESTANDING
+  cliwrite = ls_write;  // All the output of cli.h goes through this function
+#endif
   cliprogname = "myls"; // You can specify your own program name
   clioptions("myls - list directory contents", argc, argv) {
     /* Help */
@@ -74,23 +84,23 @@ int main(int argc, char **argv) {
     cliopt("-A, --almost-all\tLike -a but exclude . and ..")           { opt.almost_all = 1; }
     cliopt("-l\t\t\tUse a long listing format")                            { opt.long_format = 1; }
     cliopt("-H\t\t\tFollow symlinks on command line")                      { opt.deref_cmdline = 1; }
-    cliopt("-L\t\t\tFollow all symlinks")                                  { opt.deref_all = 1; opt.deref_never = 0; }
-    cliopt("-P\t\t\tNever follow symlinks")                                { opt.deref_never = 1; opt.deref_all = 0; }
+    cliopt("-L\t\t\tFollow all symlinks")                                  { opt.deref_all = 1; }
+    cliopt("-P\t\t\tNever follow symlinks")                                { opt.deref_never = 1; }
     cliopt("-d\t\t\tList directories themselves, not their contents")      { opt.list_dirs_as_files = 1; }
     cliopt("-R, --recursive\tList subdirectories recursively")         { opt.recursive = 1; }
 
     /* Sorting & ordering */
     cliopt("-S\t\t\tSort by file size")                                    { opt.sort_size = 1; }
     cliopt("-t\t\t\tSort by modification time")                            { opt.sort_time = 1; }
-    cliopt("-u\t\t\tUse access time for -t/-l")                            { opt.time_access = 1; opt.time_status = 0; }
-    cliopt("-c\t\t\tUse status time for -t/-l")                            { opt.time_status = 1; opt.time_access = 0; }
+    cliopt("-u\t\t\tUse access time for -t/-l")                            { opt.time_access = 1; }
+    cliopt("-c\t\t\tUse status time for -t/-l")                            { opt.time_status = 1; }
     cliopt("-X\t\t\tSort alphabetically by entry extension")               { opt.sort_ext = 1; }
     cliopt("-v\t\t\tNatural sort of (version) numbers")                    { opt.sort_version = 1; }
     cliopt("-r, --reverse\t\tReverse sort order")                        { opt.reverse = 1; }
 
     /* Formatting */
-    cliopt("-1\t\t\tList one file per line")                               { opt.one_per_line = 1; opt.columns = 0; }
-    cliopt("-C\t\t\tList entries by columns")                              { opt.columns = 1; opt.one_per_line = 0; }
+    cliopt("-1\t\t\tList one file per line")                               { opt.one_per_line = 1; }
+    cliopt("-C\t\t\tList entries by columns")                              { opt.columns = 1; }
     cliopt("-m\t\t\tFill width with a comma separated list of entries")    { opt.commas = 1; }
     cliopt("-n\t\t\tList numeric user and group IDs")                      { opt.numeric_ids = 1; }
     cliopt("-g\t\t\tLike -l but do not list owner")                        { opt.no_owner = 1; opt.long_format = 1; }
@@ -116,6 +126,11 @@ int main(int argc, char **argv) {
       else clierror("Too many files", cliarg);
     }
 
+    /* Options that can't be used together */
+    cliexclusive("-L", "-P");
+    cliexclusive("-u", "-c");
+    cliexclusive("-1", "-C");
+
     /* End of options marker */
     cliopt() {
       if (strcmp(cliarg, "--") == 0) { cliexit(); }     // stop option parsing; remaining are files
@@ -127,6 +142,12 @@ int main(int argc, char **argv) {
   }
 
   /* ---- Demonstration: print what was parsed ------------------------------ */
+#ifdef CLI_FREESTANDING
+  for (int i = 0; i < nfiles; ++i) {
+    if (write(1, files[i], strlen(files[i])) < 0 || write(1, "\n", 1) < 0) return 1;
+  }
+  return 0;
+#endif
   printf("Parsed %d file(s).\n", nfiles);
   for (int i = 0; i < nfiles; ++i) printf("  FILE[%d] = %s\n", i, files[i]);
   printf("Flags: a=%d A=%d l=%d h=%d S=%d t=%d r=%d R=%d d=%d F=%d p=%d i=%d 1=%d C=%d m=%d n=%d g=%d o=%d q=%d u=%d c=%d X=%d v=%d H=%d L=%d P=%d\n",
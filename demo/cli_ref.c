@@ -40,7 +40,7 @@ int main(int argc, char **argv) {
     cliopt("[output]\tOutput file") { out = cliarg; }
 
     cliopt() {                            // unknown/extra
-      if (cliarg[0] == '-') clierror("Unknown option", cliarg);
+      if (cliarg[0] == '-') cliunknown();
       // else: tolerate extra positionals or stop with cliexit()
     }
   }
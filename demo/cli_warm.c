@@ -0,0 +1,76 @@
+#define _POSIX_C_SOURCE 200809L
+#define CLI_SERVE
+#include "cli.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// A tool that loads a (fake) model before doing any work.
+//
+//   cli_warm -x 10 data.txt                       loads the model and runs
+//   cli_warm --serve /tmp/warm.sock &             loads the model once and waits
+//   WARM_SOCKET=/tmp/warm.sock cli_warm -x 10 data.txt
+//                                                 the server does the work
+
+#define MODEL_SIZE (1 << 24)
+
+static unsigned int *model = NULL;
+
+static void load_model(void)
+{
+  if (model != NULL) return;
+  model = malloc(MODEL_SIZE * sizeof(unsigned int));
+  if (model == NULL) exit(1);
+  unsigned int x = 1;
+  for (int k = 0; k < MODEL_SIZE; k++) model[k] = (x = x * 1664525u + 1013904223u);
+}
+
+static char *is_positive(char *s)
+{
+  return (atoi(s) > 0) ? NULL : "Positive value expected for";
+}
+
+static int run(int argc, char *argv[])
+{
+  int rays = 32;
+  char *datafile = NULL;
+
+  clioptions("Warm server demo", argc, argv) {
+    cliopt("-h, --help\t\t\tShow help") {
+      cliusage(CLIEXIT);
+    }
+
+    cliopt("--serve socket\t\t\tLoad the model and serve requests on `socket`") {
+      load_model();
+      cliserve(cliarg, run);
+      clierror("Can't serve on", cliarg);
+    }
+
+    cliopt("-x, --xray num-rays ($XRAYS,32)\tNumber of rays", is_positive) {
+      rays = atoi(cliarg);
+    }
+
+    cliopt("datafile\t\t\tThe input file") {
+      datafile = cliarg;
+    }
+
+    cliopt();
+  }
+
+  load_model();
+  unsigned int sum = 0;
+  for (int k = 0; k < rays; k++) sum += model[(k * 7919u) % MODEL_SIZE];
+  printf("%s: %d rays -> %08X\n", datafile, rays, sum);
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  char *sock = getenv("WARM_SOCKET");
+  int rc;
+
+  if (sock != NULL && (rc = cliforward(sock, argc, argv)) != -1) {
+    if (rc == -2) fprintf(stderr, "%s: the server didn't report the exit code\n", argv[0]);
+    return rc >= 0 ? rc : 1;
+  }
+  return run(argc, argv);
+}
@@ -12,11 +12,33 @@
 #ifndef CLI_VERSION
 #define CLI_VERSION 0x0021002B
 
+// ## Freestanding profile
+// Defining `CLI_FREESTANDING` removes any dependency on `stdio.h` and on the hosted
+// parts of the C library (`exit()`, `getenv()`, `realloc()`, `strtod()`) for small
+// static tools and embedded targets:
+//
+//   - output only goes through `cliwrite` (see below): there is no output if it's not set;
+//   - `CLI_EXIT(code)` must be defined to terminate the program (e.g. as `_exit(code)`);
+//   - `CLI_GETENV(name)` can be defined to read the environment, otherwise defaults
+//     like `($VAR,fb)` always use the fallback value;
+//   - deferred validations (`CLIDEFER`, `clidefer()`) are run immediately;
+//   - `clifloats()` only accepts numbers with up to 15 digits and no exponent.
+//
+// Only `<stddef.h>`, `<limits.h>` and `<string.h>` (`strlen()`, `strcmp()`, `memcpy()`, ...)
+// are needed. Independently from the profile, defining `CLI_NO_USAGE` removes the
+// code that prints the usage text.
+
+#ifndef CLI_FREESTANDING
 #include <stdio.h>
-#include <stddef.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#endif
+
+#include <stddef.h>
 #include <string.h>
+#include <limits.h>
 
 //.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
 //.  SPDX-License-Identifier: MIT
@@ -49,8 +71,220 @@
 #define vrg1(f_,...)  VRG_join(f_,VRG_sel_n(1,VRG_tail(__VA_ARGS__)))(__VA_ARGS__)
 #define vrg2(f_,...)  VRG_join(f_,VRG_sel_n(2,VRG_tail2(__VA_ARGS__)))(__VA_ARGS__)
 #define vrg_(f_,...)  vrg0(f_,...)
+#define VRG_kwargs(t_,...) ((t_){ t_ ## _defaults, __VA_ARGS__ })
+#define VRG_unp(...) __VA_ARGS__
+#define VRG_map_ap(m_,c_,i_,x_)  m_(x_)
+#define VRG_mapi_ap(m_,c_,i_,x_) m_(i_,x_)
+#define VRG_mapx_ap(m_,c_,i_,x_) m_(c_,x_)
+#define VRG_map_0(a_,m_,c_,s_,...)
+#define VRG_map_1(a_,m_,c_,s_,x0)                         a_(m_,c_,0,x0)
+#define VRG_map_2(a_,m_,c_,s_,x0,x1)                      VRG_map_1(a_,m_,c_,s_,x0) VRG_unp s_ a_(m_,c_,1,x1)
+#define VRG_map_3(a_,m_,c_,s_,x0,x1,x2)                   VRG_map_2(a_,m_,c_,s_,x0,x1) VRG_unp s_ a_(m_,c_,2,x2)
+#define VRG_map_4(a_,m_,c_,s_,x0,x1,x2,x3)                VRG_map_3(a_,m_,c_,s_,x0,x1,x2) VRG_unp s_ a_(m_,c_,3,x3)
+#define VRG_map_5(a_,m_,c_,s_,x0,x1,x2,x3,x4)             VRG_map_4(a_,m_,c_,s_,x0,x1,x2,x3) VRG_unp s_ a_(m_,c_,4,x4)
+#define VRG_map_6(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5)          VRG_map_5(a_,m_,c_,s_,x0,x1,x2,x3,x4) VRG_unp s_ a_(m_,c_,5,x5)
+#define VRG_map_7(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6)       VRG_map_6(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5) VRG_unp s_ a_(m_,c_,6,x6)
+#define VRG_map_8(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7)    VRG_map_7(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6) VRG_unp s_ a_(m_,c_,7,x7)
+#define VRG_map_9(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7,x8) VRG_map_8(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7) VRG_unp s_ a_(m_,c_,8,x8)
+#define VRG_map_go(a_,m_,c_,s_,...) \
+   VRG_join(VRG_map_, VRG_sel(VRG_nargs(__VA_ARGS__),__VA_ARGS__))(a_,m_,c_,s_,__VA_ARGS__)
+#define VRG_map(m_,s_,...)      VRG_map_go(VRG_map_ap,  m_, ~,  s_, __VA_ARGS__)
+#define VRG_mapi(m_,s_,...)     VRG_map_go(VRG_mapi_ap, m_, ~,  s_, __VA_ARGS__)
+#define VRG_mapx(m_,c_,s_,...)  VRG_map_go(VRG_mapx_ap, m_, c_, s_, __VA_ARGS__)
+#define VRG_foreach(m_,...)     VRG_map_go(VRG_map_ap,  m_, ~, (;), __VA_ARGS__)
+#define VRG_drop_0(...)                            __VA_ARGS__
+#define VRG_drop_1(x0,...)                         __VA_ARGS__
+#define VRG_drop_2(x0,x1,...)                      __VA_ARGS__
+#define VRG_drop_3(x0,x1,x2,...)                   __VA_ARGS__
+#define VRG_drop_4(x0,x1,x2,x3,...)                __VA_ARGS__
+#define VRG_drop_5(x0,x1,x2,x3,x4,...)             __VA_ARGS__
+#define VRG_drop_6(x0,x1,x2,x3,x4,x5,...)          __VA_ARGS__
+#define VRG_drop_7(x0,x1,x2,x3,x4,x5,x6,...)       __VA_ARGS__
+#define VRG_drop_8(x0,x1,x2,x3,x4,x5,x6,x7,...)    __VA_ARGS__
+#define VRG_drop_9(x0,x1,x2,x3,x4,x5,x6,x7,x8,...) __VA_ARGS__
+#define VRG_dflt_1(n_)      n_ ## _is_required
+#define VRG_dflt_2(n_,d_)   d_
+#define VRG_dflt(p_)        VRG_join(VRG_dflt_, VRG_nargs p_) p_
+#define VRG_dflt_next(p_)   , VRG_dflt(p_)
+#define VRG_defaults(f_,p_,...)   VRG_join(VRG_defaults_, VRG_sel(1,__VA_ARGS__))(f_,p_,__VA_ARGS__)
+#define VRG_defaults_0(f_,p_,...) f_(VRG_map(VRG_dflt, (,), VRG_unp p_))
+#define VRG_defaults_1(f_,p_,...) \
+   f_(__VA_ARGS__ VRG_map(VRG_dflt_next, (), VRG_join(VRG_drop_, VRG_nargs(__VA_ARGS__)) p_))
+#define VRG_args_0(a_)
+#define VRG_args_1(a_) (a_)[0]
+#define VRG_args_2(a_) VRG_args_1(a_), (a_)[1]
+#define VRG_args_3(a_) VRG_args_2(a_), (a_)[2]
+#define VRG_args_4(a_) VRG_args_3(a_), (a_)[3]
+#define VRG_args_5(a_) VRG_args_4(a_), (a_)[4]
+#define VRG_args_6(a_) VRG_args_5(a_), (a_)[5]
+#define VRG_args_7(a_) VRG_args_6(a_), (a_)[6]
+#define VRG_args_8(a_) VRG_args_7(a_), (a_)[7]
+#define VRG_args_9(a_) VRG_args_8(a_), (a_)[8]
+#define VRG_call(m_, args_) m_ args_
+#define VRG_apply_go(m_, args_) m_ args_  // Not VRG_call(): it would not expand inside itself
+#define VRG_apply_cs(f_, n_, a_, k_)  (n_) == k_ ? VRG_apply_go(VRG_join(f_, k_), (VRG_join(VRG_args_, k_)(a_))) :
+#define VRG_apply_case(c_, k_)        VRG_call(VRG_apply_cs, (VRG_unp c_, k_))
+#define VRG_apply(f_, n_, a_) \
+   (VRG_mapx(VRG_apply_case, (f_, n_, a_), (), f_ ## arities) f_ ## arity_error(n_))
+#if !defined(__cplusplus) && defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+typedef enum {
+  VRG_T_NONE = 0,
+  VRG_T_BOOL,   VRG_T_CHAR,   VRG_T_SCHAR,  VRG_T_UCHAR,
+  VRG_T_SHORT,  VRG_T_USHORT, VRG_T_INT,    VRG_T_UINT,
+  VRG_T_LONG,   VRG_T_ULONG,  VRG_T_LLONG,  VRG_T_ULLONG,
+  VRG_T_FLOAT,  VRG_T_DOUBLE, VRG_T_STR,    VRG_T_PTR
+} vrg_type_t;
+typedef struct {
+  vrg_type_t type;
+  union {
+             long long  i;
+    unsigned long long  u;
+                double  d;
+          const char   *s;
+          const void   *p;
+  } v;
+} vrg_val_t;
+#define VRG_val_fn(n_, t_, T_, f_) \
+  static inline vrg_val_t vrg_val_ ## n_(t_ x) { vrg_val_t r; r.type = T_; r.v.f_ = x; return r; }
+VRG_val_fn(bool,   _Bool,              VRG_T_BOOL,   i)
+VRG_val_fn(char,   char,               VRG_T_CHAR,   i)
+VRG_val_fn(schar,  signed char,        VRG_T_SCHAR,  i)
+VRG_val_fn(uchar,  unsigned char,      VRG_T_UCHAR,  u)
+VRG_val_fn(short,  short,              VRG_T_SHORT,  i)
+VRG_val_fn(ushort, unsigned short,     VRG_T_USHORT, u)
+VRG_val_fn(int,    int,                VRG_T_INT,    i)
+VRG_val_fn(uint,   unsigned int,       VRG_T_UINT,   u)
+VRG_val_fn(long,   long,               VRG_T_LONG,   i)
+VRG_val_fn(ulong,  unsigned long,      VRG_T_ULONG,  u)
+VRG_val_fn(llong,  long long,          VRG_T_LLONG,  i)
+VRG_val_fn(ullong, unsigned long long, VRG_T_ULLONG, u)
+VRG_val_fn(float,  float,              VRG_T_FLOAT,  d)
+VRG_val_fn(double, double,             VRG_T_DOUBLE, d)
+VRG_val_fn(str,    const char *,       VRG_T_STR,    s)
+VRG_val_fn(ptr,    const void *,       VRG_T_PTR,    p)
+#define vrg_val(x) \
+  _Generic((x), _Bool: vrg_val_bool,   char: vrg_val_char, \
+           signed char: vrg_val_schar, unsigned char: vrg_val_uchar, \
+                 short: vrg_val_short, unsigned short: vrg_val_ushort, \
+                   int: vrg_val_int,   unsigned int: vrg_val_uint, \
+                  long: vrg_val_long,  unsigned long: vrg_val_ulong, \
+             long long: vrg_val_llong, unsigned long long: vrg_val_ullong, \
+                 float: vrg_val_float, double: vrg_val_double, \
+                char *: vrg_val_str,   const char *: vrg_val_str, \
+               default: vrg_val_ptr)(x)
+#define VRG_pack(...)   VRG_join(VRG_pack_, VRG_sel(1,__VA_ARGS__))(__VA_ARGS__)
+#define VRG_pack_0(...) 0, (const vrg_val_t *)0
+#define VRG_pack_1(...) VRG_nargs(__VA_ARGS__), (const vrg_val_t[]){ VRG_map(vrg_val, (,), __VA_ARGS__) }
+#endif
+static inline char *vrg_utoa(char *end, unsigned long long u)
+{
+  static const char digits[] = "00010203040506070809101112131415161718192021222324"
+                               "25262728293031323334353637383940414243444546474849"
+                               "50515253545556575859606162636465666768697071727374"
+                               "75767778798081828384858687888990919293949596979899";
+  while (u >= 100) {
+    end -= 2;
+    end[0] = digits[(u % 100) * 2]; end[1] = digits[(u % 100) * 2 + 1];
+    u /= 100;
+  }
+  if (u >= 10) { end -= 2; end[0] = digits[u * 2]; end[1] = digits[u * 2 + 1]; }
+  else *--end = (char)('0' + u);
+  return end;
+}
+static inline int vrg_fixed(char *tmp, double d, int digits, int flt)
+{
+  static const double p10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  char dig[24], *p = tmp;
+  double a = d < 0 ? -d : d, q;
+  int e = 0, k, n = 0, z = 0;
+  unsigned long long m;
+  if (a < 1e-5 || a >= 1e15) return 0;
+  if (a >= 1) while (a >= p10[e + 1]) e++;
+  else while (a * p10[-e] < 1) e--;
+  if ((k = digits - 1 - e) < 0 || k > 22 || (q = a * p10[k] + 0.5) >= 9007199254740992.0) return 0;
+  m = (unsigned long long)q;
+  if (flt ? (float)(m / p10[k]) != (float)a : m / p10[k] != a) return 0;
+  do { dig[n++] = (char)('0' + m % 10); m /= 10; } while (m > 0);  // Reversed
+  while (k > 0 && dig[z] == '0') { z++; k--; }                      // No trailing zeros
+  if (d < 0) *p++ = '-';
+  if (n - z <= k) *p++ = '0';
+  while (n - z > k) *p++ = dig[--n];
+  if (k > 0) {
+    *p++ = '.';
+    for (int i = k - (n - z); i > 0; i--) *p++ = '0';
+    while (n > z) *p++ = dig[--n];
+  }
+  return (int)(p - tmp);
+}
+static inline int vrg_shortest(char *tmp, double d, int flt)
+{
+  union { double d; unsigned long long u; } bits;
+  int n;
+  if (d == 0) {
+    bits.d = d;
+    if (bits.u >> 63) { tmp[0] = '-'; tmp[1] = '0'; return 2; }
+    tmp[0] = '0';
+    return 1;
+  }
+  if ((n = vrg_fixed(tmp, d, flt ? 6 : 15, flt)) == 0 && flt) n = vrg_fixed(tmp, d, 9, 1);
+  return n;
+}
 #endif // VRG_VERSION_H
 
+// ## Linkage
+// Everything in `cli.h` is `static`: each translation unit that includes it has its own
+// copy of the parser and of its state. When many of them have a `clioptions()` block
+// (e.g. a command family per file), define `CLI_EXTERN` in all of them and
+// `CLI_IMPLEMENTATION` in one (which doesn't need to have a block). The functions
+// and the state are defined there once and shared by all the others, where only
+// the small functions that check the arguments can be inlined.
+//
+// The configuration (`CLI_THREADS`, `CLI_SNAPSHOT`, ...) must be the same in all of them.
+
+#if defined(CLI_IMPLEMENTATION)
+#define CLI_FN                     // External definitions
+#define CLI_INLINE
+#define CLI_VAR
+#define CLI_INIT(...) = __VA_ARGS__
+#elif defined(CLI_EXTERN)
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wattributes"     // For `noinline` on inline functions
+#define CLI_FN  __attribute__((noinline)) inline  // Calls to the external definition
+#define CLI_DIAGNOSTIC_PUSHED
+#else
+#define CLI_FN  inline
+#endif
+#define CLI_INLINE inline          // Inline definitions (C99)
+#define CLI_VAR    extern
+#define CLI_INIT(...)
+#else
+#if defined(__GNUC__) || defined(__clang__)
+#define CLI_FN     static __attribute__((unused))  // Not all of them are used by each program
+#else
+#define CLI_FN     static
+#endif
+#define CLI_INLINE static inline
+#define CLI_VAR    static
+#define CLI_INIT(...) = __VA_ARGS__
+#endif
+
+#ifndef CLI_EXIT
+#ifdef CLI_FREESTANDING
+#error "CLI_FREESTANDING requires CLI_EXIT(code) to be defined"
+#endif
+#define CLI_EXIT(n) exit(n)
+#endif
+
+#ifndef CLI_GETENV
+#ifdef CLI_FREESTANDING
+#define CLI_GETENV(v) ((char *)NULL)
+#else
+#define CLI_GETENV(v) getenv(v)
+#endif
+#endif
+
 #ifndef CLI_STR_ERROR_MSG
 #define CLI_STR_ERROR_MSG "Missing or invalid value for"
 #endif
@@ -79,8 +313,54 @@
 #define CLI_STR_ARGUMENTS "ARGUMENTS"
 #endif
 
-#ifndef NDEBUG
+#ifndef CLI_STR_EXCLUSIVE
+#define CLI_STR_EXCLUSIVE "can't be used together"
+#endif
+
+#ifndef CLI_STR_REQUIRES
+#define CLI_STR_REQUIRES "requires"
+#endif
+
+#ifndef CLI_STR_ATLEASTONE
+#define CLI_STR_ATLEASTONE "At least one is required of"
+#endif
+
+#ifndef CLI_STR_ERR_NUMBER
+#define CLI_STR_ERR_NUMBER "Invalid number in"
+#endif
+
+#ifndef CLI_STR_ERR_RANGE
+#define CLI_STR_ERR_RANGE "Number out of range in"
+#endif
+
+#ifndef CLI_STR_ERR_TOOMANY
+#define CLI_STR_ERR_TOOMANY "Too many values in"
+#endif
+
+#ifndef CLI_STR_UNKNOWN
+#define CLI_STR_UNKNOWN "Unknown option"
+#endif
+
+#ifndef CLI_STR_SUGGEST
+#define CLI_STR_SUGGEST "did you mean"
+#endif
+
+#ifndef CLI_STR_APPLET
+#define CLI_STR_APPLET "Unknown applet"
+#endif
+
+#ifndef CLI_STR_ERR_FILE
+#define CLI_STR_ERR_FILE "Can't read the file for"
+#endif
+
+// If `trc.h` has been included before `cli.h`, traces are recorded and written later
+// in bulk, rather than formatted and written immediately (see `trc.h`).
+#if !defined(NDEBUG) && !defined(CLI_FREESTANDING)
+#ifdef TRC_VERSION
+#define cli_trace(...) trcdebug(__VA_ARGS__)
+#else
 #define cli_trace(...) (fflush(stdout),fprintf(stderr,"" __VA_ARGS__),fprintf(stderr," :%s:%d\n",__FILE__,__LINE__))
+#endif
 #else
 #define cli_trace(...)
 #endif
@@ -93,9 +373,11 @@
 #define CLI_OPT_FLAG_LONG  0x40   // is --zorro
 #define CLI_OPT_COMMAND    0x20   // is 'add'
 #define CLI_OPT_ARGUMENT   0x10   // Takes an argument
+#define CLI_OPT_DEFER      0x08   // validation is deferred (see `CLIDEFER`)
 #define CLI_OPT_OPTIONAL   0x04   // the argument is optional
 #define CLI_OPT_ARG_ERROR  0x02   // Error: missing argument
 #define CLI_OPT_FOUND      0x01   // this as been already found
+#define CLI_OPT_INDIRECT  0x100   // the value can be `@path` (see `CLI_INDIRECT`)
 
 typedef struct cli_option_s {
   struct  cli_option_s *next;
@@ -103,82 +385,176 @@ typedef struct cli_option_s {
            char  short_minus;    // This is a trick so that a pointer to
            char  optname_short;  // `short_minus` is also a pointer to the
            char  short_nul;      // string "-x" (where `x` is `optname_short`)
-  unsigned char  flags;
+  unsigned short flags;
   unsigned char  optname_offset; 
   unsigned char  optname_len;
+  unsigned short bit;            // Index in `cli_found_bits` (see `cliexclusive()`)
+  unsigned int   hash;           // Hash of the name (see `cli_meta_t`)
 } cli_option_t;
 
 #define cli_short_offset(opt_)  ((char *)&(opt_->short_minus))
 #define cli_short_len(opt_)     2
 
-static cli_option_t *cli_head = NULL;
+CLI_VAR cli_option_t *cli_head CLI_INIT(NULL);
 
 // This works because, according to the C standard, a pointer to a
 // structure is also a pointer to its first field (`next` in this case).
-static cli_option_t *cli_tail = (cli_option_t *)&cli_head;
+CLI_VAR cli_option_t *cli_tail CLI_INIT((cli_option_t *)&cli_head);
 
-static char  *cli_emptystr = "";
+CLI_VAR char  *cli_emptystr CLI_INIT("");
 
-static char **cliargv;
-static int    cliargc;
+CLI_VAR char **cliargv;
+CLI_VAR int    cliargc;
 
-static char  *cliarg;
-static int    clindx;
+CLI_VAR char  *cliarg;
+CLI_VAR int    clindx;
 
-static char  *cliprogname = NULL;
-static char  *cliheader   = "";
+CLI_VAR char  *cliprogname CLI_INIT(NULL);
+CLI_VAR char  *cliheader   CLI_INIT("");
 
-static int cli_no_flags = 0;
+CLI_VAR int cli_no_flags CLI_INIT(0);
 
-static unsigned short cli_num_options   = 0;
-static unsigned short cli_num_commands  = 0;
-static unsigned short cli_num_arguments = 0;
+CLI_VAR unsigned short cli_num_options   CLI_INIT(0);
+CLI_VAR unsigned short cli_num_commands  CLI_INIT(0);
+CLI_VAR unsigned short cli_num_arguments CLI_INIT(0);
 
-static unsigned short cli_cmd_found = 0;
+CLI_VAR unsigned short cli_cmd_found CLI_INIT(0);
 
-static int cli_default_errors = 0;
+CLI_VAR int cli_default_errors CLI_INIT(0);
 
-static char *clierrormsg = CLI_STR_ERROR_MSG;
+CLI_VAR char *clierrormsg CLI_INIT(CLI_STR_ERROR_MSG);
 
 typedef char * (*cli_chk_t)(char *);
 
+CLI_FN char *cli_chk_true(char *arg) {return NULL;}
+
+// Where `cliarg` comes from
+#define CLI_SRC_ARG     0   // The command line
+#define CLI_SRC_DEFAULT 1   // The default value in the definition: `(42)`
+#define CLI_SRC_ENV     2   // An environment variable: `($VAR,fb)`
+
+CLI_VAR unsigned char cli_src CLI_INIT(CLI_SRC_ARG);
+
 #define cliisdefault()  (clindx == 0)
+#define cliisenv()      (clindx == 0 && cli_src == CLI_SRC_ENV)
+
+// Snapshots of the parsed options (see `CLI_SNAPSHOT` below)
+#ifdef CLI_SNAPSHOT
+CLI_VAR int  cli_replay CLI_INIT(0);
+CLI_FN void cli_snap_rec(unsigned short bit, int src);
+CLI_FN int  cli_snap_begin();
+CLI_FN int  cli_snap_next();
+CLI_FN int  cli_snap_default(cli_option_t *opt);
+CLI_INLINE int cli_snap_check(cli_option_t *opt);
+CLI_FN int  cli_snap_last();
+#define cli_more() (cli_replay ? cli_snap_next() : clindx < cliargc)
+#else
+#define cli_replay 0
+#define cli_snap_rec(b_, s_) ((void)0)
+#define cli_snap_begin()     0
+#define cli_snap_default(o_) 0
+#define cli_snap_check(o_)   0
+#define cli_snap_last()      0
+#define cli_more()           (clindx < cliargc)
+#endif
+
+// Values read from files: `--cert=@cert.pem` (see `CLI_INDIRECT` below). Validators
+// get the contents of the file (NULL if it can't be read).
+#ifdef CLI_INDIRECT
+CLI_FN char *cli_view(char *val, size_t *len);
+#define cli_chk_value(o_, v_) ((o_)->flags & CLI_OPT_INDIRECT ? cli_view(v_, NULL) : (v_))
+#else
+#define cli_chk_value(o_, v_) (v_)
+#endif
 
 #define clierror(s,...)   cli_prt_error(1,s,__VA_ARGS__)
 #define cliwarning(s,...) cli_prt_error(0,s,__VA_ARGS__)
 
-#define cli_message(...) (fflush(stdout), fprintf(stderr,"%s: ",cliprogname), fprintf(stderr,"" __VA_ARGS__), fputc('\n',stderr))
+// ## Output
+// All the output (usage and error messages) goes through `cliwrite`, which writes to
+// `stderr` by default. Set it to your own function to redirect the output (or to NULL
+// to suppress it). In the `CLI_FREESTANDING` profile it's NULL unless you set it.
+// Output is collected in a small buffer so that each line is written at once.
+
+typedef void (*cli_write_t)(const char *s, int len);
+
+#ifndef CLI_FREESTANDING
+CLI_FN void cli_write_stderr(const char *s, int len) {
+  fflush(stdout);
+  fwrite(s, 1, len, stderr);
+}
+CLI_VAR cli_write_t cliwrite CLI_INIT(cli_write_stderr);
+#else
+CLI_VAR cli_write_t cliwrite CLI_INIT(NULL);
+#endif
+
+CLI_VAR char cli_outbuf[128];
+CLI_VAR int  cli_outlen CLI_INIT(0);
 
-#define cli_prt_error(x,s,...) \
-  do { \
-    char *cli_err = s;\
-    if (cli_err) { \
-      if (cli_err[0] == '\0') cli_err = clierrormsg; \
-        cli_message(vrg(cli_error_arg_,cli_err,__VA_ARGS__));\
-      if (x) exit(1); \
-    } \
-  } while(0)
+CLI_FN void cli_flush() {
+  if (cli_outlen > 0 && cliwrite != NULL) cliwrite(cli_outbuf, cli_outlen);
+  cli_outlen = 0;
+}
+
+// Writes `n` chars of `s` (all of them if `n` is negative)
+CLI_FN void cli_putn(const char *s, int n) {
+  if (s == NULL) return;
+  if (n < 0) n = (int)strlen(s);
+  while (n > 0) {
+    int k = (int)sizeof(cli_outbuf) - cli_outlen;
+    if (k > n) k = n;
+    memcpy(cli_outbuf + cli_outlen, s, k);
+    cli_outlen += k; s += k; n -= k;
+    if (cli_outlen == (int)sizeof(cli_outbuf)) cli_flush();
+  }
+}
+
+#define cli_puts(s) cli_putn(s, -1)
+
+#define cli_prt_error(x,s,...) cli_error(x, s, vrg(cli_error_arg_,__VA_ARGS__))
+
+#define cli_error_arg_1(a)    a, -1
+#define cli_error_arg_2(a,n)  a, n
+
+CLI_FN void cli_error(int x, char *err, char *arg, int len)
+{
+  if (err == NULL) return;
+  if (err[0] == '\0') err = clierrormsg;
+  cli_puts(cliprogname);
+  cli_puts(": " CLI_STR_ERROR ": ");
+  cli_puts(err);
+  cli_puts(" '");
+  cli_putn(arg, len);
+  cli_puts("'");
+  if (cliisdefault()) cli_puts(CLI_STR_DEFAULT);
+  cli_puts("\n\n");
+  cli_flush();
+  if (x) CLI_EXIT(1);
+}
 
-#define cli_error_arg_2(s,a)    CLI_STR_ERROR ": %s '%s'%s\n",s,a,(cliisdefault()? CLI_STR_DEFAULT :"")
-#define cli_error_arg_3(s,a,n)  CLI_STR_ERROR ": %s '%.*s'%s\n",s,n,a,(cliisdefault()? CLI_STR_DEFAULT :"")
+// ASCII only (and no locale): `cli_isalnum()` and friends are not available in the
+// freestanding profile and are undefined for negative `char` values anyway.
+CLI_INLINE int cli_isalpha(char c) {return (unsigned)((c | 0x20) - 'a') < 26;}
+CLI_INLINE int cli_isalnum(char c) {return cli_isalpha(c) || (unsigned)(c - '0') < 10;}
+CLI_INLINE int cli_isspace(char c) {return c == ' ' || (unsigned)(c - '\t') < 5;}
 
-static inline int cli_is_endchr(char c) {
+CLI_INLINE int cli_is_endchr(char c) {
   return c == '\0' || c == '\t' || c == '(' || c == ')';
 }
 
-static inline int cli_is_skipchr(char c) {
+CLI_INLINE int cli_is_skipchr(char c) {
   char *skip = " .,|;:*?!@#/&%~=^";
   while(*skip) if (c == *skip++) return 1;
   return 0;
 } 
 
-static int cli_parse_short(cli_option_t *opt, char **cur) 
+CLI_FN int cli_parse_short(cli_option_t *opt, char **cur) 
 {
   char *d = *cur;
   opt->optname_short = '\0';
 
   while (cli_is_skipchr(*d)) d++;
-  if (*d != '-' || !isalnum(d[1]) || isalnum(d[2])) return 0;
+  if (*d != '-' || !cli_isalnum(d[1]) || cli_isalnum(d[2])) return 0;
 
   opt->optname_short = d[1];
   opt->flags |= CLI_OPT_FLAG_SHORT;
@@ -186,17 +562,17 @@ static int cli_parse_short(cli_option_t *opt, char **cur)
   return 1;
 }
 
-static int cli_parse_long(cli_option_t *opt, char **cur) {
+CLI_FN int cli_parse_long(cli_option_t *opt, char **cur) {
   char *d = *cur;
   int flags = 0;
   int offset;
   while (cli_is_skipchr(*d)) d++;
   cli__trace("Checking: %s",d);
   offset = d - opt->def;
-  if (d[0] == '-' && d[1] == '-' && isalpha(d[2])) {
+  if (d[0] == '-' && d[1] == '-' && cli_isalpha(d[2])) {
     flags = CLI_OPT_FLAG_LONG;
   }
-  else if ((d[0] == '\'' || d[0] == '<') && isalpha(d[1])) {
+  else if ((d[0] == '\'' || d[0] == '<') && cli_isalpha(d[1])) {
     offset++;
     flags = CLI_OPT_COMMAND;
   }
@@ -206,7 +582,7 @@ static int cli_parse_long(cli_option_t *opt, char **cur) {
   opt->optname_offset = offset;
 
   d += 2;
-  do { d++; } while (*d == '-' || isalnum(*d));
+  do { d++; } while (*d == '-' || cli_isalnum(*d));
   opt->optname_len = (d - opt->def) - opt->optname_offset;
   if (d[0] == '\'' || d[0] == '>') d++;
   opt->flags |= flags;
@@ -215,19 +591,21 @@ static int cli_parse_long(cli_option_t *opt, char **cur) {
   return 1;
 }
 
-static int cli_parse_argname(cli_option_t *opt, char **cur) {
+CLI_FN int cli_parse_argname(cli_option_t *opt, char **cur) {
   char *d = *cur;
   int offset;
   int flags = CLI_OPT_ARGUMENT;
 
   while (cli_is_skipchr(*d)) d++;
 
+  if (d > *cur && d[-1] == '@') flags |= CLI_OPT_INDIRECT;  // `@file` or `@[file]`
   if (*d == '[') {d++; flags |= CLI_OPT_OPTIONAL;}
+  if (*d == '@') {d++; flags |= CLI_OPT_INDIRECT;}          // `[@file]`
 
-  if (!isalpha(*d)) return 0;
+  if (!cli_isalpha(*d)) return 0;
   
   offset = d - opt->def;
-  do {d++;} while (*d == '-' || isalnum(*d));
+  do {d++;} while (*d == '-' || cli_isalnum(*d));
   if (opt->optname_len == 0) { // It's a positional argument
     opt->optname_offset = offset;
     opt->optname_len = (d - opt->def) - opt->optname_offset;
@@ -239,25 +617,30 @@ static int cli_parse_argname(cli_option_t *opt, char **cur) {
   return 1;
 }
 
-static int cli_parse_default(cli_option_t *opt, char **cur, cli_chk_t cli_chk_fn) {
+CLI_VAR char cli_defbuf[32];  // The default value (an inline function can't have its own)
+
+// Sets `cliarg` (and `cli_src`) to the default value at `*cur`, if there is one
+CLI_FN int cli_default_value(char **cur) {
   char *d = *cur;
-  static char defbuf[32];
+  char *defbuf = cli_defbuf;
   int i;
 
   while (cli_is_skipchr(*d)) d++; 
   if (*d != '(' ) return 0;
 
   cliarg = NULL;
+  cli_src = CLI_SRC_ENV;
   do { d++; } while (*d == ' ');
   if (*d == '$') {
     d++;
     i = 0;
-    while(i<31 && (*d == '_' || isalnum(*d))) {defbuf[i++] = *d++;}
+    while(i<31 && (*d == '_' || cli_isalnum(*d))) {defbuf[i++] = *d++;}
     defbuf[i] = '\0';
-    cliarg = getenv(defbuf);
+    cliarg = CLI_GETENV(defbuf);
   }
   if (cliarg == NULL) {
-    while(*d == ',' || isspace(*d)) d++;
+    cli_src = CLI_SRC_DEFAULT;
+    while(*d == ',' || cli_isspace(*d)) d++;
     if (!cli_is_endchr(*d)) {
       i = 0;
       while(i<31 && !cli_is_endchr(*d)) {defbuf[i++] = *d++;}
@@ -267,42 +650,191 @@ static int cli_parse_default(cli_option_t *opt, char **cur, cli_chk_t cli_chk_fn
   }
 
   if (cliarg == NULL) cliarg = cli_emptystr;
- 
-  char *arg = cli_short_offset(opt); 
-  int   len = cli_short_len(opt);
-  if (opt->optname_len > 0) {
-    arg = opt->def + opt->optname_offset;
-    len = opt->optname_len;
-  } 
+  *cur = d;
+  return 1;
+}
 
-  char *err_msg = cli_chk_fn(cliarg);
+// The name of the option for the messages: the long one (or the command or the
+// argument) if there is one, `-x` otherwise
+CLI_INLINE char *cli_opt_name(cli_option_t *opt, int *len)
+{
+  if (opt->optname_len == 0) {
+    *len = cli_short_len(opt);
+    return cli_short_offset(opt);
+  }
+  *len = opt->optname_len;
+  return opt->def + opt->optname_offset;
+}
+
+CLI_FN int cli_parse_default(cli_option_t *opt, char **cur, cli_chk_t cli_chk_fn) {
+  if (!cli_default_value(cur)) return 0;
+
+  int   len;
+  char *arg = cli_opt_name(opt, &len);
+  char *val, *err_msg = NULL;
+  if (cli_chk_fn != cli_chk_true)
+    err_msg = (val = cli_chk_value(opt, cliarg)) ? cli_chk_fn(val) : CLI_STR_ERR_FILE;
   if (err_msg) {
     cliwarning(err_msg,arg,len);
     opt->flags |= CLI_OPT_ARG_ERROR;
     cli_default_errors++;
   }
 
-  *cur = d;
+  cli_snap_rec(opt->bit, cli_src);
   return 1;
 }
 
-static int cli_opt_define(char *def, cli_option_t *opt, cli_chk_t cli_chk_fn) {
-  *opt = (cli_option_t){0};
+// ## Classification of the arguments
+// Each `cliopt()` is checked against the current argument. Rather than having each of
+// them look again at the leading '-', search for '=' and compare the name, the
+// arguments are classified once, when the scan starts, into a small array:
+//
+//   - `kind`: operand, short option(s) (`-x`, `-abc`), long option (`--name`) or `--`;
+//   - `len`:  length of the name, up to the first '=' (if `eq` is set) or to the end;
+//   - `hash`: hash of the name, compared with the one computed for each option when
+//             it's defined, so that names are compared only when they likely match.
+//
+// Strings are scanned eight bytes at a time with `CLI_SWAR` (see below). The array
+// has room for `CLI_META_MAX` arguments; it's allocated for larger `argv` (in the
+// freestanding profile, the arguments beyond that are classified when they're met).
+
+#ifndef CLI_SWAR
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) \
+    || defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+#define CLI_SWAR 1
+#else
+#define CLI_SWAR 0
+#endif
+#endif
 
-  cli_tail->next = opt;
-  cli_tail  = opt;
+#ifdef __GNUC__
+#define cli_ctz(x) __builtin_ctzll(x)
+#else
+CLI_INLINE int cli_ctz(unsigned long long x) {int n = 0; while (!(x & 1)) {x >>= 1; n++;} return n;}
+#endif
+
+#ifndef CLI_META_MAX
+#define CLI_META_MAX 64
+#endif
+
+#define CLI_TOK_OPERAND   0
+#define CLI_TOK_SHORT     1  // -x or -abc
+#define CLI_TOK_LONG      2  // --name or --name=value
+#define CLI_TOK_DASHDASH  3  // --
+
+typedef struct {
+  unsigned char  kind;
+  unsigned char  eq;     // The name is followed by '=' (at offset `len`)
+  unsigned short len;    // Length of the name
+  unsigned int   hash;
+} cli_meta_t;
+
+CLI_VAR cli_meta_t  cli_meta_buf[CLI_META_MAX];
+CLI_VAR cli_meta_t *cli_metas CLI_INIT(cli_meta_buf);
+CLI_VAR int cli_num_metas CLI_INIT(0);
+CLI_VAR int cli_max_metas CLI_INIT(CLI_META_MAX);
+CLI_VAR cli_meta_t cli_meta_tmp;
+
+#define CLI_ONES  0x0101010101010101ULL
+#define CLI_HIGHS 0x8080808080808080ULL
+
+// Offset of the first '=' in the `n` chars at `s` (`n` if there is none)
+CLI_INLINE int cli_find_eq(const char *s, int n)
+{
+  int k = 0;
+#if CLI_SWAR
+  for (; k + 8 <= n; k += 8) {
+    unsigned long long w;
+    memcpy(&w, s + k, 8);
+    w ^= CLI_ONES * '=';         // '=' -> 0
+    w = (w - CLI_ONES) & ~w & CLI_HIGHS;
+    if (w) return k + cli_ctz(w) / 8;
+  }
+#endif
+  while (k < n && s[k] != '=') k++;
+  return k;
+}
+
+CLI_INLINE unsigned int cli_hash(const char *s, int n)
+{
+  unsigned long long h = 0x9E3779B97F4A7C15ULL ^ (unsigned)n, w;
+  for (; n >= 8; n -= 8, s += 8) {
+    memcpy(&w, s, 8);
+    h = (h ^ w) * 0x100000001B3ULL;
+    h ^= h >> 29;
+  }
+  if (n > 0) {
+    w = 0;
+    memcpy(&w, s, n);
+    h = (h ^ w) * 0x100000001B3ULL;
+    h ^= h >> 29;
+  }
+  return (unsigned int)(h ^ (h >> 32));
+}
+
+CLI_FN void cli_classify(const char *arg, cli_meta_t *m)
+{
+  int n = (int)strlen(arg);
+  if (arg[0] != '-' || arg[1] == '\0') m->kind = CLI_TOK_OPERAND;
+  else if (arg[1] != '-')               m->kind = CLI_TOK_SHORT;
+  else if (arg[2] != '\0')              m->kind = CLI_TOK_LONG;
+  else                                  m->kind = CLI_TOK_DASHDASH;
+  int len = cli_find_eq(arg, n);
+  m->eq   = (len < n);
+  m->len  = len > 0xFFFF ? 0xFFFF : len;
+  m->hash = cli_hash(arg, len);
+}
+
+CLI_FN void cli_classify_all()
+{
+  int n = cliargc;
+  if (n > cli_max_metas) {
+#ifndef CLI_FREESTANDING
+    cli_meta_t *m = realloc(cli_metas == cli_meta_buf ? NULL : cli_metas, n * sizeof(cli_meta_t));
+    if (m != NULL) {
+      cli_metas = m;
+      cli_max_metas = n;
+    }
+#endif
+    if (n > cli_max_metas) n = cli_max_metas;
+  }
+  for (int k = 0; k < n; k++) cli_classify(cliargv[k], &cli_metas[k]);
+  cli_num_metas = n;
+}
+
+CLI_INLINE cli_meta_t *cli_meta(int k)
+{
+  if (k < cli_num_metas) return &cli_metas[k];
+  cli_classify(cliargv[k], &cli_meta_tmp);
+  return &cli_meta_tmp;
+}
+
+CLI_VAR unsigned short cli_num_bits CLI_INIT(0);
+
+// Sets `opt` from the names in the definition `def`; returns what follows them
+CLI_FN char *cli_opt_names(cli_option_t *opt, char *def, int flags) {
+  *opt = (cli_option_t){0};
+  opt->flags = (unsigned short)flags;
   opt->def  = def;
-  opt->next = NULL;
   opt->short_minus = '-';
   opt->short_nul   = '\0';
-  opt->optname_offset = 0;
-  opt->optname_len = 0;
 
   cli_parse_short(opt, &def);
   cli_parse_long(opt, &def);
   cli_parse_argname(opt, &def);
 
   if (opt->optname_len > 30) opt->optname_len = 30;
+  opt->hash = cli_hash(opt->def + opt->optname_offset, opt->optname_len);
+  return def;
+}
+
+CLI_FN int cli_opt_define(char *def, cli_option_t *opt, cli_chk_t cli_chk_fn, int mode) {
+  def = cli_opt_names(opt, def, mode & CLI_OPT_DEFER);
+  opt->bit = cli_num_bits++;
+
+  cli_tail->next = opt;
+  cli_tail  = opt;
+  opt->next = NULL;   // Still linked to the next one from a previous scan
 
   if (opt->flags & (CLI_OPT_FLAG_SHORT | CLI_OPT_FLAG_LONG)) 
     cli_num_options++;
@@ -311,10 +843,11 @@ static int cli_opt_define(char *def, cli_option_t *opt, cli_chk_t cli_chk_fn) {
   else
     cli_num_arguments++;
 
+  if (cli_replay) return cli_snap_default(opt);  // No environment, no validation
   return cli_parse_default(opt, &def, cli_chk_fn);
 }
 
-static char *cli_remove_slash(char *s)
+CLI_FN char *cli_remove_slash(char *s)
 {
   char *e = s; 
   while(*e) {
@@ -324,73 +857,235 @@ static char *cli_remove_slash(char *s)
   return s;
 }
 
-static int cli_print_cmd(char *cmd)
+#define CLIEXIT 1
+#define cliusage(...)   cli_usage(__VA_ARGS__+0)
+
+#ifndef CLI_NO_USAGE
+CLI_FN int cli_print_cmd(char *cmd)
 {
   char *s = cmd;
   
-  fputs("  ",stderr);
-  for (s = cmd; *s && *s != '\'' && *s != '<'; s++) 
-    fputc(*s,stderr);
+  cli_puts("  ");
+  for (s = cmd; *s && *s != '\'' && *s != '<'; s++) ;
+  cli_putn(cmd, (int)(s - cmd));
   
   if (!*s) return 0;
 
-  for (s++; *s && *s != '\'' && *s != '>'; s++) 
-    fputc(*s,stderr);
+  for (cmd = ++s; *s && *s != '\'' && *s != '>'; s++) ;
+  cli_putn(cmd, (int)(s - cmd));
   
   if (!*s) return 0;
 
-  fprintf(stderr,"%s\n",s+1);
+  cli_puts(s+1);
+  cli_puts("\n");
   return 1;
 }      
 
-
-#define CLIEXIT 1
-#define cliusage(...)   cli_usage(__VA_ARGS__+0)
-
-int cli_usage(int xt) {
+CLI_FN int cli_usage(int xt) {
   cli_option_t *opt;
 
-  if (cliheader != NULL) fprintf(stderr,"%s\n",cliheader);
-  fprintf(stderr, CLI_STR_USAGE ": %s", cliprogname);
+  if (cliheader != NULL) {cli_puts(cliheader); cli_puts("\n");}
+  cli_puts(CLI_STR_USAGE ": ");
+  cli_puts(cliprogname);
   
-  if (cli_num_commands > 0) fprintf(stderr," " CLI_STR_COMMANDS);
-  if (cli_num_options > 0)  fprintf(stderr," " CLI_STR_OPTIONS);
+  if (cli_num_commands > 0) cli_puts(" " CLI_STR_COMMANDS);
+  if (cli_num_options > 0)  cli_puts(" " CLI_STR_OPTIONS);
   if (cli_num_arguments > 0) {
     for (opt = cli_head; opt != NULL; opt = opt->next) 
       if (!(opt->flags & (CLI_OPT_FLAG_SHORT | CLI_OPT_FLAG_LONG | CLI_OPT_COMMAND))) {
         int not_optional = !(opt->flags & CLI_OPT_OPTIONAL);
-        fprintf(stderr," %s%.*s%s","["+not_optional,opt->optname_len, opt->def+opt->optname_offset,"]"+not_optional);
+        cli_puts(" ");
+        cli_puts("[" + not_optional);
+        cli_putn(opt->def + opt->optname_offset, opt->optname_len);
+        cli_puts("]" + not_optional);
       }
   }
 
-  if (cli_num_commands > 0) fprintf(stderr,"\n" CLI_STR_COMMANDS ":\n");
+  if (cli_num_commands > 0) cli_puts("\n" CLI_STR_COMMANDS ":\n");
   for (opt = cli_head; opt != NULL;opt = opt->next) 
     if (opt->flags & CLI_OPT_COMMAND)
       cli_print_cmd(opt->def);
 
-  if (cli_num_options > 0) fprintf(stderr,"\n" CLI_STR_OPTIONS ":\n");
+  if (cli_num_options > 0) cli_puts("\n" CLI_STR_OPTIONS ":\n");
   for (opt = cli_head; opt != NULL;opt = opt->next)
-    if (opt->flags & (CLI_OPT_FLAG_SHORT | CLI_OPT_FLAG_LONG))
-      fprintf(stderr,"  %s\n",opt->def);
+    if (opt->flags & (CLI_OPT_FLAG_SHORT | CLI_OPT_FLAG_LONG)) {
+      cli_puts("  "); cli_puts(opt->def); cli_puts("\n");
+    }
 
-  if (cli_num_arguments > 0) fprintf(stderr,"\n" CLI_STR_ARGUMENTS ":\n");
+  if (cli_num_arguments > 0) cli_puts("\n" CLI_STR_ARGUMENTS ":\n");
   for (opt = cli_head; opt != NULL;opt = opt->next)
-    if (!(opt->flags & (CLI_OPT_FLAG_SHORT | CLI_OPT_FLAG_LONG | CLI_OPT_COMMAND)))
-      fprintf(stderr,"  %s\n",opt->def);
+    if (!(opt->flags & (CLI_OPT_FLAG_SHORT | CLI_OPT_FLAG_LONG | CLI_OPT_COMMAND))) {
+      cli_puts("  "); cli_puts(opt->def); cli_puts("\n");
+    }
 
-  if (xt != 0) exit(xt);
+  cli_flush();
+  if (xt != 0) CLI_EXIT(xt);
+  return(0);
+}
+#else
+CLI_FN int cli_usage(int xt) {
+  if (xt != 0) CLI_EXIT(xt);
   return(0);
 }
+#endif
+
+// ## Lists of numbers
+// `cliints()` and `clifloats()` convert a list of numbers separated by commas and/or
+// spaces (e.g. `--ids 1,2,3` or `--weights "0.5 0.25 0.25"`) into the array `out`
+// that can hold up to `max` values. They return the number of values or -1 in case of
+// error, with `clierrormsg` set to the reason so that `clierror("",cliarg)` reports it.
+// If `out` is NULL, the values are only checked and counted (to size the array).
+//
+// Digits are converted eight at a time (SWAR: SIMD Within A Register) rather than one
+// by one. This requires a little endian machine, otherwise (or if `CLI_SWAR` is
+// defined as 0) digits are converted one by one.
+
+CLI_VAR const unsigned long long cli_pow10[] CLI_INIT({
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+});
+
+// Converts up to 8 digits starting at `s` (`end` is the end of the string).
+// Returns the number of digits and sets `*v` to their value.
+CLI_INLINE int cli_digits(const char *s, const char *end, unsigned long long *v)
+{
+  unsigned long long x = 0;
+  int n = 0;
+#if CLI_SWAR
+  if (end - s >= 8) {
+    unsigned long long m;
+    memcpy(&x, s, 8);
+    x ^= 0x3030303030303030ULL;  // '0'..'9' -> 0..9
+    // Bytes that are not digits have the high nibble set (possibly after adding 6).
+    // Carries only go toward the following bytes, so the first non digit is exact.
+    m = (x | (x + 0x0606060606060606ULL)) & 0xF0F0F0F0F0F0F0F0ULL;
+    n = m ? cli_ctz(m) / 8 : 8;
+    if (n == 0) {*v = 0; return 0;}
+    x <<= 8 * (8 - n);           // Drop the non digits, leading zeros come in.
+    x = (x * 10    + (x >> 8))  & 0x00FF00FF00FF00FFULL;
+    x = (x * 100   + (x >> 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x * 10000 + (x >> 32)) & 0x00000000FFFFFFFFULL;
+    *v = x;
+    return n;
+  }
+#endif
+  while (n < 8 && s < end && (unsigned)(*s - '0') < 10) {
+    x = x * 10 + (unsigned)(*s++ - '0');
+    n++;
+  }
+  *v = x;
+  return n;
+}
+
+CLI_INLINE int cli_is_listsep(char c) {return c == ' ' || c == '\t' || c == '\n' || c == '\r';}
+
+// Converts the number at `s` and stores it in `out[k]`. Returns the end of the
+// number or NULL (with `clierrormsg` set) in case of error.
+typedef char *(*cli_num_t)(char *s, char *end, void *out, int k);
+
+CLI_INLINE char *cli_num_int(char *s, char *end, void *out, int k)
+{
+  unsigned long long v = 0, d, lim = LLONG_MAX;
+  char *start;
+  int n, neg = 0;
+
+  if (*s == '-' || *s == '+') neg = (*s++ == '-');
+  if (neg) lim += 1;
+  start = s;
+  while ((n = cli_digits(s, end, &d)) > 0) {
+    if (v > (lim - d) / cli_pow10[n]) {clierrormsg = CLI_STR_ERR_RANGE; return NULL;}
+    v = v * cli_pow10[n] + d;
+    s += n;
+    if (n < 8) break;
+  }
+  if (s == start) {clierrormsg = CLI_STR_ERR_NUMBER; return NULL;}
+
+  if (out) ((long long *)out)[k] = (neg && v > 0) ? -(long long)(v - 1) - 1 : (long long)v;
+  return s;
+}
+
+// Numbers with at most 15 digits and no exponent are computed as an integer divided
+// by a power of ten: both are exact doubles, so the result is correctly rounded.
+// Anything else is left to `strtod()` (or is an error in the freestanding profile).
+// Since `strtod()` also accepts hexadecimal numbers, `inf` and `nan`, a number must
+// start with a digit or a '.' followed by a digit (after the sign). Note that `strtod()`
+// uses the decimal point of the current locale (`LC_NUMERIC`).
+CLI_INLINE char *cli_num_float(char *s, char *end, void *out, int k)
+{
+  static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                                 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+  unsigned long long m = 0, d;
+  char *p = s;
+  int n, nd = 0, nf = -1, neg = 0;
+  double x;
+
+  if (*p == '-' || *p == '+') neg = (*p++ == '-');
+  for (;;) {
+    while ((n = cli_digits(p, end, &d)) > 0) {
+      if (nd + n > 15) goto slow;
+      m = m * cli_pow10[n] + d;
+      nd += n;
+      p += n;
+      if (nf >= 0) nf += n;
+      if (n < 8) break;
+    }
+    if (*p != '.' || nf >= 0) break;
+    nf = 0; p++;
+  }
+  if (nd == 0 || !(*p == '\0' || *p == ',' || cli_is_listsep(*p))) goto slow;
+
+  x = (double)m;
+  if (nf > 0) x /= pow10[nf];
+  if (out) ((double *)out)[k] = neg ? -x : x;
+  return p;
+
+ slow:
+#ifdef CLI_FREESTANDING
+  clierrormsg = CLI_STR_ERR_NUMBER;
+  return NULL;
+#else
+  p = s + (*s == '-' || *s == '+');
+  if (!((unsigned)(*p - '0') < 10 || (*p == '.' && (unsigned)(p[1] - '0') < 10))
+      || (p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))) {
+    clierrormsg = CLI_STR_ERR_NUMBER;
+    return NULL;
+  }
+  errno = 0;
+  x = strtod(s, &p);
+  if (p == s) {clierrormsg = CLI_STR_ERR_NUMBER; return NULL;}
+  if (errno == ERANGE && (x == HUGE_VAL || x == -HUGE_VAL)) {clierrormsg = CLI_STR_ERR_RANGE; return NULL;}
+  if (out) ((double *)out)[k] = x;
+  return p;
+#endif
+}
+
+CLI_INLINE int cli_list(char *s, void *out, int max, cli_num_t cli_num)
+{
+  char *end = s + strlen(s);
+  int k = 0;
+
+  while (cli_is_listsep(*s)) s++;
+  if (*s == '\0') return 0;
+  for (;;) {
+    if (out && k >= max) {clierrormsg = CLI_STR_ERR_TOOMANY; return -1;}
+    if ((s = cli_num(s, end, out, k)) == NULL) return -1;
+    k++;
+    if (*s != '\0' && *s != ',' && !cli_is_listsep(*s)) {clierrormsg = CLI_STR_ERR_NUMBER; return -1;}
+    while (cli_is_listsep(*s)) s++;
+    if (*s == '\0') return k;
+    if (*s == ',') s++;
+    while (cli_is_listsep(*s)) s++;
+  }
+}
 
-static char *cli_chk_true(char *arg) {return NULL;}
+CLI_INLINE int cliints(char *s, long long *out, int max) {return cli_list(s, out, max, cli_num_int);}
+CLI_INLINE int clifloats(char *s, double *out, int max)  {return cli_list(s, out, max, cli_num_float);}
 
 // Get the next argument as the argument of the option. 
-static char *cli_get_arg(cli_option_t *opt, char *arg)
+CLI_FN char *cli_get_arg(cli_option_t *opt, char *arg)
 {
   cliarg = cli_emptystr;
   // If next argument exists and is not a flag
-  if (   ((clindx + 1) < cliargc) 
-      && !(cliargv[clindx+1][0] == '-' && cliargv[clindx+1][1]!='\0'))
+  if (((clindx + 1) < cliargc) && cli_meta(clindx + 1)->kind == CLI_TOK_OPERAND)
     cliarg = cliargv[++clindx];
 
   // If the arg is not optional and we didn't find one
@@ -406,15 +1101,15 @@ static char *cli_get_arg(cli_option_t *opt, char *arg)
 // like in `ps -aux` instead of `ps -a -u -x`.
 
 // This tells which char too look at into the arg
-static int cli_reparse_ndx = 1; 
+CLI_VAR int cli_reparse_ndx CLI_INIT(1);
 
 // If it's 1 we're looking at the first not (we're not reparsing)
 #define cli_no_reparse() (cli_reparse_ndx == 1)
 
-static int cli_check_short(cli_option_t *opt, char *arg)
+CLI_INLINE int cli_check_short(cli_option_t *opt, char *arg, cli_meta_t *m)
 {
   if (cli_no_flags) return 0;
-  if (arg[0] != '-' || arg[1] == '\0') return 0;
+  if (m->kind != CLI_TOK_SHORT) return 0;
 
   if (arg[cli_reparse_ndx] != opt->optname_short) return 0;
 
@@ -434,18 +1129,17 @@ static int cli_check_short(cli_option_t *opt, char *arg)
   return 1;
 }
 
-static int cli_check_long(cli_option_t *opt, char *arg)
+CLI_INLINE int cli_check_long(cli_option_t *opt, char *arg, cli_meta_t *m)
 {
   if (cli_no_flags) return 0;
 
   if ((opt->flags & CLI_OPT_COMMAND) && (cli_cmd_found)) return 0; // cmds can only appear once
-  if (strncmp(arg, opt->def+opt->optname_offset, opt->optname_len) != 0) return 0;
+  if (m->len != opt->optname_len || m->hash != opt->hash) return 0;
+  if (memcmp(arg, opt->def+opt->optname_offset, opt->optname_len) != 0) return 0;
   if (opt->flags & CLI_OPT_COMMAND) cli_cmd_found = 1; // cmds can only appears as first argument (possibly after some '-' options)
   
-  if (arg[opt->optname_len] != '\0' && arg[opt->optname_len] != '=') return 0;
-  
   if (opt->flags & CLI_OPT_ARGUMENT) {
-    if (arg[opt->optname_len] == '=') 
+    if (m->eq) 
       cliarg = arg + opt->optname_len+1;
     else
       cliarg = cli_get_arg(opt,arg);
@@ -455,103 +1149,1932 @@ static int cli_check_long(cli_option_t *opt, char *arg)
   return 1;
 }
 
-static int cli_check_arg(cli_option_t *opt, char *arg)
+CLI_INLINE int cli_check_arg(cli_option_t *opt, char *arg, cli_meta_t *m)
 {
   if (opt->flags & CLI_OPT_FOUND) return 0;
   if (opt->flags & (CLI_OPT_FLAG_SHORT | CLI_OPT_FLAG_LONG | CLI_OPT_COMMAND)) return 0;
-  if (!cli_no_flags && (arg[0] == '-' && arg[1] != '\0')) return 0;
+  if (!cli_no_flags && m->kind != CLI_TOK_OPERAND) return 0;
   cliarg = arg;
   opt->flags |= CLI_OPT_FOUND;
   cli_cmd_found = 1; // No commands after the first positional argumen
   return 1;
 }
  
-static int cli_check(cli_option_t *opt, cli_chk_t cli_chk_fn)
+// ## Deferred validation
+// Checking each argument as soon as it's found is a problem when there are many of
+// them and the check is expensive (e.g. a `stat()` for each of 100k file names).
+// Validators can be deferred:
+//
+//   - with `CLIDEFER` as third argument of `cliopt()`:
+//       `cliopt("-f, --file name\tInput file", is_file, CLIDEFER) { ... }`
+//   - with `clidefer(validator)` in any handler (including the one for `cliopt()`)
+//     to check `cliarg` later: `cliopt() { clidefer(is_file); files[n++] = cliarg; }`
+//
+// Handlers are still executed as the arguments are found (in their order), but the
+// check is queued. Queued checks are run at the end of the scan, in parallel if
+// `CLI_THREADS` is defined (as the maximum number of threads; 8 if empty). Every
+// failure is reported, in the order of the arguments, then the program exits.
+// Note that handlers get arguments that will be checked only later and that, with
+// `CLI_THREADS`, validators must be thread safe.
+
+#define CLIDEFER CLI_OPT_DEFER
+
+#define clidefer(chk) cli_defer(chk, cliarg, cliargv[clindx])
+
+typedef struct {
+  cli_chk_t  chk;
+  char      *arg;  // The value to check
+  char      *tok;  // The argument to mention in the error message
+  char      *err;
+} cli_deferred_t;
+
+#ifdef CLI_FREESTANDING
+CLI_FN void cli_defer(cli_chk_t chk, char *arg, char *tok)
 {
-  char *arg = cliargv[clindx];
-  opt->flags &= ~CLI_OPT_ARG_ERROR;
-  if (!cli_check_short(opt,arg) &&
-      !cli_check_long(opt,arg)  &&
-      !cli_check_arg(opt,arg)   )     
-    return 0;
+  char *err_msg = chk(arg);
+  if (err_msg) clierror(err_msg, tok);
+}
 
-  cli__trace("arg: %s",arg);
-  char *err_msg;
-  if ((err_msg = cli_chk_fn(cliarg)) != NULL) {
-    cli__trace("EE: %s",err_msg);
-    clierror(err_msg, arg);
-    opt->flags |= CLI_OPT_ARG_ERROR;
+CLI_FN void cli_check_deferred() {}
+#else
+CLI_VAR cli_deferred_t *cli_deferred CLI_INIT(NULL);
+CLI_VAR int cli_num_deferred CLI_INIT(0);
+CLI_VAR int cli_max_deferred CLI_INIT(0);
+
+CLI_FN void cli_defer(cli_chk_t chk, char *arg, char *tok)
+{
+  if (cli_num_deferred >= cli_max_deferred) {
+    int max = cli_max_deferred ? cli_max_deferred * 2 : 64;
+    cli_deferred_t *d = realloc(cli_deferred, max * sizeof(cli_deferred_t));
+    if (d == NULL) { // Can't defer it, check it now
+      char *err_msg = chk(arg);
+      if (err_msg) clierror(err_msg, tok);
+      return;
+    }
+    cli_deferred = d;
+    cli_max_deferred = max;
   }
-  return 1;
+  cli_deferred[cli_num_deferred++] = (cli_deferred_t){chk, arg, tok, NULL};
 }
 
-static int cli_last_check()
+#ifdef CLI_THREADS
+#include <pthread.h>
+
+#if (CLI_THREADS + 0) > 0
+#define CLI_NUM_THREADS (CLI_THREADS + 0)
+#else
+#define CLI_NUM_THREADS 8
+#endif
+
+// Each thread checks a contiguous slice of at least `CLI_DEFER_SLICE` arguments
+#ifndef CLI_DEFER_SLICE
+#define CLI_DEFER_SLICE 64
+#endif
+
+CLI_VAR int cli_num_workers;
+
+CLI_FN void *cli_check_slice(void *arg)
 {
-  for (cli_option_t *opt = cli_head; opt != NULL; opt = opt->next) {
-    if (opt->flags & (CLI_OPT_FLAG_LONG | CLI_OPT_FLAG_SHORT | CLI_OPT_COMMAND))
-      continue;
+  int w = (int)(size_t)arg;
+  int k   = (int)((long long)cli_num_deferred *  w      / cli_num_workers);
+  int end = (int)((long long)cli_num_deferred * (w + 1) / cli_num_workers);
+  for (; k < end; k++)
+    cli_deferred[k].err = cli_deferred[k].chk(cli_deferred[k].arg);
+  return NULL;
+}
+#endif
 
-    if (!(opt->flags & CLI_OPT_FOUND) && !(opt->flags & CLI_OPT_OPTIONAL)) {
-      clierror(clierrormsg,opt->def+opt->optname_offset, opt->optname_len);
-      opt->flags |= CLI_OPT_ARG_ERROR;
+CLI_FN void cli_check_deferred()
+{
+  int errors = 0;
+  if (cli_num_deferred == 0) return;
+
+#ifdef CLI_THREADS
+  pthread_t workers[CLI_NUM_THREADS];
+  int w, started;
+  cli_num_workers = (cli_num_deferred + CLI_DEFER_SLICE - 1) / CLI_DEFER_SLICE;
+  if (cli_num_workers > CLI_NUM_THREADS) cli_num_workers = CLI_NUM_THREADS;
+
+  // The first slice is checked by this thread, as the ones of the threads that
+  // couldn't be created.
+  for (started = 1; started < cli_num_workers; started++)
+    if (pthread_create(&workers[started], NULL, cli_check_slice, (void *)(size_t)started) != 0)
+      break;
+  for (w = started; w < cli_num_workers; w++) cli_check_slice((void *)(size_t)w);
+  cli_check_slice((void *)0);
+  for (w = 1; w < started; w++) pthread_join(workers[w], NULL);
+#else
+  for (int k = 0; k < cli_num_deferred; k++)
+    cli_deferred[k].err = cli_deferred[k].chk(cli_deferred[k].arg);
+#endif
+
+  for (int k = 0; k < cli_num_deferred; k++) {
+    if (cli_deferred[k].err) {
+      cliwarning(cli_deferred[k].err, cli_deferred[k].tok);
+      errors++;
     }
   }
-  return 1;
+  free(cli_deferred);
+  cli_deferred = NULL;
+  cli_num_deferred = cli_max_deferred = 0;
+  if (errors > 0) CLI_EXIT(1);
+}
+#endif // CLI_FREESTANDING
+
+// ## Asynchronous handlers
+// Handlers are executed in the order of the arguments, while they are scanned. When
+// some of them do expensive work that doesn't depend on the others (e.g. loading a
+// model, opening the output, warming a cache), that work can be put in a function
+// with the same signature as a validator and started with `cliasync()`:
+//
+//     char *load_model(char *file) { ...; return ok ? NULL : "Can't load model"; }
+//
+//     cliopt("-m, --model file\tThe model") { cliasync(load_model); }
+//
+// If `CLI_THREADS` is defined, the function runs on a pool of up to `CLI_THREADS`
+// threads while the scan goes on (so it overlaps with the other handlers), otherwise
+// it runs immediately. Either way, all of them are completed by the end of the
+// `clioptions()` block and the ones that failed are reported in the order of the
+// arguments, then the program exits. Note that the functions run concurrently with
+// each other and with the handlers, so they must only share data safely.
+
+#define cliasync(fn) cli_async_run(fn, cliarg, cliargv[clindx])
+
+#ifdef CLI_FREESTANDING
+CLI_INLINE void cli_async_run(cli_chk_t fn, char *arg, char *tok)
+{
+  char *err_msg = fn(arg);
+  if (err_msg) clierror(err_msg, tok);
 }
 
-static int cli_double_dash()
+CLI_FN void cli_check_async() {}
+#else
+CLI_VAR cli_deferred_t *cli_async CLI_INIT(NULL);
+CLI_VAR int cli_num_async CLI_INIT(0);
+CLI_VAR int cli_max_async CLI_INIT(0);
+
+#ifdef CLI_THREADS
+CLI_VAR pthread_mutex_t cli_async_lock CLI_INIT(PTHREAD_MUTEX_INITIALIZER);
+CLI_VAR pthread_cond_t  cli_async_cond CLI_INIT(PTHREAD_COND_INITIALIZER);
+CLI_VAR pthread_t cli_async_pool[CLI_NUM_THREADS];
+CLI_VAR int cli_async_threads CLI_INIT(0);
+CLI_VAR int cli_async_idle    CLI_INIT(0);
+CLI_VAR int cli_async_next    CLI_INIT(0);  // The next job to start
+CLI_VAR int cli_async_closed  CLI_INIT(0);  // No more jobs will be queued
+
+CLI_FN void *cli_async_worker(void *unused)
 {
-  if (cli_no_flags) return 0; // Already stopped checking for flags
-  char *arg = cliargv[clindx];
-  if (arg[0] != '-' || arg[1] != '-' || arg[2] != 0) return 0;
-  cli_no_flags = 1;
-  return 1; 
+  (void)unused;
+  pthread_mutex_lock(&cli_async_lock);
+  for (;;) {
+    while (cli_async_next >= cli_num_async && !cli_async_closed) {
+      cli_async_idle++;
+      pthread_cond_wait(&cli_async_cond, &cli_async_lock);
+      cli_async_idle--;
+    }
+    if (cli_async_next >= cli_num_async) break;
+    int k = cli_async_next++;
+    cli_deferred_t job = cli_async[k];
+    pthread_mutex_unlock(&cli_async_lock);
+    char *err = job.chk(job.arg);
+    pthread_mutex_lock(&cli_async_lock);
+    cli_async[k].err = err;  // The queue might have been moved by `realloc()`
+  }
+  pthread_mutex_unlock(&cli_async_lock);
+  return NULL;
 }
+#endif
 
-#define clioptions(...) vrg(cli_options_,__VA_ARGS__)
-#define cli_options_0()                         cli_options_3(NULL, argc, argv)
-#define cli_options_1(cli_header)               cli_options_3(cli_header, argc, argv)
-#define cli_options_2(cli_arg_cnt,cli_arg_vct)  cli_options_3(NULL, cli_arg_cnt, cli_arg_vct)
-#define cli_options_3(cli_header,cli_arg_cnt,cli_arg_vct)  \
-{ \
-  cliargc = cli_arg_cnt; \
-  cliargv = cli_arg_vct; \
-  if (cliprogname == NULL) cliprogname = cli_remove_slash(cliargv[0]);\
-  if (cli_header != NULL) cliheader = cli_header; \
-  clindx = 0; \
-  cli_num_options   = 0; \
-  cli_num_commands  = 0; \
-  cli_num_arguments = 0; \
-  cli_cmd_found     = 0; \
-  int cli_opt_found, cli_k; \
-  cli_loop:  \
-  for ( cliarg = cli_emptystr, cli_opt_found = 0; \
-       (clindx < cliargc) ; \
-       (clindx += cli_no_reparse()), cliarg = cli_emptystr, cli_opt_found = 0) \
-   if (cli_default_errors) cliusage(CLIEXIT); else \
-   if (cli_double_dash()) continue; else
+CLI_INLINE void cli_async_run(cli_chk_t fn, char *arg, char *tok)
+{
+#ifdef CLI_THREADS
+  pthread_mutex_lock(&cli_async_lock);
+#endif
+  if (cli_num_async >= cli_max_async) {
+    int max = cli_max_async ? cli_max_async * 2 : 16;
+    cli_deferred_t *a = realloc(cli_async, max * sizeof(cli_deferred_t));
+    if (a == NULL) { // Can't queue it, run it now
+#ifdef CLI_THREADS
+      pthread_mutex_unlock(&cli_async_lock);
+#endif
+      char *err_msg = fn(arg);
+      if (err_msg) clierror(err_msg, tok);
+      return;
+    }
+    cli_async = a;
+    cli_max_async = max;
+  }
+#ifdef CLI_THREADS
+  cli_async[cli_num_async++] = (cli_deferred_t){fn, arg, tok, NULL};
+  if (cli_async_idle > 0)
+    pthread_cond_signal(&cli_async_cond);
+  else if (cli_async_threads < CLI_NUM_THREADS &&
+           pthread_create(&cli_async_pool[cli_async_threads], NULL, cli_async_worker, NULL) == 0)
+    cli_async_threads++;
+  pthread_mutex_unlock(&cli_async_lock);
+#else
+  cli_async[cli_num_async++] = (cli_deferred_t){fn, arg, tok, fn(arg)};
+#endif
+}
 
-#define cli_new_opt VRG_join(cli_opt_,__LINE__)
+CLI_FN void cli_check_async()
+{
+  int errors = 0;
+  if (cli_num_async == 0) return;
+
+#ifdef CLI_THREADS
+  pthread_mutex_lock(&cli_async_lock);
+  cli_async_closed = 1;
+  pthread_cond_broadcast(&cli_async_cond);
+  pthread_mutex_unlock(&cli_async_lock);
+  for (int w = 0; w < cli_async_threads; w++) pthread_join(cli_async_pool[w], NULL);
+
+  // If no thread could be started, the jobs are run here.
+  for (; cli_async_next < cli_num_async; cli_async_next++)
+    cli_async[cli_async_next].err = cli_async[cli_async_next].chk(cli_async[cli_async_next].arg);
+  cli_async_threads = cli_async_next = cli_async_closed = 0;
+#endif
 
-#define cliopt(...) vrg(cli_opt_,__VA_ARGS__)
-#define cli_opt_1(cli_def) cli_opt_2(cli_def, cli_chk_true)
-#define cli_opt_2(cli_def, cli_chk) \
-    static cli_option_t cli_new_opt; \
-    if (cli_opt_found) continue; \
-    else if (!( (clindx == 0 && cli_opt_define(cli_def, &cli_new_opt, cli_chk)) \
-              ||(clindx >  0 && (cli_opt_found = cli_check(&cli_new_opt, cli_chk)) > 0))); \
-         else
+  for (int k = 0; k < cli_num_async; k++) {
+    if (cli_async[k].err) {
+      cliwarning(cli_async[k].err, cli_async[k].tok);
+      errors++;
+    }
+  }
+  free(cli_async);
+  cli_async = NULL;
+  cli_num_async = cli_max_async = 0;
+  if (errors > 0) CLI_EXIT(1);
+}
+#endif // CLI_FREESTANDING
+
+// ## Constraint groups
+// Relations among options are declared in the `clioptions()` block (before the final
+// `cliopt()`) by listing their names as they appear in the specs (e.g. "-L", "--all",
+// "file" for a positional argument, "add" for a command):
+//
+//     cliexclusive("-L", "-P");       // at most one of them
+//     clirequires("-h", "-l");        // if "-h" is used, "-l" must be used too
+//     cliatleastone("-a", "file");    // at least one of them
+//
+// Each option gets an index when it's defined and the options found are marked in
+// a bitset. At the end of the scan, each group is checked with a few operations on
+// its own bitset: no pairwise comparisons and no flags to reset by hand. All the
+// violations are reported, then the program exits.
+
+#ifndef CLI_MAX_BITS
+#define CLI_MAX_BITS 256
+#endif
 
-#define cli_opt_0()  \
-    if (clindx == 0) continue; \
-    if (cli_opt_found <= 0) break;\
-  } \
-  goto cli_last; cli_last: \
+#define CLI_BITS_WORDS ((CLI_MAX_BITS + 31) / 32)
+
+#define CLI_GRP_EXCLUSIVE  1
+#define CLI_GRP_REQUIRES   2
+#define CLI_GRP_ATLEASTONE 3
+
+typedef struct cli_group_s {
+  struct cli_group_s *next;
+  char             **names;
+  unsigned short     num_names;
+  unsigned short     type;
+  unsigned int       mask[CLI_BITS_WORDS];  // Options in the group (the first one excluded for `clirequires()`)
+  unsigned short     first;                 // Bit of the first option
+} cli_group_t;
+
+CLI_VAR unsigned int cli_found_bits[CLI_BITS_WORDS];
+
+CLI_VAR cli_group_t *cli_groups CLI_INIT(NULL);
+CLI_VAR cli_group_t *cli_groups_tail CLI_INIT((cli_group_t *)&cli_groups);
+
+#define cli_bit_set(b_)  ((b_) < CLI_MAX_BITS ? (cli_found_bits[(b_) / 32] |= 1u << ((b_) % 32)) : 0)
+#define cli_bit_get(b_)  ((b_) < CLI_MAX_BITS && (cli_found_bits[(b_) / 32] & (1u << ((b_) % 32))))
+
+#define cliexclusive(...)  cli_group(CLI_GRP_EXCLUSIVE, __VA_ARGS__)
+#define clirequires(...)   cli_group(CLI_GRP_REQUIRES, __VA_ARGS__)
+#define cliatleastone(...) cli_group(CLI_GRP_ATLEASTONE, __VA_ARGS__)
+
+#define cli_group(t_, ...) \
+    static char *cli_join(cli_new_opt,_names)[] = {__VA_ARGS__}; \
+    static cli_group_t cli_new_opt; \
+    if (clindx == 0) cli_group_define(&cli_new_opt, t_, cli_join(cli_new_opt,_names), \
+                                      sizeof(cli_join(cli_new_opt,_names))/sizeof(char *))
+
+CLI_INLINE void cli_group_define(cli_group_t *grp, int type, char **names, int num_names)
+{
+  *grp = (cli_group_t){0};
+  grp->names = names;
+  grp->num_names = (unsigned short)num_names;
+  grp->type = (unsigned short)type;
+  cli_groups_tail->next = grp;
+  cli_groups_tail = grp;
+}
+
+CLI_FN cli_option_t *cli_opt_by_name(char *name)
+{
+  int len = (int)strlen(name);
+  for (cli_option_t *opt = cli_head; opt != NULL; opt = opt->next) {
+    if ((opt->flags & CLI_OPT_FLAG_SHORT) && strcmp(name, cli_short_offset(opt)) == 0)
+      return opt;
+    if (opt->optname_len == len && strncmp(name, opt->def + opt->optname_offset, len) == 0)
+      return opt;
+  }
+  return NULL;
+}
+
+// Options are known only after the whole `clioptions()` block has been scanned once.
+CLI_FN void cli_group_resolve(cli_group_t *grp)
+{
+  for (int k = 0; k < grp->num_names; k++) {
+    cli_option_t *opt = cli_opt_by_name(grp->names[k]);
+    if (opt == NULL || opt->bit >= CLI_MAX_BITS) clierror("Unknown option in group", grp->names[k]);
+    if (k == 0) grp->first = opt->bit;
+    if (k > 0 || grp->type != CLI_GRP_REQUIRES)
+      grp->mask[opt->bit / 32] |= 1u << (opt->bit % 32);
+  }
+}
+
+CLI_FN void cli_group_names(cli_group_t *grp, int k, int found)
+{
+  char *sep = "";
+  for (; k < grp->num_names; k++) {
+    cli_option_t *opt = cli_opt_by_name(grp->names[k]);
+    if (found >= 0 && cli_bit_get(opt->bit) != found) continue;
+    cli_puts(sep); cli_puts("'"); cli_puts(grp->names[k]); cli_puts("'");
+    sep = ", ";
+  }
+}
+
+CLI_FN void cli_check_groups()
+{
+  int errors = 0;
+
+  for (cli_group_t *grp = cli_groups; grp != NULL; grp = grp->next) {
+    int n = 0, all = 1;
+    cli_group_resolve(grp);
+    for (int w = 0; w < CLI_BITS_WORDS; w++) {
+      unsigned int x = cli_found_bits[w] & grp->mask[w];
+      all &= (x == grp->mask[w]);
+      for (; x && n < 2; x &= x - 1) n++;
+    }
+
+    if (  (grp->type == CLI_GRP_EXCLUSIVE  && n < 2)
+        ||(grp->type == CLI_GRP_ATLEASTONE && n > 0)
+        ||(grp->type == CLI_GRP_REQUIRES   && (all || !cli_bit_get(grp->first))))
+      continue;
+
+    errors++;
+    cli_puts(cliprogname);
+    cli_puts(": " CLI_STR_ERROR ": ");
+    switch (grp->type) {
+      case CLI_GRP_EXCLUSIVE:
+        cli_group_names(grp, 0, 1);
+        cli_puts(" " CLI_STR_EXCLUSIVE);
+        break;
+      case CLI_GRP_REQUIRES:
+        cli_puts("'"); cli_puts(grp->names[0]); cli_puts("' " CLI_STR_REQUIRES " ");
+        cli_group_names(grp, 1, 0);
+        break;
+      case CLI_GRP_ATLEASTONE:
+        cli_puts(CLI_STR_ATLEASTONE " ");
+        cli_group_names(grp, 0, -1);
+        break;
+    }
+    cli_puts("\n\n");
+  }
+  cli_flush();
+  if (errors > 0) CLI_EXIT(1);
+}
+
+CLI_FN int cli_check(cli_option_t *opt, cli_chk_t cli_chk_fn)
+{
+  char *arg = cliargv[clindx];
+  cli_meta_t *m = cli_meta(clindx);
+  opt->flags &= ~CLI_OPT_ARG_ERROR;
+  if (!cli_check_short(opt,arg,m) &&
+      !cli_check_long(opt,arg,m)  &&
+      !cli_check_arg(opt,arg,m)   )     
+    return 0;
+
+  cli_bit_set(opt->bit);
+  cli__trace("arg: %s",arg);
+  char *val, *err_msg = NULL;
+  if (cli_chk_fn != cli_chk_true) {
+    if ((val = cli_chk_value(opt, cliarg)) == NULL) err_msg = CLI_STR_ERR_FILE;
+    else if (opt->flags & CLI_OPT_DEFER) cli_defer(cli_chk_fn, val, arg);
+    else err_msg = cli_chk_fn(val);
+  }
+  if (err_msg != NULL) {
+    cli__trace("EE: %s",err_msg);
+    clierror(err_msg, arg);
+    opt->flags |= CLI_OPT_ARG_ERROR;
+  }
+  cli_snap_rec(opt->bit, CLI_SRC_ARG);
+  return 1;
+}
+
+// ## Suggestions for unknown options
+// `clisuggest(arg, names, max)` looks for the long options and the commands whose
+// names are within a small edit distance from `arg` (ignoring any "=value"). It
+// stores up to `max` of them in `names` (as NUL-terminated strings), closest first
+// and then in order of definition, and returns how many it found.
+//
+// In the final `cliopt()`, `cliunknown()` reports the current argument as unknown,
+// with the suggestions (if any), and exits:
+//
+//     cliopt() { if (cliarg[0] == '-') cliunknown(); }
+//
+//     mytool: ERROR: Unknown option '--vrebose' (did you mean '--verbose'?)
+//
+// The distance is the Levenshtein distance (insertions, deletions and changes of a
+// character) up to `CLI_SUGGEST_DIST`, and never more than half the length of the
+// argument (without its leading dashes). Names are stored in a BK-tree, built the
+// first time it's needed, so that only a small part of them is compared with the
+// argument. Each comparison takes a few operations per character with the bit-parallel
+// algorithm by Myers (arguments are compared up to their first 64 characters).
+
+#ifndef CLI_SUGGEST_DIST
+#define CLI_SUGGEST_DIST 2
+#endif
+
+#ifndef CLI_SUGGEST_MAX
+#define CLI_SUGGEST_MAX 64   // Nodes in the static buffer (more are allocated if needed)
+#endif
+
+#ifndef CLI_SUGGEST_NUM
+#define CLI_SUGGEST_NUM 3    // Suggestions in the message of `cliunknown()`
+#endif
+
+typedef struct {
+  char           name[32];   // Names are at most 30 chars (see `cli_opt_define()`)
+  unsigned char  len;
+  unsigned char  dist;       // Distance from the parent
+  int            child;      // First child (0 for none: the root is nobody's child)
+  int            next;       // Next sibling
+} cli_bk_node_t;
+
+CLI_VAR cli_bk_node_t  cli_bk_buf[CLI_SUGGEST_MAX];
+CLI_VAR cli_bk_node_t *cli_bk CLI_INIT(cli_bk_buf);
+CLI_VAR int cli_bk_num CLI_INIT(0);
+CLI_VAR int cli_bk_max CLI_INIT(CLI_SUGGEST_MAX);
+
+CLI_VAR cli_option_t  *cli_bk_tail CLI_INIT(NULL);  // The tree is rebuilt if the options change
+CLI_VAR unsigned short cli_bk_bits CLI_INIT(0);
+
+CLI_VAR unsigned long long cli_bk_peq[256];  // Positions of each char in the pattern
+
+CLI_FN void cli_bk_pattern(const char *p, int m, int set)
+{
+  for (int k = 0; k < m; k++) {
+    if (set) cli_bk_peq[(unsigned char)p[k]] |= 1ULL << k;
+    else     cli_bk_peq[(unsigned char)p[k]] = 0;
+  }
+}
+
+// Levenshtein distance between the pattern (`m` chars, set in `cli_bk_peq`) and `t`
+CLI_FN int cli_bk_dist(int m, const char *t, int n)
+{
+  unsigned long long pv = ~0ULL, mv = 0, last = 1ULL << (m - 1);
+  int d = m;
+  if (m == 0) return n;
+  for (int j = 0; j < n; j++) {
+    unsigned long long eq = cli_bk_peq[(unsigned char)t[j]];
+    unsigned long long xv = eq | mv;
+    unsigned long long xh = (((eq & pv) + pv) ^ pv) | eq;
+    unsigned long long ph = mv | ~(xh | pv);
+    unsigned long long mh = pv & xh;
+    if (ph & last) d++;
+    else if (mh & last) d--;
+    ph = (ph << 1) | 1;
+    mh <<= 1;
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+  }
+  return d;
+}
+
+CLI_FN void cli_bk_add(const char *name, int len)
+{
+  int k = 0, c, d;
+  if (cli_bk_num >= cli_bk_max) {
+#ifndef CLI_FREESTANDING
+    int max = cli_bk_max * 2;
+    cli_bk_node_t *b = realloc(cli_bk == cli_bk_buf ? NULL : cli_bk, max * sizeof(cli_bk_node_t));
+    if (b == NULL) return;
+    if (cli_bk == cli_bk_buf) memcpy(b, cli_bk_buf, sizeof(cli_bk_buf));
+    cli_bk = b;
+    cli_bk_max = max;
+#else
+    return;
+#endif
+  }
+  cli_bk_node_t *node = &cli_bk[cli_bk_num];
+  memcpy(node->name, name, len);
+  node->name[len] = '\0';
+  node->len = (unsigned char)len;
+  node->dist = 0;
+  node->child = node->next = 0;
+  if (cli_bk_num++ == 0) return;
+
+  cli_bk_pattern(name, len, 1);
+  for (;;) {
+    d = cli_bk_dist(len, cli_bk[k].name, cli_bk[k].len);
+    if (d == 0) { cli_bk_num--; break; }  // Already there
+    for (c = cli_bk[k].child; c != 0 && cli_bk[c].dist != d; c = cli_bk[c].next) ;
+    if (c == 0) {
+      node->dist = (unsigned char)d;
+      node->next = cli_bk[k].child;
+      cli_bk[k].child = cli_bk_num - 1;
+      break;
+    }
+    k = c;
+  }
+  cli_bk_pattern(name, len, 0);
+}
+
+CLI_FN void cli_bk_build()
+{
+  if (cli_bk_tail == cli_tail && cli_bk_bits == cli_num_bits) return;
+  cli_bk_num = 0;
+  for (cli_option_t *opt = cli_head; opt != NULL; opt = opt->next) {
+    if (opt->flags & (CLI_OPT_FLAG_LONG | CLI_OPT_COMMAND))
+      cli_bk_add(opt->def + opt->optname_offset, opt->optname_len);
+  }
+  cli_bk_tail = cli_tail;
+  cli_bk_bits = cli_num_bits;
+}
+
+// Adds the names at distance `r` from the pattern to the `*n` found so far (the first
+// `from` of them are closer and are kept in place)
+CLI_FN void cli_bk_find(int k, int m, int r, char **names, int max, int from, int *n)
+{
+  int d = cli_bk_dist(m, cli_bk[k].name, cli_bk[k].len);
+  if (d == r) {
+    char *name = cli_bk[k].name;
+    int j = *n < max ? (*n)++ : max;
+    // Nodes are in order of definition: so are their names in memory
+    for (; j > from && names[j - 1] > name; j--)
+      if (j < max) names[j] = names[j - 1];
+    if (j < max) names[j] = name;
+  }
+  for (int c = cli_bk[k].child; c != 0; c = cli_bk[c].next) {
+    if (cli_bk[c].dist >= d - r && cli_bk[c].dist <= d + r)
+      cli_bk_find(c, m, r, names, max, from, n);
+  }
+}
+
+CLI_INLINE int clisuggest(const char *arg, char **names, int max)
+{
+  int m, r, n = 0;
+  if (arg == NULL || max <= 0) return 0;
+  m = cli_find_eq(arg, (int)strlen(arg));
+  if (m > 64) m = 64;
+  for (r = 0; r < m && arg[r] == '-'; r++) ;
+  r = (m - r) / 2;
+  if (r > CLI_SUGGEST_DIST) r = CLI_SUGGEST_DIST;
+
+  cli_bk_build();
+  if (cli_bk_num == 0) return 0;
+  cli_bk_pattern(arg, m, 1);
+  for (int d = 0; d <= r && n < max; d++)
+    cli_bk_find(0, m, d, names, max, n, &n);
+  cli_bk_pattern(arg, m, 0);
+  return n;
+}
+
+#define cliunknown() cli_unknown(cliarg)
+
+CLI_INLINE void cli_unknown(char *arg)
+{
+  char *names[CLI_SUGGEST_NUM];
+  int n = clisuggest(arg, names, CLI_SUGGEST_NUM);
+  cli_puts(cliprogname);
+  cli_puts(": " CLI_STR_ERROR ": " CLI_STR_UNKNOWN " '");
+  cli_puts(arg);
+  cli_puts("'");
+  for (int k = 0; k < n; k++) {
+    cli_puts(k == 0 ? " (" CLI_STR_SUGGEST " '" : ", '");
+    cli_puts(names[k]);
+    cli_puts(k == n - 1 ? "'?)" : "'");
+  }
+  cli_puts("\n\n");
+  cli_flush();
+  CLI_EXIT(1);
+}
+
+// ## Command families
+// A program with many commands, each with its own many options, doesn't need to
+// define and check all of them at each invocation. Each command can have its own
+// `clioptions()` block in a function with the same signature as `main()`:
+//
+//     int build_cli(int argc, char **argv) {
+//       clioptions("Build the project", argc, argv) { ...the options of build... }
+//       ...
+//     }
+//
+//     clioptions("mytool", argc, argv) {
+//       cliopt("-v\tVerbose") { ... }
+//       cliopt("<build>\tBuild the project") { clicommand(build_cli); }
+//       cliopt("<test>\tRun the tests")      { clicommand(test_cli); }
+//       cliopt();
+//     }
+//
+// When the command is matched, the scan ends and, after the usual checks, the function
+// is called with the arguments from the command on (`argv[0]` is the command). Only the
+// options of the selected command are defined and checked. Its return value is stored
+// in `clicmdrc` (-1 if no command function has been called). Messages of the command
+// mention it after the program name (e.g. "mytool build: ERROR: ...").
+//
+// With `CLI_DLOPEN` defined, `cliplugin(library, symbol)` loads the function from a
+// shared library only when the command is matched, so the code of the other commands
+// is not even loaded. If the library includes `cli.h` itself, it has its own copy of
+// the parser state and messages will use the command as program name.
+
+typedef int (*cli_main_t)(int argc, char **argv);
+
+CLI_VAR cli_main_t cli_family CLI_INIT(NULL);
+CLI_VAR int cli_family_ndx CLI_INIT(0);
+CLI_VAR int clicmdrc CLI_INIT(-1);
+
+#define clicommand(fn) if (!cli_family_set(fn)); else cliexit()
+
+CLI_INLINE int cli_family_set(cli_main_t fn)
+{
+  cli_family = fn;
+  cli_family_ndx = clindx;
+  return 1;
+}
+
+#ifdef CLI_DLOPEN
+#include <dlfcn.h>
+
+#define cliplugin(lib, sym) if (!cli_family_set(cli_family_load(lib, sym))); else cliexit()
+
+CLI_INLINE cli_main_t cli_family_load(const char *lib, const char *sym)
+{
+  cli_main_t fn;
+  void *handle = dlopen(lib, RTLD_NOW | RTLD_LOCAL);
+  if (handle == NULL) clierror("Can't load", (char *)lib);
+  *(void **)(&fn) = dlsym(handle, sym);  // As recommended by POSIX for functions
+  if (fn == NULL) clierror("Can't find", (char *)sym);
+  return fn;
+}
+#endif
+
+// "prog" -> "prog cmd" (or "prog cmd subcmd" for nested commands)
+CLI_VAR char cli_family_prog[80];
+
+CLI_FN void cli_family_name(char *cmd)
+{
+  char *name = cli_family_prog;
+  int n = 0;
+  if (cliprogname != name) {
+    for (n = 0; cliprogname[n] && n < (int)sizeof(cli_family_prog) - 1; n++) name[n] = cliprogname[n];
+    name[n] = '\0';
+  }
+  else n = (int)strlen(name);
+  if (n < (int)sizeof(cli_family_prog) - 2) {
+    name[n++] = ' ';
+    while (*cmd && n < (int)sizeof(cli_family_prog) - 1) name[n++] = *cmd++;
+    name[n] = '\0';
+  }
+  cliprogname = name;
+}
+
+CLI_FN void cli_run_family()
+{
+  cli_main_t fn = cli_family;
+  char **argv = cliargv;
+  int argc = cliargc, ndx = clindx;
+  cli_option_t *head = cli_head, *tail = cli_tail;
+
+  cli_family = NULL;
+  cli_family_name(cliargv[cli_family_ndx]);
+
+  // The block of the command only sees its own options (for the usage, the constraint
+  // groups, the suggestions and the final checks)
+  cli_head = NULL;
+  cli_tail = (cli_option_t *)&cli_head;
+  clicmdrc = fn(argc - cli_family_ndx, argv + cli_family_ndx);
+
+  // The code after the block sees the arguments and the options of the block
+  cliargv = argv; cliargc = argc; clindx = ndx;
+  cli_head = head; cli_tail = tail;
+}
+
+// ## Multi-call programs
+// One executable can hold many tools (applets) and run the one named by the name it has
+// been invoked with, as BusyBox does: it's installed once and linked under the name of
+// each applet. Each applet is a function with the same signature as `main()` and its
+// own `clioptions()` block:
+//
+//     static cli_applet_t applets[] = {
+//       {"ls", ls_main},
+//       {"cp", cp_main},
+//       ...
+//     };
+//
+//     int main(int argc, char **argv) { return cliapplet(argc, argv, applets); }
+//
+// The applet is the one with the name of the executable (without the directory and a
+// final ".exe") or, if there is none, the one named by the first argument (`mytool ls -l`),
+// as for a command. Only the options of that applet are defined and checked, and
+// `cliapplet()` returns what it returns. An unknown applet is an error.
+//
+// The names are hashed in an index the first time; the following calls with the same
+// table only hash the name that was invoked. `cliapplet(argc, argv, table, n)` takes a
+// pointer to the table rather than an array.
+
+#ifndef CLI_APPLET_SLOTS
+#define CLI_APPLET_SLOTS 256  // Size of the index (a power of 2). Larger tables are scanned.
+#endif
+
+typedef struct {
+  char       *name;
+  cli_main_t  fn;
+} cli_applet_t;
+
+typedef struct {
+  unsigned int   hash;
+  unsigned short ndx;   // Index in the table + 1 (0 for an empty slot)
+} cli_applet_slot_t;
+
+CLI_VAR cli_applet_slot_t cli_applet_idx[CLI_APPLET_SLOTS];
+
+CLI_VAR cli_applet_t *cli_applet_tbl CLI_INIT(NULL);   // The table in the index
+CLI_VAR int cli_applet_num CLI_INIT(0);
+
+CLI_INLINE int cli_applet_is(cli_applet_t *a, char *name, int len)
+{
+  return strncmp(a->name, name, len) == 0 && a->name[len] == '\0';
+}
+
+CLI_INLINE int cli_applet_find(cli_applet_t *tbl, int n, char *name, int len)
+{
+  unsigned int h, s;
+  int k;
+
+  if (n > CLI_APPLET_SLOTS / 2) {
+    for (k = 0; k < n; k++) if (cli_applet_is(tbl + k, name, len)) return k;
+    return -1;
+  }
+  if (tbl != cli_applet_tbl || n != cli_applet_num) {
+    memset(cli_applet_idx, 0, sizeof(cli_applet_idx));
+    for (k = 0; k < n; k++) {
+      h = cli_hash(tbl[k].name, (int)strlen(tbl[k].name));
+      for (s = h & (CLI_APPLET_SLOTS - 1); cli_applet_idx[s].ndx != 0; s = (s + 1) & (CLI_APPLET_SLOTS - 1)) ;
+      cli_applet_idx[s].hash = h;
+      cli_applet_idx[s].ndx  = (unsigned short)(k + 1);
+    }
+    cli_applet_tbl = tbl;
+    cli_applet_num = n;
+  }
+  h = cli_hash(name, len);
+  for (s = h & (CLI_APPLET_SLOTS - 1); cli_applet_idx[s].ndx != 0; s = (s + 1) & (CLI_APPLET_SLOTS - 1)) {
+    k = cli_applet_idx[s].ndx - 1;
+    if (cli_applet_idx[s].hash == h && cli_applet_is(tbl + k, name, len)) return k;
+  }
+  return -1;
+}
+
+#define cliapplet(...) vrg(cli_applet_, __VA_ARGS__)
+#define cli_applet_3(argc_, argv_, tbl_)     cli_applet_run(argc_, argv_, tbl_, (int)(sizeof(tbl_) / sizeof((tbl_)[0])))
+#define cli_applet_4(argc_, argv_, tbl_, n_) cli_applet_run(argc_, argv_, tbl_, (int)(n_))
+
+CLI_INLINE int cli_applet_run(int argc, char **argv, cli_applet_t *tbl, int n)
+{
+  char *name = cli_remove_slash(argv[0]);
+  int len = (int)strlen(name);
+  int k;
+
+  if (len > 4 && (strcmp(name + len - 4, ".exe") == 0 || strcmp(name + len - 4, ".EXE") == 0)) len -= 4;
+  if ((k = cli_applet_find(tbl, n, name, len)) < 0) {
+    cliprogname = name;
+    if (argc < 2 || (k = cli_applet_find(tbl, n, argv[1], (int)strlen(argv[1]))) < 0) {
+      clierror(CLI_STR_APPLET, argc < 2 ? name : argv[1]);
+      return 1;
+    }
+    cli_family_name(argv[1]);
+    argc--; argv++;
+  }
+  return tbl[k].fn(argc, argv);
+}
+
+CLI_FN int cli_last_check()
+{
+  if (cli_replay) return cli_snap_last();
+  cli_check_deferred();
+  cli_check_async();
+  for (cli_option_t *opt = cli_head; opt != NULL; opt = opt->next) {
+    if (opt->flags & (CLI_OPT_FLAG_LONG | CLI_OPT_FLAG_SHORT | CLI_OPT_COMMAND))
+      continue;
+
+    if (!(opt->flags & CLI_OPT_FOUND) && !(opt->flags & CLI_OPT_OPTIONAL)) {
+      clierror(clierrormsg,opt->def+opt->optname_offset, opt->optname_len);
+      opt->flags |= CLI_OPT_ARG_ERROR;
+    }
+  }
+  if (cli_groups != NULL) cli_check_groups();
+  if (cli_family != NULL) cli_run_family();
+  return 1;
+}
+
+CLI_INLINE int cli_double_dash()
+{
+  if (cli_no_flags) return 0; // Already stopped checking for flags
+  if (cli_meta(clindx)->kind != CLI_TOK_DASHDASH) return 0;
+  cli_no_flags = 1;
+  return 1; 
+}
+
+#define clioptions(...) vrg(cli_options_,__VA_ARGS__)
+#define cli_options_0()                         cli_options_3(NULL, argc, argv)
+#define cli_options_1(cli_header)               cli_options_3(cli_header, argc, argv)
+#define cli_options_2(cli_arg_cnt,cli_arg_vct)  cli_options_3(NULL, cli_arg_cnt, cli_arg_vct)
+#define cli_options_3(cli_header,cli_arg_cnt,cli_arg_vct)  \
+{ \
+  cliargc = cli_arg_cnt; \
+  cliargv = cli_arg_vct; \
+  if (!cli_snap_begin()) cli_classify_all(); \
+  if (cliprogname == NULL) cliprogname = cli_remove_slash(cliargv[0]);\
+  if (cli_header != NULL) cliheader = cli_header; \
+  clindx = 0; \
+  cli_no_flags      = 0; \
+  cli_num_options   = 0; \
+  cli_num_commands  = 0; \
+  cli_num_arguments = 0; \
+  cli_cmd_found     = 0; \
+  cli_num_bits      = 0; \
+  memset(cli_found_bits, 0, sizeof(cli_found_bits)); \
+  cli_head   = NULL; cli_tail        = (cli_option_t *)&cli_head; \
+  cli_groups = NULL; cli_groups_tail = (cli_group_t *)&cli_groups; \
+  int cli_opt_found, cli_k; \
+  cli_loop:  \
+  for ( cliarg = cli_emptystr, cli_opt_found = 0; \
+       cli_more() ; \
+       (clindx += cli_no_reparse()), cliarg = cli_emptystr, cli_opt_found = 0) \
+   if (cli_default_errors) cliusage(CLIEXIT); else \
+   if (cli_double_dash()) continue; else
+
+#define cli_new_opt VRG_join(cli_opt_,__LINE__)
+
+#define cliopt(...) vrg(cli_opt_,__VA_ARGS__)
+#define cli_opt_1(cli_def) cli_opt_3(cli_def, cli_chk_true, 0)
+#define cli_opt_2(cli_def, cli_chk) cli_opt_3(cli_def, cli_chk, 0)
+#define cli_opt_3(cli_def, cli_chk, cli_mode) \
+    static cli_option_t cli_new_opt; \
+    if (cli_opt_found) continue; \
+    else if (!( (clindx == 0 && cli_opt_define(cli_def, &cli_new_opt, cli_chk, cli_mode)) \
+              ||(clindx >  0 && (cli_opt_found = cli_replay ? cli_snap_check(&cli_new_opt) \
+                                                            : cli_check(&cli_new_opt, cli_chk)) > 0))); \
+         else
+
+#define cli_opt_0()  \
+    if (clindx == 0) continue; \
+    if (cli_opt_found <= 0) break;\
+  } \
+  goto cli_last; cli_last: \
   if (clindx >= cliargc || cli_opt_found < 0) cli_last_check(); \
-  else for (cliarg = cliargv[clindx], cli_k = 1; cli_k; cli_k++) \
+  else for (cliarg = cliargv[clindx], cli_k = 1, cli_snap_rec(CLI_SNAP_REST, CLI_SRC_ARG); cli_k; cli_k++) \
          if (cli_k == 2) {clindx++; goto cli_loop;} \
          else
 
 #define cliexit() if (!(cli_opt_found = -1)); else goto cli_last
 
+// ## Iterating over the options
+// A `clioptions()` block runs its handlers for each argument and keeps the control
+// until the arguments are over (or `cliexit()`). Event loops and coroutines need to
+// pull the options one at a time instead, and to stop and resume at any point:
+//
+//     static cli_optdef_t opts[] = {
+//       {"-v, --verbose\tMore output"},
+//       {"-o, --output file (out.txt)\tThe output file", is_writable},
+//       {"input\tThe input file"},
+//       {NULL}
+//     };
+//
+//     cli_iter_t it;
+//     cli_event_t *ev;
+//     cliiter(&it, opts, argc, argv);
+//     while ((ev = clinext(&it)) != NULL) {
+//       if (ev->err) clierror(ev->err, ev->arg, ev->len);
+//       switch (ev->opt) {
+//         case 0: verbose++; break;
+//         case 1: output = ev->val; break;
+//         case 2: input = ev->val; break;
+//         default: cliunknown();    // Not an option (`ev->opt` is -1)
+//       }
+//     }
+//
+// The definitions and their matching are the ones of `cliopt()`. Each event is an
+// option found (`opt`, its index in the table), its value (`val`, "" if none), the
+// index of the argument (`ndx`, 0 for the defaults) and the error (`err`, NULL if
+// none). The defaults come first, in the order of the table, then the arguments and,
+// at the end, an error for each required positional argument that is missing.
+// `cliarg` and `clindx` are set as in a handler, `val` lasts until the next call.
+//
+// Nothing is reported or checked beyond that: errors are left to the caller, and
+// groups, deferred checks and asynchronous handlers only apply to `clioptions()`.
+//
+// `cliiter()` indexes the names of the options: `clinext()` finds each of them with a
+// lookup, rather than by comparing the argument with each definition in turn, and
+// never allocates memory. It returns the number of options.
+//
+// The index has `CLI_ITER_SLOTS` slots and holds up to `CLI_ITER_SLOTS / 2` long options
+// and commands. With more than that, `clinext()` compares the argument with each
+// definition in turn (still without allocating): define `CLI_ITER_SLOTS` as a larger
+// power of 2 before including `cli.h` to keep the lookup for larger tables.
+
+#ifndef CLI_ITER_SLOTS
+#define CLI_ITER_SLOTS 256   // Slots of the index of the names (a power of 2)
+#endif
+
+typedef struct {
+  char         *def;
+  cli_chk_t     chk;      // The validator (NULL if none)
+  cli_option_t  opt;      // Set by `cliiter()`
+} cli_optdef_t;
+
+typedef struct {
+  int   opt;    // Index of the option in the table, -1 if the argument is not an option
+  int   ndx;    // Index of the argument in `argv` (0 for defaults and missing arguments)
+  char *val;    // The value of the option, or the argument that is not an option
+  char *err;    // The error message, NULL if there is no error
+  char *arg;    // What the error refers to (the argument or the name of the option)...
+  int   len;    // ... and its length (-1 for all of it)
+} cli_event_t;
+
+typedef struct {
+  cli_optdef_t  *defs;
+  char         **argv;
+  int            argc;
+  int            ndx;       // The current argument
+  int            sub;       // The current short option in `-abc` (1 if not in a group)
+  int            def;       // The next definition (for defaults and missing arguments)
+  int            pos;       // The next positional argument
+  unsigned char  phase;     // Defaults, arguments, missing arguments, done
+  unsigned char  no_flags;  // After `--`
+  unsigned char  cmd_found;
+  unsigned char  no_index;  // Too many names for `names[]`: linear scan
+  short          shorts[128];            // Index + 1 of the option `-c` (0 if none)
+  short          names[CLI_ITER_SLOTS];  // Index + 1 of the options, by hash of the name
+  cli_event_t    ev;
+} cli_iter_t;
+
+CLI_INLINE int cliiter(cli_iter_t *it, cli_optdef_t *defs, int argc, char **argv)
+{
+  int k, num_names = 0;
+  memset(it, 0, sizeof(*it));
+  it->defs = defs;
+  it->argv = argv;
+  it->argc = argc;
+  it->ndx  = 1;
+  it->sub  = 1;
+  if (cliprogname == NULL && argc > 0) cliprogname = cli_remove_slash(argv[0]);
+
+  for (k = 0; defs[k].def != NULL; k++) {
+    cli_option_t *opt = &defs[k].opt;
+    cli_opt_names(opt, defs[k].def, 0);
+    opt->bit = (unsigned short)k;
+    if (opt->flags & CLI_OPT_FLAG_SHORT) it->shorts[opt->optname_short & 0x7F] = (short)(k + 1);
+    if (opt->flags & (CLI_OPT_FLAG_LONG | CLI_OPT_COMMAND)) {
+      unsigned int h = opt->hash;
+      if (++num_names > CLI_ITER_SLOTS / 2) {it->no_index = 1; continue;}
+      while (it->names[h & (CLI_ITER_SLOTS - 1)] != 0) h++;
+      it->names[h & (CLI_ITER_SLOTS - 1)] = (short)(k + 1);
+    }
+  }
+  return k;
+}
+
+CLI_INLINE int cli_iter_is(cli_option_t *opt, char *arg, cli_meta_t *m, int flags)
+{
+  return (opt->flags & flags) && opt->hash == m->hash && opt->optname_len == m->len &&
+         memcmp(arg, opt->def + opt->optname_offset, m->len) == 0;
+}
+
+// The option named as the first `m->len` chars of `arg`, -1 if there's none
+CLI_INLINE int cli_iter_find(cli_iter_t *it, char *arg, cli_meta_t *m, int flags)
+{
+  unsigned int h = m->hash;
+  int k;
+  if (it->no_index) {
+    for (k = 0; it->defs[k].def != NULL; k++)
+      if (cli_iter_is(&it->defs[k].opt, arg, m, flags)) return k;
+    return -1;
+  }
+  for (; (k = it->names[h & (CLI_ITER_SLOTS - 1)]) != 0; h++)
+    if (cli_iter_is(&it->defs[k - 1].opt, arg, m, flags)) return k - 1;
+  return -1;
+}
+
+// The value of the option found in `arg`: after the '=' or the next argument
+CLI_INLINE void cli_iter_value(cli_iter_t *it, char *arg, cli_meta_t *m)
+{
+  char *next;
+  if (m->eq) {it->ev.val = arg + m->len + 1; return;}
+  if (it->ndx + 1 < it->argc && ((next = it->argv[it->ndx + 1])[0] != '-' || next[1] == '\0'))
+    it->ev.val = it->argv[++it->ndx];
+}
+
+CLI_FN cli_event_t *cli_iter_found(cli_iter_t *it, int k)
+{
+  cli_event_t  *ev  = &it->ev;
+  cli_optdef_t *def = &it->defs[k];
+  char *val;
+  ev->opt = k;
+  if (it->phase == 1 && ev->val == cli_emptystr &&
+      (def->opt.flags & (CLI_OPT_ARGUMENT | CLI_OPT_OPTIONAL)) == CLI_OPT_ARGUMENT)
+    ev->err = clierrormsg;
+  else if (def->chk != NULL)
+    ev->err = (val = cli_chk_value(&def->opt, ev->val)) ? def->chk(val) : CLI_STR_ERR_FILE;
+  cliarg = ev->val;
+  clindx = ev->ndx;
+  return ev;
+}
+
+CLI_INLINE cli_event_t *clinext(cli_iter_t *it)
+{
+  cli_event_t  *ev = &it->ev;
+  cli_option_t *opt, tmp;
+  cli_meta_t    m;
+  char         *arg;
+  int           k;
+
+  *ev = (cli_event_t){-1, 0, cli_emptystr, NULL, NULL, -1};
+
+  for (; it->phase == 0; it->def++) {           // Defaults
+    if (it->defs[it->def].def == NULL) {it->phase = 1; break;}
+    arg = cli_opt_names(&tmp, it->defs[it->def].def, 0);
+    if (!cli_default_value(&arg)) continue;
+    ev->val = cliarg;
+    ev->arg = cli_opt_name(&it->defs[it->def].opt, &ev->len);
+    return cli_iter_found(it, it->def++);
+  }
+
+  if (it->phase == 1 && it->ndx < it->argc) {   // Arguments
+    ev->ndx = it->ndx;
+    ev->arg = arg = it->argv[it->ndx];
+    cli_classify(arg, &m);
+    if (it->no_flags) m.kind = CLI_TOK_OPERAND;
+    k = -1;
+    switch (m.kind) {
+      case CLI_TOK_DASHDASH:
+        it->no_flags = 1;
+        it->ndx++;
+        return clinext(it);
+
+      case CLI_TOK_SHORT:
+        if ((unsigned char)arg[it->sub] < 128) k = it->shorts[(unsigned char)arg[it->sub]] - 1;
+        if (k < 0) it->sub = 1;   // The whole argument is not an option
+        else if (it->defs[k].opt.flags & CLI_OPT_ARGUMENT) {
+          if (arg[it->sub + 1] != '\0') ev->val = arg + it->sub + 1;
+          else cli_iter_value(it, arg, &(cli_meta_t){.eq = 0});
+          it->sub = 1;
+        }
+        else if (arg[it->sub + 1] != '\0') {it->sub++; return cli_iter_found(it, k);}  // Same argument next time
+        else it->sub = 1;
+        break;
+
+      case CLI_TOK_LONG:
+        k = cli_iter_find(it, arg, &m, CLI_OPT_FLAG_LONG);
+        break;
+
+      default:
+        if (!it->cmd_found && (k = cli_iter_find(it, arg, &m, CLI_OPT_COMMAND)) >= 0) {
+          it->cmd_found = 1;
+          break;
+        }
+        for (; it->defs[it->pos].def != NULL; it->pos++) {
+          opt = &it->defs[it->pos].opt;
+          if (!(opt->flags & (CLI_OPT_FLAG_SHORT | CLI_OPT_FLAG_LONG | CLI_OPT_COMMAND))) break;
+        }
+        if (it->defs[it->pos].def != NULL) {
+          k = it->pos++;
+          ev->val = arg;
+          it->cmd_found = 1;
+        }
+        m.eq = 0;   // A positional argument is not `name=value`
+        break;
+    }
+    if (k >= 0 && m.kind != CLI_TOK_SHORT && ev->val == cli_emptystr && (it->defs[k].opt.flags & CLI_OPT_ARGUMENT))
+      cli_iter_value(it, arg, &m);
+    it->ndx++;
+    if (k >= 0) return cli_iter_found(it, k);
+    cliarg = ev->val = arg;
+    clindx = ev->ndx;
+    return ev;
+  }
+
+  if (it->phase == 1) {it->phase = 2; it->def = it->pos;}
+  for (; it->phase == 2; it->def++) {           // Missing arguments (the ones after `pos`)
+    if (it->defs[it->def].def == NULL) {it->phase = 3; break;}
+    opt = &it->defs[it->def].opt;
+    if (opt->flags & (CLI_OPT_FLAG_SHORT | CLI_OPT_FLAG_LONG | CLI_OPT_COMMAND | CLI_OPT_OPTIONAL))
+      continue;
+    ev->opt = it->def++;
+    ev->err = clierrormsg;
+    ev->arg = opt->def + opt->optname_offset;
+    ev->len = opt->optname_len;
+    return ev;
+  }
+  return NULL;
+}
+
+// ## Snapshots
+// A tool that starts other processes with the same options (workers, a helper, the
+// real tool behind a wrapper) can hand them the options it has parsed, so that they
+// don't parse them again. Define `CLI_SNAPSHOT` before including `cli.h` (it needs
+// POSIX: define `_POSIX_C_SOURCE` as 200809L when compiling with `-std=c11`):
+//
+//     clioptions(argc, argv) { ... }         // The parent
+//     int fd = clisnapfd();                  // An unlinked temporary file
+//     snprintf(arg, sizeof(arg), "%d", fd);
+//     execl("./worker", "worker", "--snapshot", arg, NULL);
+//
+//     if (argc == 3 && strcmp(argv[1], "--snapshot") == 0)  // The child
+//       clirestore(atoi(argv[2]));
+//     clioptions(argc, argv) { ... }         // The same block as the parent
+//
+// A snapshot records the handlers run by the last `clioptions()` block: in which order,
+// with which `cliarg` and `clindx`, and where the value came from (the command line,
+// a default or an environment variable: `cliisdefault()` and `cliisenv()` are the same
+// as in the parent). After `clirestore()`, the next `clioptions()` block ignores its own
+// arguments and runs the same handlers again, with `cliargv` pointing to the arguments
+// of the parent. The arguments are not classified, the values are not validated, the
+// environment is not read and the final checks (required arguments, constraint groups)
+// are not repeated: they have all been done by the parent. A command set with
+// `clicommand()` is run as usual, parsing its own arguments.
+//
+// `clisnapshot(&len)` returns the snapshot itself (NULL if there's no memory). It only
+// contains offsets, so it can be copied anywhere (e.g. in shared memory) and restored
+// with `clirestore(ptr, len)`; it must be aligned as an `int` and stay in memory as
+// long as the values are used. `clirestore(fd)` maps the snapshot written by
+// `clisnapfd()` (which returns -1 on errors). Both return -1 if the snapshot is not
+// valid (e.g. written by another version of `cli.h`), 0 otherwise.
+
+#ifdef CLI_SNAPSHOT
+#ifdef CLI_FREESTANDING
+#error "CLI_SNAPSHOT can't be used with CLI_FREESTANDING"
+#endif
+
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define CLI_SNAP_REST 0xFFFF   // The final `cliopt()` (no option matched)
+
+typedef struct {
+  unsigned short bit;   // The option that matched (see `cli_opt_define()`)
+  unsigned char  src;   // Where `cliarg` came from (`CLI_SRC_...`)
+  unsigned char  pad;
+  int            ndx;   // `clindx` when the handler was run
+  unsigned int   val;   // Offset of `cliarg` in the snapshot
+} cli_snap_rec_t;
+
+typedef struct {
+  char         magic[4];   // "CLIs"
+  unsigned int version;    // `CLI_VERSION`
+  unsigned int size;
+  unsigned int argc;
+  unsigned int nrec;       // Followed by `nrec` records, `argc` offsets and the strings
+} cli_snap_hdr_t;
+
+// What the last `clioptions()` block did. The offsets of the values are relative to
+// `cli_snap_vals` until the snapshot is built.
+CLI_VAR cli_snap_rec_t *cli_snap_recs CLI_INIT(NULL);
+CLI_VAR int    cli_snap_nrec CLI_INIT(0);
+CLI_VAR int    cli_snap_maxrec CLI_INIT(0);
+CLI_VAR char  *cli_snap_vals CLI_INIT(NULL);
+CLI_VAR size_t cli_snap_vlen CLI_INIT(0);
+CLI_VAR size_t cli_snap_vmax CLI_INIT(0);
+CLI_VAR char  *cli_snap_blob CLI_INIT(NULL);
+
+// What the next (or the current) `clioptions()` block will do
+CLI_VAR char           *cli_snap_base CLI_INIT(NULL);
+CLI_VAR char          **cli_snap_argv CLI_INIT(NULL);
+CLI_VAR int             cli_snap_argc CLI_INIT(0);
+CLI_VAR cli_snap_rec_t *cli_snap_cur CLI_INIT(NULL);
+CLI_VAR cli_snap_rec_t *cli_snap_end CLI_INIT(NULL);
+CLI_VAR cli_snap_rec_t *cli_snap_now CLI_INIT(NULL);   // The one for `clindx`
+
+CLI_FN void cli_snap_rec(unsigned short bit, int src)
+{
+  size_t len = strlen(cliarg) + 1;
+  if (cli_snap_nrec >= cli_snap_maxrec) {
+    int max = cli_snap_maxrec ? cli_snap_maxrec * 2 : 64;
+    cli_snap_rec_t *r = realloc(cli_snap_recs, max * sizeof(cli_snap_rec_t));
+    if (r == NULL) return;
+    cli_snap_recs = r;
+    cli_snap_maxrec = max;
+  }
+  if (cli_snap_vlen + len > cli_snap_vmax) {
+    size_t max = cli_snap_vmax ? cli_snap_vmax * 2 : 1024;
+    while (max < cli_snap_vlen + len) max *= 2;
+    char *v = realloc(cli_snap_vals, max);
+    if (v == NULL) return;
+    cli_snap_vals = v;
+    cli_snap_vmax = max;
+  }
+  // Values from defaults are in a buffer that will be reused: they are copied now
+  memcpy(cli_snap_vals + cli_snap_vlen, cliarg, len);
+  cli_snap_recs[cli_snap_nrec++] = (cli_snap_rec_t){bit, (unsigned char)src, 0, clindx, (unsigned int)cli_snap_vlen};
+  cli_snap_vlen += len;
+}
+
+CLI_FN int cli_snap_begin()
+{
+  cli_snap_nrec = 0;
+  cli_snap_vlen = 0;
+  if (!cli_replay) return 0;
+  cliargc = cli_snap_argc;
+  cliargv = cli_snap_argv;
+  return 1;
+}
+
+// Moves to the next handler to run from the command line
+CLI_FN int cli_snap_next()
+{
+  cli_no_flags = 1;  // There's no `--` to look for
+  if (clindx == 0) return 1;
+  while (cli_snap_cur < cli_snap_end && cli_snap_cur->src != CLI_SRC_ARG) cli_snap_cur++;
+  if (cli_snap_cur >= cli_snap_end) {
+    clindx = cliargc;
+    return 0;
+  }
+  cli_snap_now = cli_snap_cur++;
+  clindx = cli_snap_now->ndx;
+  return 1;
+}
+
+CLI_FN int cli_snap_default(cli_option_t *opt)
+{
+  if (cli_snap_cur >= cli_snap_end || cli_snap_cur->src == CLI_SRC_ARG || cli_snap_cur->bit != opt->bit)
+    return 0;
+  cliarg = cli_snap_base + cli_snap_cur->val;
+  cli_src = cli_snap_cur->src;
+  cli_snap_cur++;
+  cli_snap_rec(opt->bit, cli_src);
+  return 1;
+}
+
+CLI_INLINE int cli_snap_check(cli_option_t *opt)
+{
+  if (cli_snap_now == NULL || cli_snap_now->bit != opt->bit) return 0;
+  cliarg = cli_snap_base + cli_snap_now->val;
+  cli_snap_now = NULL;
+  opt->flags |= CLI_OPT_FOUND;
+  cli_bit_set(opt->bit);
+  cli_snap_rec(opt->bit, CLI_SRC_ARG);
+  return 1;
+}
+
+CLI_FN int cli_snap_last()
+{
+  cli_replay = 0;
+  cli_snap_now = NULL;
+  cli_check_deferred();   // Only those of `clidefer()` in the handlers
+  cli_check_async();
+  if (cli_family != NULL) cli_run_family();
+  return 1;
+}
+
+CLI_INLINE void *clisnapshot(size_t *len)
+{
+  size_t size = sizeof(cli_snap_hdr_t) + cli_snap_nrec * sizeof(cli_snap_rec_t) + cliargc * sizeof(unsigned int);
+  size_t vals;
+  int k;
+
+  for (k = 0; k < cliargc; k++) size += strlen(cliargv[k]) + 1;
+  vals = size;
+  size += cli_snap_vlen;
+  if (size > UINT_MAX) return NULL;
+
+  char *blob = realloc(cli_snap_blob, size);
+  if (blob == NULL) return NULL;
+  cli_snap_blob = blob;
+
+  cli_snap_hdr_t *hdr = (cli_snap_hdr_t *)blob;
+  cli_snap_rec_t *rec = (cli_snap_rec_t *)(hdr + 1);
+  unsigned int   *arg = (unsigned int *)(rec + cli_snap_nrec);
+  char           *str = (char *)(arg + cliargc);
+
+  *hdr = (cli_snap_hdr_t){{'C','L','I','s'}, CLI_VERSION, (unsigned int)size, (unsigned int)cliargc, (unsigned int)cli_snap_nrec};
+  for (k = 0; k < cli_snap_nrec; k++) {
+    rec[k] = cli_snap_recs[k];
+    rec[k].val += (unsigned int)vals;
+  }
+  for (k = 0; k < cliargc; k++) {
+    arg[k] = (unsigned int)(str - blob);
+    str = stpcpy(str, cliargv[k]) + 1;
+  }
+  if (cli_snap_vlen > 0) memcpy(str, cli_snap_vals, cli_snap_vlen);
+  if (len) *len = size;
+  return blob;
+}
+
+CLI_INLINE int clisnapfd()
+{
+  char tmp[] = "/tmp/cli_snapXXXXXX";
+  size_t len;
+  char *blob = clisnapshot(&len);
+  int fd;
+
+  if (blob == NULL || (fd = mkstemp(tmp)) < 0) return -1;
+  unlink(tmp);
+  while (len > 0) {
+    ssize_t n = write(fd, blob, len);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) {
+      close(fd);
+      return -1;
+    }
+    blob += n; len -= n;
+  }
+  return fd;
+}
+
+#define clirestore(...) vrg(cli_restore_, __VA_ARGS__)
+
+// Only checks that all the offsets are within the snapshot
+CLI_INLINE int cli_restore_2(void *snapshot, size_t len)
+{
+  cli_snap_hdr_t *hdr = snapshot;
+  char *blob = snapshot;
+  unsigned int k;
+
+  if (blob == NULL || len < sizeof(cli_snap_hdr_t) || memcmp(hdr->magic, "CLIs", 4) != 0 ||
+      hdr->version != CLI_VERSION || hdr->size != len || hdr->argc == 0 || blob[len - 1] != '\0' ||
+      hdr->nrec > len / sizeof(cli_snap_rec_t) || hdr->argc > len / sizeof(unsigned int) ||
+      sizeof(cli_snap_hdr_t) + hdr->nrec * sizeof(cli_snap_rec_t) + hdr->argc * sizeof(unsigned int) >= len)
+    return -1;
+
+  cli_snap_rec_t *rec = (cli_snap_rec_t *)(hdr + 1);
+  unsigned int   *arg = (unsigned int *)(rec + hdr->nrec);
+  for (k = 0; k < hdr->nrec; k++)
+    if (rec[k].val >= len || rec[k].ndx < 0 || rec[k].ndx >= (int)hdr->argc) return -1;
+  for (k = 0; k < hdr->argc; k++)
+    if (arg[k] >= len) return -1;
+
+  char **argv = realloc(cli_snap_argv, (hdr->argc + 1) * sizeof(char *));
+  if (argv == NULL) return -1;
+  for (k = 0; k < hdr->argc; k++) argv[k] = blob + arg[k];
+  argv[k] = NULL;
+
+  cli_snap_argv = argv;
+  cli_snap_argc = (int)hdr->argc;
+  cli_snap_base = blob;
+  cli_snap_cur  = rec;
+  cli_snap_end  = rec + hdr->nrec;
+  cli_snap_now  = NULL;
+  cli_replay = 1;
+  return 0;
+}
+
+// The mapping is private: the handlers can change the values as they would do with `argv`
+CLI_INLINE int cli_restore_1(int fd)
+{
+  struct stat st;
+  void *blob;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) return -1;
+  blob = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  if (blob == MAP_FAILED) return -1;
+  if (cli_restore_2(blob, (size_t)st.st_size) == 0) return 0;
+  munmap(blob, (size_t)st.st_size);
+  return -1;
+}
+#endif // CLI_SNAPSHOT
+
+// ## Values from files
+// Certificates, queries or large JSON documents are better passed in files, without
+// having each handler read them. Define `CLI_INDIRECT` (it needs POSIX: define
+// `_POSIX_C_SOURCE` as 200809L when compiling with `-std=c11`) and put a `@` before the
+// name of the argument of the options that take them:
+//
+//     cliopt("-q, --query @sql\tThe query (or @file)", is_select) {
+//       size_t len;
+//       query = cliargview(&len);          // The contents of `q.sql` for `-q @q.sql`
+//       if (query == NULL) clierror("", cliarg);
+//     }
+//
+// A value `@path` stands for the contents of the file `path`, `@@text` for `@text` and
+// anything else for itself. `cliarg` is still the value as given: the file is read only
+// if the validator of the option or the handler needs it. The validators get the
+// contents (the `@` in the definition is what tells them apart from the other options)
+// and `cliargview()` returns them for any value, setting `*len` to their length (the
+// argument can be omitted). They end with a `\0`, which validators of binary files
+// should not rely on. If the file can't be read, `cliargview()` returns NULL with
+// `clierrormsg` set, so that `clierror("", cliarg)` reports it.
+//
+// Files are memory-mapped, read only: nothing is copied, however large they are, and
+// they are mapped once however many times the value is used. Only the files that can't
+// be mapped (e.g. pipes, as in `@<(cmd)`) and those whose size is a multiple of the
+// page size (there would be no room for the `\0`) are read in memory. The contents
+// stay there until `cliunmap()` releases all of them.
+
+#ifdef CLI_INDIRECT
+#ifdef CLI_FREESTANDING
+#error "CLI_INDIRECT can't be used with CLI_FREESTANDING"
+#endif
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+typedef struct {
+  char  *path;     // A copy of the path
+  char  *ptr;      // The contents of the file
+  size_t len;
+  int    mapped;   // Or read in memory
+} cli_view_t;
+
+CLI_VAR cli_view_t *cli_views CLI_INIT(NULL);
+CLI_VAR int cli_num_views CLI_INIT(0);
+CLI_VAR int cli_max_views CLI_INIT(0);
+
+CLI_FN char *cli_view_read(int fd, size_t size, size_t *len)
+{
+  size_t n = 0, max = size + 4096;
+  char *buf = NULL, *p;
+  ssize_t k = 0;
+  do {
+    n += (size_t)k;
+    if (buf == NULL || max - n < 2) {   // Room for one more byte and the `\0`
+      if (buf != NULL) max *= 2;
+      if ((p = realloc(buf, max)) == NULL) break;
+      buf = p;
+    }
+  } while ((k = read(fd, buf + n, max - n - 1)) > 0);
+  if (k < 0 || p == NULL) {
+    free(buf);
+    return NULL;
+  }
+  buf[n] = '\0';
+  *len = n;
+  return buf;
+}
+
+CLI_FN int cli_view_map(char *path)
+{
+  cli_view_t v = {0};
+  struct stat st;
+  size_t plen = strlen(path) + 1;
+  long page = sysconf(_SC_PAGESIZE);
+  int fd;
+
+  if (cli_num_views >= cli_max_views) {
+    int max = cli_max_views ? cli_max_views * 2 : 8;
+    cli_view_t *views = realloc(cli_views, max * sizeof(cli_view_t));
+    if (views == NULL) return -1;
+    cli_views = views;
+    cli_max_views = max;
+  }
+  if ((fd = open(path, O_RDONLY)) < 0) return -1;
+  if (fstat(fd, &st) == 0 && (v.path = malloc(plen)) != NULL) {
+    memcpy(v.path, path, plen);
+    // The rest of the last page is filled with zeros
+    if (S_ISREG(st.st_mode) && page > 0 && st.st_size % page != 0) {
+      v.len = (size_t)st.st_size;
+      v.ptr = mmap(NULL, v.len, PROT_READ, MAP_PRIVATE, fd, 0);
+      v.mapped = (v.ptr != MAP_FAILED);
+    }
+    if (!v.mapped) v.ptr = cli_view_read(fd, S_ISREG(st.st_mode) ? (size_t)st.st_size : 0, &v.len);
+  }
+  close(fd);
+  if (v.ptr == NULL) {
+    free(v.path);
+    return -1;
+  }
+  cli_views[cli_num_views++] = v;
+  return 0;
+}
+
+CLI_FN char *cli_view(char *val, size_t *len)
+{
+  int k;
+  if (val[0] != '@' || val[1] == '@') {   // Not a file
+    val += (val[0] == '@');
+    if (len) *len = strlen(val);
+    return val;
+  }
+  for (k = 0; k < cli_num_views; k++)
+    if (strcmp(cli_views[k].path, val + 1) == 0) break;
+  if (k == cli_num_views && cli_view_map(val + 1) != 0) {
+    clierrormsg = CLI_STR_ERR_FILE;
+    return NULL;
+  }
+  if (len) *len = cli_views[k].len;
+  return cli_views[k].ptr;
+}
+
+#define cliargview(...) cli_view(cliarg, __VA_ARGS__+0)
+
+CLI_INLINE void cliunmap()
+{
+  for (int k = 0; k < cli_num_views; k++) {
+    if (cli_views[k].mapped) munmap(cli_views[k].ptr, cli_views[k].len);
+    else free(cli_views[k].ptr);
+    free(cli_views[k].path);
+  }
+  free(cli_views);
+  cli_views = NULL;
+  cli_num_views = cli_max_views = 0;
+}
+#endif // CLI_INDIRECT
+
+// ## Warm server
+// Tools that load large data in their handlers and are invoked many times (e.g. from
+// scripts) can stay resident. Define `CLI_SERVE` before including `cli.h` (it needs
+// POSIX: define `_POSIX_C_SOURCE` as 200809L when compiling with `-std=c11`):
+//
+//     int main(int argc, char *argv[]) {
+//       int rc = cliforward("/tmp/mytool.sock", argc, argv);
+//       if (rc != -1) return rc < 0 ? 1 : rc;   // A server took the request
+//       ...                              // Load the data
+//       if (serving) cliserve("/tmp/mytool.sock", run);
+//       return run(argc, argv);          // `run()` contains the `clioptions()` block
+//     }
+//
+// `cliforward()` sends the arguments, the current directory, the environment and the
+// stdin/stdout/stderr file descriptors to the server over a Unix socket, then waits
+// for the exit code. It returns -1 if the request has not been taken by a server (there
+// is no server listening, or the current directory can't be found): the caller can run
+// it itself. Once the server has taken it, the request is run there: if the exit code
+// is lost (the server or the connection went away), `cliforward()` returns -2 and the
+// request must not be run again, it may have run or still be running.
+//
+// `cliserve()` accepts requests and never returns (unless it can't listen on the
+// socket, in which case it returns -1). Each request is run by a forked copy of the
+// server: the loaded data is shared with it for free, while the parser state, the
+// changes made by the handlers and an `exit()` in them don't affect later requests.
+// Requests are served concurrently; the server catches `SIGCHLD` to reply with the
+// exit code as soon as a request is completed.
+//
+// Only the requests of the user running the server are served (the others are closed,
+// and `cliforward()` returns -1 to them). If something other than a socket is at `path`,
+// `cliserve()` leaves it there and returns -1.
+
+#ifdef CLI_SERVE
+#ifdef CLI_FREESTANDING
+#error "CLI_SERVE can't be used with CLI_FREESTANDING"
+#endif
+
+#include <unistd.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#ifdef __linux__
+#include <asm/socket.h>  // `SO_PEERCRED` (glibc only defines it for `_DEFAULT_SOURCE`)
+#endif
+#include <sys/wait.h>
+
+#ifndef CLI_SERVE_MAXLEN
+#define CLI_SERVE_MAXLEN (1 << 24)  // Max size of a request (args + env)
+#endif
+
+extern char **environ;
+
+typedef int (*cli_serve_fn_t)(int argc, char **argv);
+
+typedef struct {
+  unsigned int len;   // Size of the strings that follow: cwd, args and env
+  unsigned int argc;
+  unsigned int envc;
+} cli_serve_hdr_t;
+
+CLI_FN int cli_serve_socket(struct sockaddr_un *addr, const char *path)
+{
+  if (path == NULL || strlen(path) >= sizeof(addr->sun_path)) return -1;
+  memset(addr, 0, sizeof(*addr));
+  addr->sun_family = AF_UNIX;
+  strcpy(addr->sun_path, path);
+  return socket(AF_UNIX, SOCK_STREAM, 0);
+}
+
+// Receives (or sends) exactly `len` bytes. A client that is gone doesn't raise `SIGPIPE`.
+CLI_FN int cli_serve_io(int fd, void *buf, size_t len, int rd)
+{
+  char *p = buf;
+  while (len > 0) {
+    ssize_t n = rd ? recv(fd, p, len, 0) : send(fd, p, len, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return -1;
+    p += n; len -= n;
+  }
+  return 0;
+}
+
+CLI_INLINE int cliforward(const char *path, int argc, char **argv)
+{
+  struct sockaddr_un addr;
+  char cwd[4096];
+  char taken;
+  int sock;
+
+  // The request would be run in the directory of the server
+  if (getcwd(cwd, sizeof(cwd)) == NULL) return -1;
+  if ((sock = cli_serve_socket(&addr, path)) < 0) return -1;
+  if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    close(sock);
+    return -1;
+  }
+
+  int envc = 0;
+  size_t len = strlen(cwd) + 1;
+  for (int k = 0; k < argc; k++) len += strlen(argv[k]) + 1;
+  for (envc = 0; environ[envc] != NULL; envc++) len += strlen(environ[envc]) + 1;
+
+  char *payload = malloc(len), *p = payload;
+  int status = -1;
+  if (payload != NULL && len <= CLI_SERVE_MAXLEN) {
+    p = stpcpy(p, cwd) + 1;
+    for (int k = 0; k < argc; k++) p = stpcpy(p, argv[k]) + 1;
+    for (int k = 0; k < envc; k++) p = stpcpy(p, environ[k]) + 1;
+
+    cli_serve_hdr_t hdr = {(unsigned int)len, (unsigned int)argc, (unsigned int)envc};
+    int fds[3] = {0, 1, 2};
+    union {struct cmsghdr h; char buf[CMSG_SPACE(sizeof(fds))];} ctl;
+    struct iovec iov = {&hdr, sizeof(hdr)};
+    struct msghdr msg = {0};
+
+    msg.msg_iov = &iov; msg.msg_iovlen = 1;
+    msg.msg_control = ctl.buf; msg.msg_controllen = sizeof(ctl.buf);
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type  = SCM_RIGHTS;
+    cmsg->cmsg_len   = CMSG_LEN(sizeof(fds));
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+    // Until the server confirms it has taken the request, it has not been run
+    fflush(NULL);
+    if (sendmsg(sock, &msg, MSG_NOSIGNAL) != (ssize_t)sizeof(hdr) ||
+        cli_serve_io(sock, payload, len, 0) != 0 ||
+        cli_serve_io(sock, &taken, 1, 1) != 0)
+      status = -1;
+    else if (cli_serve_io(sock, &status, sizeof(status), 1) != 0)
+      status = -2;
+  }
+  free(payload);
+  close(sock);
+  return status;
+}
+
+// A forked server starts with the state left by the parsing of its own arguments: the
+// request must be parsed as if by a new process. What the server has allocated is left
+// alone (its handlers may still use it).
+CLI_FN void cli_serve_reset()
+{
+  cli_head = NULL;
+  cli_tail = (cli_option_t *)&cli_head;
+  cliargv = NULL; cliargc = 0;
+  cliarg = cli_emptystr; clindx = 0;
+  cliprogname = NULL;
+  cliheader = "";
+  cli_no_flags = 0;
+  cli_num_options = cli_num_commands = cli_num_arguments = 0;
+  cli_cmd_found = 0;
+  cli_reparse_ndx = 1;
+  cli_default_errors = 0;
+  clierrormsg = CLI_STR_ERROR_MSG;
+  cli_src = CLI_SRC_ARG;
+  cli_outlen = 0;
+  cli_num_metas = 0;
+  cli_num_bits = 0;
+  memset(cli_found_bits, 0, sizeof(cli_found_bits));
+  cli_groups = NULL; cli_groups_tail = (cli_group_t *)&cli_groups;
+  cli_bk_num = 0; cli_bk_tail = NULL; cli_bk_bits = 0;
+  cli_deferred = NULL;
+  cli_num_deferred = cli_max_deferred = 0;
+  cli_async = NULL;
+  cli_num_async = cli_max_async = 0;
+#ifdef CLI_THREADS
+  // Only the thread that called `fork()` is in the child
+  pthread_mutex_init(&cli_async_lock, NULL);
+  pthread_cond_init(&cli_async_cond, NULL);
+  cli_async_threads = cli_async_idle = cli_async_next = cli_async_closed = 0;
+#endif
+  cli_family = NULL;
+  cli_family_ndx = 0;
+  clicmdrc = -1;
+#ifdef CLI_SNAPSHOT
+  cli_replay = 0;
+  cli_snap_nrec = 0; cli_snap_vlen = 0;
+  cli_snap_base = NULL; cli_snap_argv = NULL; cli_snap_argc = 0;
+  cli_snap_cur = cli_snap_end = cli_snap_now = NULL;
+#endif
+#ifdef CLI_INDIRECT
+  // The files are read again: the request may be run in another directory
+  cli_views = NULL;
+  cli_num_views = cli_max_views = 0;
+#endif
+}
+
+// Only the user that runs the server can send it requests (and have it run them
+// with its privileges on the file descriptors it passes).
+CLI_FN int cli_serve_peer_ok(int conn)
+{
+#ifdef __linux__
+  struct { pid_t pid; uid_t uid; gid_t gid; } cred;   // As `struct ucred`
+  socklen_t len = sizeof(cred);
+  if (getsockopt(conn, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0 || len != sizeof(cred)) return 0;
+  return cred.uid == geteuid();
+#else
+  uid_t uid;
+  gid_t gid;
+  if (getpeereid(conn, &uid, &gid) != 0) return 0;
+  return uid == geteuid();
+#endif
+}
+
+// Requests being served: the exit code of `pid` will be sent to `conn`
+typedef struct {
+  pid_t pid;
+  int   conn;
+} cli_serve_job_t;
+
+CLI_VAR cli_serve_job_t *cli_serve_jobs CLI_INIT(NULL);
+CLI_VAR int cli_serve_num_jobs CLI_INIT(0);
+CLI_VAR int cli_serve_pipe[2];  // Written when a child terminates
+
+CLI_FN void cli_serve_sigchld(int sig)
+{
+  int err = errno;
+  ssize_t n = write(cli_serve_pipe[1], "", 1);
+  (void)sig; (void)n;
+  errno = err;
+}
+
+// Closes the file descriptors received with a malformed request
+CLI_FN void cli_serve_close_fds(struct msghdr *msg)
+{
+  struct cmsghdr *cmsg;
+  int fd;
+  for (cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+    for (size_t k = 0; k < (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int); k++) {
+      memcpy(&fd, CMSG_DATA(cmsg) + k * sizeof(int), sizeof(int));
+      close(fd);
+    }
+  }
+}
+
+// Receives a request and starts a child to run it. Returns the pid of the child.
+CLI_FN pid_t cli_serve_request(int sock, int conn, cli_serve_fn_t fn)
+{
+  cli_serve_hdr_t hdr;
+  int fds[3] = {-1, -1, -1};
+  union {struct cmsghdr h; char buf[CMSG_SPACE(sizeof(fds))];} ctl;
+  struct iovec iov = {&hdr, sizeof(hdr)};
+  struct msghdr msg = {0};
+  char  *payload = NULL;
+  char **args = NULL;
+  pid_t pid = -1;
+  unsigned int k;
+
+  msg.msg_iov = &iov; msg.msg_iovlen = 1;
+  msg.msg_control = ctl.buf; msg.msg_controllen = sizeof(ctl.buf);
+  if (recvmsg(conn, &msg, 0) != (ssize_t)sizeof(hdr)) {
+    cli_serve_close_fds(&msg);
+    return -1;
+  }
+
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  if (cmsg == NULL || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS ||
+      cmsg->cmsg_len != CMSG_LEN(sizeof(fds)) || CMSG_NXTHDR(&msg, cmsg) != NULL) {
+    cli_serve_close_fds(&msg);
+    return -1;
+  }
+  memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+
+  if (hdr.argc == 0 || hdr.len == 0 || hdr.len > CLI_SERVE_MAXLEN) goto done;
+  payload = malloc(hdr.len + 1);
+  args = malloc((hdr.argc + hdr.envc + 2) * sizeof(char *));
+  if (payload == NULL || args == NULL || cli_serve_io(conn, payload, hdr.len, 1) != 0) goto done;
+  payload[hdr.len] = '\0';
+
+  // The current directory, then `argc` arguments and `envc` environment variables
+  char *p = payload, *end = payload + hdr.len;
+  char *cwd = p;
+  p += strlen(p) + 1;
+  for (k = 0; k < hdr.argc + hdr.envc && p < end; k++, p += strlen(p) + 1)
+    args[k + (k >= hdr.argc)] = p;
+  if (k < hdr.argc + hdr.envc) goto done;
+  args[hdr.argc] = NULL;
+  args[hdr.argc + hdr.envc + 1] = NULL;
+  if (cwd[0] == '\0') goto done;
+
+  // From here on, the client won't run the request itself
+  if (cli_serve_io(conn, &(char){1}, 1, 0) != 0) goto done;
+  fflush(NULL);
+  if ((pid = fork()) == 0) {
+    signal(SIGCHLD, SIG_DFL);
+    close(sock); close(conn);
+    close(cli_serve_pipe[0]); close(cli_serve_pipe[1]);
+    for (int j = 0; j < cli_serve_num_jobs; j++) close(cli_serve_jobs[j].conn);
+    for (k = 0; k < 3; k++) dup2(fds[k], k);
+    for (k = 0; k < 3; k++) if (fds[k] > 2) close(fds[k]);
+    if (chdir(cwd) != 0) {
+      fprintf(stderr, "%s: Can't change directory to '%s'\n", args[0], cwd);
+      exit(1);
+    }
+    environ = args + hdr.argc + 1;
+    cli_serve_reset();
+    exit(fn((int)hdr.argc, args));
+  }
+
+ done:
+  for (k = 0; k < 3; k++) close(fds[k]);
+  free(payload);
+  free(args);
+  return pid;
+}
+
+CLI_FN void cli_serve_reap()
+{
+  int wst, status;
+  pid_t pid;
+  char drain[64];
+
+  while (read(cli_serve_pipe[0], drain, sizeof(drain)) > 0) ;
+  while ((pid = waitpid(-1, &wst, WNOHANG)) > 0) {
+    for (int j = 0; j < cli_serve_num_jobs; j++) {
+      if (cli_serve_jobs[j].pid != pid) continue;
+      status = WIFEXITED(wst) ? WEXITSTATUS(wst) : 128 + WTERMSIG(wst);
+      cli_serve_io(cli_serve_jobs[j].conn, &status, sizeof(status), 0);
+      close(cli_serve_jobs[j].conn);
+      cli_serve_jobs[j] = cli_serve_jobs[--cli_serve_num_jobs];
+      break;
+    }
+  }
+}
+
+CLI_INLINE int cliserve(const char *path, cli_serve_fn_t fn)
+{
+  struct sockaddr_un addr;
+  struct sigaction sa = {0};
+  int max_jobs = 0;
+  struct stat st;
+  int sock = cli_serve_socket(&addr, path);
+  if (sock < 0) return -1;
+  // Only a socket left by a previous server is removed
+  if (lstat(path, &st) == 0 && (!S_ISSOCK(st.st_mode) || unlink(path) != 0)) {
+    close(sock);
+    return -1;
+  }
+  if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(sock, 64) < 0 ||
+      pipe(cli_serve_pipe) < 0) {
+    close(sock);
+    return -1;
+  }
+  fcntl(cli_serve_pipe[0], F_SETFL, O_NONBLOCK);
+  fcntl(cli_serve_pipe[1], F_SETFL, O_NONBLOCK);
+
+  sa.sa_handler = cli_serve_sigchld;
+  sa.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+  sigemptyset(&sa.sa_mask);
+  sigaction(SIGCHLD, &sa, NULL);
+
+  // A client can't keep the server waiting for its request
+  struct timeval timeout = {1, 0};
+  struct pollfd ready[2] = {{sock, POLLIN, 0}, {cli_serve_pipe[0], POLLIN, 0}};
+
+  for (;;) {
+    if (poll(ready, 2, -1) < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    if (ready[1].revents & POLLIN) cli_serve_reap();
+    if (!(ready[0].revents & POLLIN)) continue;
+
+    int conn = accept(sock, NULL, NULL);
+    if (conn < 0) continue;
+    if (!cli_serve_peer_ok(conn)) {
+      close(conn);     // The client will run the request itself
+      continue;
+    }
+    if (cli_serve_num_jobs >= max_jobs) {
+      int max = max_jobs ? max_jobs * 2 : 16;
+      cli_serve_job_t *jobs = realloc(cli_serve_jobs, max * sizeof(cli_serve_job_t));
+      if (jobs == NULL) { close(conn); continue; }
+      cli_serve_jobs = jobs;
+      max_jobs = max;
+    }
+    setsockopt(conn, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    pid_t pid = cli_serve_request(sock, conn, fn);
+    if (pid > 0) cli_serve_jobs[cli_serve_num_jobs++] = (cli_serve_job_t){pid, conn};
+    else close(conn);  // The client will run the request itself
+  }
+  close(sock);
+  return -1;
+}
+#endif // CLI_SERVE
+
+#ifdef CLI_DIAGNOSTIC_PUSHED
+#pragma GCC diagnostic pop
+#endif
+
 #endif // CLI_VERSION
@@ -0,0 +1,423 @@
+//.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//.  SPDX-License-Identifier: MIT
+
+//  ooooooooo.   ooooooooo.   ooooooooooooo
+//  `888   `Y88. `888   `Y88. 8'   888   `8
+//   888   .d88'  888   .d88'      888
+//   888ooo88P'   888ooo88P'       888
+//   888          888`88b.         888
+//   888          888  `88b.       888
+//  o888o        o888o  o888o     o888o
+
+#ifndef PRT_VERSION
+#define PRT_VERSION 0x0001000B // 0.1.0-beta
+
+// # Typed print
+//
+// `printf()` parses its format string at each call to find out, from the conversions,
+// the types of its arguments. The compiler already knows them: `prt()` takes the values
+// to write, in order, and `_Generic` picks the writer for each of them at compile time.
+//
+//     prt("x = ", x, ", ratio = ", r, ", name = ", name, "\n");
+//     prtln("done in ", ms, " ms");                     // Followed by a '\n'
+//
+//     char buf[64];
+//     prt_out_t o = prtbuf(buf, sizeof(buf));
+//     size_t n = prtto(&o, "id=", id, " v=", v);       // Like `snprintf()`
+//
+// Values are written as:
+//
+//   - integers: in decimal (`char` as a character, `_Bool` as `true` or `false`);
+//   - `float` and `double`: with the fewest digits that read back as the same value, up
+//     to 15 (6 for floats), as in `1.5`, `0.1` or `-0.001`. The others (very large or
+//     very small values) are written by `%.17g` (`%.9g`). Zero keeps its sign (`-0`);
+//   - strings (`char *`): as they are, `(null)` for NULL;
+//   - any other pointer: in hexadecimal, as `0x7ffc10`.
+//
+// Character constants like `'a'` are `int` in C and are written as numbers.
+//
+// `prt()` and `prtln()` write into a buffer of `PRT_BUFSIZE` bytes that belongs to the
+// calling thread (and to the source file). It's written to the file descriptor `PRT_FD`
+// (the standard output) with one `write()`:
+//
+//   - when it's full,
+//   - when `prtflush()` is called,
+//   - at exit (for the thread that calls `exit()`: other threads must call `prtflush()`).
+//
+// This is not the `stdio` buffer: when mixing `prt()` and `printf()`, flush one before
+// using the other.
+//
+// `prtto(o, ...)` writes into a `prt_out_t`: a buffer of the caller (`prtbuf()`), where the
+// text is truncated and terminated as `snprintf()` does, or a buffer of the caller that is
+// written to a file descriptor when full (`prtfd()`). It returns the length of the text in
+// the buffer (for `prtbuf()`, even the part that didn't fit).
+//
+// Up to 9 values (8 for `prtln()`) for each call; the output argument of `prtto()` is
+// evaluated more than once.
+//
+// `prt.h` requires C11 (`_Generic`, `_Thread_local` and `<stdatomic.h>`) and `write()`
+// from POSIX.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+//.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//.  SPDX-License-Identifier: MIT
+#ifndef VRG_VERSION
+#define VRG_VERSION 0x0021000B // 0.21.0-beta
+#define VRG_jn(x,y)    VRG_exp(x ## y)
+#define VRG_join(x,y)  VRG_jn(x, y)
+#define VRG_exp(...) __VA_ARGS__
+#define VRG_count(x1,x2,x3,x4,x5,x6,x7,x8,x9,xA,xN, ...) xN
+#define VRG_nargs(...)    VRG_exp(VRG_count(__VA_ARGS__, A, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+#define VRG_ncommas(...)  VRG_exp(VRG_count(__VA_ARGS__, _, _, _, _, _, _, _, _, 1, _, _))
+#define VRG_comma(...) ,
+#define VRG_sel(x,...) \
+   VRG_join(VRG_sel_, \
+            VRG_join(VRG_ncommas(VRG_comma __VA_ARGS__ ()), VRG_ncommas(VRG_comma __VA_ARGS__ ))) (x)
+#define VRG_sel_1_(x) 0
+#define VRG_sel_11(x) x
+#define VRG_sel___(x) x
+#define vrg(f_,...)  VRG_join(f_, VRG_sel(VRG_nargs(__VA_ARGS__),__VA_ARGS__))(__VA_ARGS__)
+#define VRG_frst(x,...) x
+#define VRG_scnd(x,...) VRG_frst(__VA_ARGS__)
+#define VRG_tail(x,...) __VA_ARGS__
+#define VRG_tail2(x,...) VRG_tail(__VA_ARGS__)
+#define VRG_precomma(...) VRG_comma
+#define VRG_sel_n(x,...) \
+   VRG_join(VRG_sel_ ,VRG_ncommas(VRG_exp(VRG_precomma VRG_frst(__VA_ARGS__) () VRG_scnd(__VA_ARGS__) ())))(x)
+#define VRG_sel_1(x) x
+#define VRG_sel__(x) _
+#define vrg0(f_,...)  VRG_join(f_,VRG_sel_n(0,__VA_ARGS__))(__VA_ARGS__)
+#define vrg1(f_,...)  VRG_join(f_,VRG_sel_n(1,VRG_tail(__VA_ARGS__)))(__VA_ARGS__)
+#define vrg2(f_,...)  VRG_join(f_,VRG_sel_n(2,VRG_tail2(__VA_ARGS__)))(__VA_ARGS__)
+#define vrg_(f_,...)  vrg0(f_,...)
+#define VRG_kwargs(t_,...) ((t_){ t_ ## _defaults, __VA_ARGS__ })
+#define VRG_unp(...) __VA_ARGS__
+#define VRG_map_ap(m_,c_,i_,x_)  m_(x_)
+#define VRG_mapi_ap(m_,c_,i_,x_) m_(i_,x_)
+#define VRG_mapx_ap(m_,c_,i_,x_) m_(c_,x_)
+#define VRG_map_0(a_,m_,c_,s_,...)
+#define VRG_map_1(a_,m_,c_,s_,x0)                         a_(m_,c_,0,x0)
+#define VRG_map_2(a_,m_,c_,s_,x0,x1)                      VRG_map_1(a_,m_,c_,s_,x0) VRG_unp s_ a_(m_,c_,1,x1)
+#define VRG_map_3(a_,m_,c_,s_,x0,x1,x2)                   VRG_map_2(a_,m_,c_,s_,x0,x1) VRG_unp s_ a_(m_,c_,2,x2)
+#define VRG_map_4(a_,m_,c_,s_,x0,x1,x2,x3)                VRG_map_3(a_,m_,c_,s_,x0,x1,x2) VRG_unp s_ a_(m_,c_,3,x3)
+#define VRG_map_5(a_,m_,c_,s_,x0,x1,x2,x3,x4)             VRG_map_4(a_,m_,c_,s_,x0,x1,x2,x3) VRG_unp s_ a_(m_,c_,4,x4)
+#define VRG_map_6(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5)          VRG_map_5(a_,m_,c_,s_,x0,x1,x2,x3,x4) VRG_unp s_ a_(m_,c_,5,x5)
+#define VRG_map_7(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6)       VRG_map_6(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5) VRG_unp s_ a_(m_,c_,6,x6)
+#define VRG_map_8(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7)    VRG_map_7(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6) VRG_unp s_ a_(m_,c_,7,x7)
+#define VRG_map_9(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7,x8) VRG_map_8(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7) VRG_unp s_ a_(m_,c_,8,x8)
+#define VRG_map_go(a_,m_,c_,s_,...) \
+   VRG_join(VRG_map_, VRG_sel(VRG_nargs(__VA_ARGS__),__VA_ARGS__))(a_,m_,c_,s_,__VA_ARGS__)
+#define VRG_map(m_,s_,...)      VRG_map_go(VRG_map_ap,  m_, ~,  s_, __VA_ARGS__)
+#define VRG_mapi(m_,s_,...)     VRG_map_go(VRG_mapi_ap, m_, ~,  s_, __VA_ARGS__)
+#define VRG_mapx(m_,c_,s_,...)  VRG_map_go(VRG_mapx_ap, m_, c_, s_, __VA_ARGS__)
+#define VRG_foreach(m_,...)     VRG_map_go(VRG_map_ap,  m_, ~, (;), __VA_ARGS__)
+#define VRG_drop_0(...)                            __VA_ARGS__
+#define VRG_drop_1(x0,...)                         __VA_ARGS__
+#define VRG_drop_2(x0,x1,...)                      __VA_ARGS__
+#define VRG_drop_3(x0,x1,x2,...)                   __VA_ARGS__
+#define VRG_drop_4(x0,x1,x2,x3,...)                __VA_ARGS__
+#define VRG_drop_5(x0,x1,x2,x3,x4,...)             __VA_ARGS__
+#define VRG_drop_6(x0,x1,x2,x3,x4,x5,...)          __VA_ARGS__
+#define VRG_drop_7(x0,x1,x2,x3,x4,x5,x6,...)       __VA_ARGS__
+#define VRG_drop_8(x0,x1,x2,x3,x4,x5,x6,x7,...)    __VA_ARGS__
+#define VRG_drop_9(x0,x1,x2,x3,x4,x5,x6,x7,x8,...) __VA_ARGS__
+#define VRG_dflt_1(n_)      n_ ## _is_required
+#define VRG_dflt_2(n_,d_)   d_
+#define VRG_dflt(p_)        VRG_join(VRG_dflt_, VRG_nargs p_) p_
+#define VRG_dflt_next(p_)   , VRG_dflt(p_)
+#define VRG_defaults(f_,p_,...)   VRG_join(VRG_defaults_, VRG_sel(1,__VA_ARGS__))(f_,p_,__VA_ARGS__)
+#define VRG_defaults_0(f_,p_,...) f_(VRG_map(VRG_dflt, (,), VRG_unp p_))
+#define VRG_defaults_1(f_,p_,...) \
+   f_(__VA_ARGS__ VRG_map(VRG_dflt_next, (), VRG_join(VRG_drop_, VRG_nargs(__VA_ARGS__)) p_))
+#define VRG_args_0(a_)
+#define VRG_args_1(a_) (a_)[0]
+#define VRG_args_2(a_) VRG_args_1(a_), (a_)[1]
+#define VRG_args_3(a_) VRG_args_2(a_), (a_)[2]
+#define VRG_args_4(a_) VRG_args_3(a_), (a_)[3]
+#define VRG_args_5(a_) VRG_args_4(a_), (a_)[4]
+#define VRG_args_6(a_) VRG_args_5(a_), (a_)[5]
+#define VRG_args_7(a_) VRG_args_6(a_), (a_)[6]
+#define VRG_args_8(a_) VRG_args_7(a_), (a_)[7]
+#define VRG_args_9(a_) VRG_args_8(a_), (a_)[8]
+#define VRG_call(m_, args_) m_ args_
+#define VRG_apply_go(m_, args_) m_ args_  // Not VRG_call(): it would not expand inside itself
+#define VRG_apply_cs(f_, n_, a_, k_)  (n_) == k_ ? VRG_apply_go(VRG_join(f_, k_), (VRG_join(VRG_args_, k_)(a_))) :
+#define VRG_apply_case(c_, k_)        VRG_call(VRG_apply_cs, (VRG_unp c_, k_))
+#define VRG_apply(f_, n_, a_) \
+   (VRG_mapx(VRG_apply_case, (f_, n_, a_), (), f_ ## arities) f_ ## arity_error(n_))
+#if !defined(__cplusplus) && defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+typedef enum {
+  VRG_T_NONE = 0,
+  VRG_T_BOOL,   VRG_T_CHAR,   VRG_T_SCHAR,  VRG_T_UCHAR,
+  VRG_T_SHORT,  VRG_T_USHORT, VRG_T_INT,    VRG_T_UINT,
+  VRG_T_LONG,   VRG_T_ULONG,  VRG_T_LLONG,  VRG_T_ULLONG,
+  VRG_T_FLOAT,  VRG_T_DOUBLE, VRG_T_STR,    VRG_T_PTR
+} vrg_type_t;
+typedef struct {
+  vrg_type_t type;
+  union {
+             long long  i;
+    unsigned long long  u;
+                double  d;
+          const char   *s;
+          const void   *p;
+  } v;
+} vrg_val_t;
+#define VRG_val_fn(n_, t_, T_, f_) \
+  static inline vrg_val_t vrg_val_ ## n_(t_ x) { vrg_val_t r; r.type = T_; r.v.f_ = x; return r; }
+VRG_val_fn(bool,   _Bool,              VRG_T_BOOL,   i)
+VRG_val_fn(char,   char,               VRG_T_CHAR,   i)
+VRG_val_fn(schar,  signed char,        VRG_T_SCHAR,  i)
+VRG_val_fn(uchar,  unsigned char,      VRG_T_UCHAR,  u)
+VRG_val_fn(short,  short,              VRG_T_SHORT,  i)
+VRG_val_fn(ushort, unsigned short,     VRG_T_USHORT, u)
+VRG_val_fn(int,    int,                VRG_T_INT,    i)
+VRG_val_fn(uint,   unsigned int,       VRG_T_UINT,   u)
+VRG_val_fn(long,   long,               VRG_T_LONG,   i)
+VRG_val_fn(ulong,  unsigned long,      VRG_T_ULONG,  u)
+VRG_val_fn(llong,  long long,          VRG_T_LLONG,  i)
+VRG_val_fn(ullong, unsigned long long, VRG_T_ULLONG, u)
+VRG_val_fn(float,  float,              VRG_T_FLOAT,  d)
+VRG_val_fn(double, double,             VRG_T_DOUBLE, d)
+VRG_val_fn(str,    const char *,       VRG_T_STR,    s)
+VRG_val_fn(ptr,    const void *,       VRG_T_PTR,    p)
+#define vrg_val(x) \
+  _Generic((x), _Bool: vrg_val_bool,   char: vrg_val_char, \
+           signed char: vrg_val_schar, unsigned char: vrg_val_uchar, \
+                 short: vrg_val_short, unsigned short: vrg_val_ushort, \
+                   int: vrg_val_int,   unsigned int: vrg_val_uint, \
+                  long: vrg_val_long,  unsigned long: vrg_val_ulong, \
+             long long: vrg_val_llong, unsigned long long: vrg_val_ullong, \
+                 float: vrg_val_float, double: vrg_val_double, \
+                char *: vrg_val_str,   const char *: vrg_val_str, \
+               default: vrg_val_ptr)(x)
+#define VRG_pack(...)   VRG_join(VRG_pack_, VRG_sel(1,__VA_ARGS__))(__VA_ARGS__)
+#define VRG_pack_0(...) 0, (const vrg_val_t *)0
+#define VRG_pack_1(...) VRG_nargs(__VA_ARGS__), (const vrg_val_t[]){ VRG_map(vrg_val, (,), __VA_ARGS__) }
+#endif
+static inline char *vrg_utoa(char *end, unsigned long long u)
+{
+  static const char digits[] = "00010203040506070809101112131415161718192021222324"
+                               "25262728293031323334353637383940414243444546474849"
+                               "50515253545556575859606162636465666768697071727374"
+                               "75767778798081828384858687888990919293949596979899";
+  while (u >= 100) {
+    end -= 2;
+    end[0] = digits[(u % 100) * 2]; end[1] = digits[(u % 100) * 2 + 1];
+    u /= 100;
+  }
+  if (u >= 10) { end -= 2; end[0] = digits[u * 2]; end[1] = digits[u * 2 + 1]; }
+  else *--end = (char)('0' + u);
+  return end;
+}
+static inline int vrg_fixed(char *tmp, double d, int digits, int flt)
+{
+  static const double p10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  char dig[24], *p = tmp;
+  double a = d < 0 ? -d : d, q;
+  int e = 0, k, n = 0, z = 0;
+  unsigned long long m;
+  if (a < 1e-5 || a >= 1e15) return 0;
+  if (a >= 1) while (a >= p10[e + 1]) e++;
+  else while (a * p10[-e] < 1) e--;
+  if ((k = digits - 1 - e) < 0 || k > 22 || (q = a * p10[k] + 0.5) >= 9007199254740992.0) return 0;
+  m = (unsigned long long)q;
+  if (flt ? (float)(m / p10[k]) != (float)a : m / p10[k] != a) return 0;
+  do { dig[n++] = (char)('0' + m % 10); m /= 10; } while (m > 0);  // Reversed
+  while (k > 0 && dig[z] == '0') { z++; k--; }                      // No trailing zeros
+  if (d < 0) *p++ = '-';
+  if (n - z <= k) *p++ = '0';
+  while (n - z > k) *p++ = dig[--n];
+  if (k > 0) {
+    *p++ = '.';
+    for (int i = k - (n - z); i > 0; i--) *p++ = '0';
+    while (n > z) *p++ = dig[--n];
+  }
+  return (int)(p - tmp);
+}
+static inline int vrg_shortest(char *tmp, double d, int flt)
+{
+  union { double d; unsigned long long u; } bits;
+  int n;
+  if (d == 0) {
+    bits.d = d;
+    if (bits.u >> 63) { tmp[0] = '-'; tmp[1] = '0'; return 2; }
+    tmp[0] = '0';
+    return 1;
+  }
+  if ((n = vrg_fixed(tmp, d, flt ? 6 : 15, flt)) == 0 && flt) n = vrg_fixed(tmp, d, 9, 1);
+  return n;
+}
+#endif // VRG_VERSION_H
+
+#ifndef PRT_BUFSIZE
+#define PRT_BUFSIZE 4096
+#endif
+
+#ifndef PRT_FD
+#define PRT_FD 1
+#endif
+
+// ## Output
+
+typedef struct {
+  char  *buf;
+  size_t size;
+  size_t len;
+  int    fd;     // -1 for a buffer that is never written
+} prt_out_t;
+
+#define prtbuf(b_, s_)     ((prt_out_t){(b_), (s_), 0, -1})
+#define prtfd(f_, b_, s_)  ((prt_out_t){(b_), (s_), 0, (f_)})
+
+// The buffer of the thread is set at the first write: the address of a `_Thread_local`
+// is not a constant. The first thread that gets there registers the exit handler.
+static _Thread_local char      prt_tlbuf[PRT_BUFSIZE];
+static _Thread_local prt_out_t prt_tl = {NULL, 0, 0, PRT_FD};
+static atomic_flag prt_atexit_set = ATOMIC_FLAG_INIT;
+
+static void prt_write(int fd, const char *s, size_t n)
+{
+  while (n > 0) {
+    ssize_t k = write(fd, s, n);
+    if (k < 0) {
+      if (errno == EINTR) continue;
+      return;
+    }
+    s += k; n -= (size_t)k;
+  }
+}
+
+static inline void prt_flush(prt_out_t *o)
+{
+  if (o == NULL) o = &prt_tl;
+  if (o->fd >= 0 && o->len > 0) prt_write(o->fd, o->buf, o->len);
+  if (o->fd >= 0) o->len = 0;
+}
+
+#define prtflush(...) prt_flush(__VA_ARGS__+0)
+
+static void prt_atexit(void) { prt_flush(&prt_tl); }
+
+// Only called when `s` doesn't fit
+static void prt_put_slow(prt_out_t *o, const char *s, size_t n)
+{
+  if (o->fd < 0) {   // Keep what fits, count the rest
+    size_t k = o->len + 1 < o->size ? o->size - 1 - o->len : 0;
+    memcpy(o->buf + o->len, s, k < n ? k : n);
+    o->len += n;
+    return;
+  }
+  if (o->buf == NULL) {
+    o->buf = prt_tlbuf; o->size = sizeof(prt_tlbuf);
+    if (!atomic_flag_test_and_set(&prt_atexit_set)) atexit(prt_atexit);
+  }
+  else prt_flush(o);
+  if (n < o->size) {
+    memcpy(o->buf + o->len, s, n);
+    o->len += n;
+  }
+  else prt_write(o->fd, s, n);
+}
+
+static inline void prt_put(prt_out_t *o, const char *s, size_t n)
+{
+  if (o->len + n < o->size) {
+    memcpy(o->buf + o->len, s, n);
+    o->len += n;
+  }
+  else prt_put_slow(o, s, n);
+}
+
+static inline size_t prt_end(prt_out_t *o)
+{
+  if (o->size > 0) o->buf[o->len < o->size ? o->len : o->size - 1] = '\0';
+  return o->len;
+}
+
+// ## Writers
+
+static inline void prt_uint(prt_out_t *o, unsigned long long u)
+{
+  char tmp[24], *p = vrg_utoa(tmp + sizeof(tmp), u);
+  prt_put(o, p, (size_t)(tmp + sizeof(tmp) - p));
+}
+
+static inline void prt_int(prt_out_t *o, long long i)
+{
+  if (i < 0) {
+    prt_put(o, "-", 1);
+    prt_uint(o, 0 - (unsigned long long)i);
+  }
+  else prt_uint(o, (unsigned long long)i);
+}
+
+static inline void prt_real(prt_out_t *o, double d, int flt)
+{
+  char tmp[40];
+  int n;
+  if (d != d) n = (memcpy(tmp, "nan", 3), 3);
+  else if (d - d != 0) n = d < 0 ? (memcpy(tmp, "-inf", 4), 4) : (memcpy(tmp, "inf", 3), 3);
+  else if ((n = vrg_shortest(tmp, d, flt)) == 0)
+    n = snprintf(tmp, sizeof(tmp), "%.*g", flt ? 9 : 17, d);
+  if ((size_t)n < sizeof(tmp)) prt_put(o, tmp, (size_t)n);   // Always true
+}
+
+static inline void prt_double(prt_out_t *o, double d) { prt_real(o, d, 0); }
+static inline void prt_float(prt_out_t *o, float f)   { prt_real(o, f, 1); }
+
+static inline void prt_str(prt_out_t *o, const char *s)
+{
+  if (s == NULL) s = "(null)";
+  prt_put(o, s, strlen(s));
+}
+
+static inline void prt_char(prt_out_t *o, char c) { prt_put(o, &c, 1); }
+
+static inline void prt_bool(prt_out_t *o, _Bool b)
+{
+  if (b) prt_put(o, "true", 4);
+  else prt_put(o, "false", 5);
+}
+
+static inline void prt_ptr(prt_out_t *o, const void *p)
+{
+  static const char hex[] = "0123456789abcdef";
+  char tmp[2 + 2 * sizeof(uintptr_t)], *s = tmp + sizeof(tmp);
+  uintptr_t u = (uintptr_t)p;
+  do { *--s = hex[u & 0x0F]; u >>= 4; } while (u > 0);
+  *--s = 'x'; *--s = '0';
+  prt_put(o, s, (size_t)(tmp + sizeof(tmp) - s));
+}
+
+// ## Printing
+// Only the selected function is called, this is why `_Generic` returns a function
+// rather than a call (all the associations must be valid for any argument).
+
+#define prt_fn(x_) \
+  _Generic((x_), _Bool: prt_bool,  char: prt_char, \
+           signed char: prt_int,   unsigned char: prt_uint, \
+                 short: prt_int,   unsigned short: prt_uint, \
+                   int: prt_int,   unsigned int: prt_uint, \
+                  long: prt_int,   unsigned long: prt_uint, \
+             long long: prt_int,   unsigned long long: prt_uint, \
+                 float: prt_float, double: prt_double, \
+                char *: prt_str,   const char *: prt_str, \
+               default: prt_ptr)
+
+#define prt_arg(o_, x_) prt_fn(x_)(o_, x_)
+
+#define prtto(o_, ...) (VRG_mapx(prt_arg, o_, (,), __VA_ARGS__), prt_end(o_))
+#define prt(...)       ((void)prtto(&prt_tl, __VA_ARGS__))
+#define prtln(...)     ((void)prtto(&prt_tl, __VA_ARGS__, "\n"))
+
+#endif // PRT_VERSION
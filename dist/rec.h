@@ -0,0 +1,480 @@
+//.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//.  SPDX-License-Identifier: MIT
+
+//  ooooooooo.   oooooooooooo   .oooooo.
+//  `888   `Y88. `888'     `8  d8P'  `Y8b
+//   888   .d88'  888         888
+//   888ooo88P'   888oooo8    888
+//   888`88b.     888    "    888
+//   888  `88b.   888       o `88b    ooo
+//  o888o  o888o o888ooooood8  `Y8bood8P'
+
+#ifndef REC_VERSION
+#define REC_VERSION 0x0001000B // 0.1.0-beta
+
+// # Records
+//
+// Configurations, telemetry samples and messages are small structures that have to be
+// written to a file or a socket and read back, or dumped as JSON. `recdefine()` takes
+// the list of the fields of a structure, once, and defines the structure and the
+// functions to encode it in binary, to decode it and to write it as JSON:
+//
+//     recdefine(sample_t, (uint32_t, id), (double, value), (rec_str_t, unit), (point_t, pos));
+//
+//     size_t n = recencode(sample_t, &s, buf, size);   // Bytes needed (written if they fit)
+//     size_t n = recdecode(sample_t, &s, buf, len);    // Bytes read (0 if not valid)
+//     size_t n = recjson(sample_t, &s, txt, size);     // Like `snprintf()`
+//
+// The functions are expanded by `VRG_map()` one field after the other: there is no table
+// of fields to walk at runtime, and the compiler gets straight-line code for each type
+// of record, where the sizes of the fixed fields add up to a constant.
+//
+// The type of each field must be a single identifier:
+//
+//   - `int8_t` ... `int64_t`, `uint8_t` ... `uint64_t`, `float`, `double` and `bool`;
+//   - `rec_str_t` (a `const char *`) for strings;
+//   - a record type defined before with `recdefine()`.
+//
+// A record has up to 9 fields (the limit of `VRG_map()`); group them in records within
+// the record to have more.
+//
+// The binary encoding is the sequence of the fields, with no padding. Numbers are in
+// little endian, with their size. Strings are their length in 32 bits, followed by the
+// characters and a `\0`, NULL strings have length 0xFFFFFFFF. Decoded strings point into
+// the buffer, which must outlive them. When the buffer is not valid (e.g. truncated),
+// `recdecode()` returns 0 and the record is partially filled.
+//
+// In JSON, records are objects, strings are escaped and NaN and infinities are `null`.
+// Like `snprintf()`, `recjson()` returns the length of the whole text and writes as much
+// of it as fits in the buffer, always followed by a `\0`. Numbers are written with the
+// fewest digits that read back as the same value, up to 15 (6 for floats). The others
+// are written by `%.17g` (`%.9g`), whose output depends on the locale: `LC_NUMERIC`
+// must be "C" for a valid JSON.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+//.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//.  SPDX-License-Identifier: MIT
+#ifndef VRG_VERSION
+#define VRG_VERSION 0x0021000B // 0.21.0-beta
+#define VRG_jn(x,y)    VRG_exp(x ## y)
+#define VRG_join(x,y)  VRG_jn(x, y)
+#define VRG_exp(...) __VA_ARGS__
+#define VRG_count(x1,x2,x3,x4,x5,x6,x7,x8,x9,xA,xN, ...) xN
+#define VRG_nargs(...)    VRG_exp(VRG_count(__VA_ARGS__, A, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+#define VRG_ncommas(...)  VRG_exp(VRG_count(__VA_ARGS__, _, _, _, _, _, _, _, _, 1, _, _))
+#define VRG_comma(...) ,
+#define VRG_sel(x,...) \
+   VRG_join(VRG_sel_, \
+            VRG_join(VRG_ncommas(VRG_comma __VA_ARGS__ ()), VRG_ncommas(VRG_comma __VA_ARGS__ ))) (x)
+#define VRG_sel_1_(x) 0
+#define VRG_sel_11(x) x
+#define VRG_sel___(x) x
+#define vrg(f_,...)  VRG_join(f_, VRG_sel(VRG_nargs(__VA_ARGS__),__VA_ARGS__))(__VA_ARGS__)
+#define VRG_frst(x,...) x
+#define VRG_scnd(x,...) VRG_frst(__VA_ARGS__)
+#define VRG_tail(x,...) __VA_ARGS__
+#define VRG_tail2(x,...) VRG_tail(__VA_ARGS__)
+#define VRG_precomma(...) VRG_comma
+#define VRG_sel_n(x,...) \
+   VRG_join(VRG_sel_ ,VRG_ncommas(VRG_exp(VRG_precomma VRG_frst(__VA_ARGS__) () VRG_scnd(__VA_ARGS__) ())))(x)
+#define VRG_sel_1(x) x
+#define VRG_sel__(x) _
+#define vrg0(f_,...)  VRG_join(f_,VRG_sel_n(0,__VA_ARGS__))(__VA_ARGS__)
+#define vrg1(f_,...)  VRG_join(f_,VRG_sel_n(1,VRG_tail(__VA_ARGS__)))(__VA_ARGS__)
+#define vrg2(f_,...)  VRG_join(f_,VRG_sel_n(2,VRG_tail2(__VA_ARGS__)))(__VA_ARGS__)
+#define vrg_(f_,...)  vrg0(f_,...)
+#define VRG_kwargs(t_,...) ((t_){ t_ ## _defaults, __VA_ARGS__ })
+#define VRG_unp(...) __VA_ARGS__
+#define VRG_map_ap(m_,c_,i_,x_)  m_(x_)
+#define VRG_mapi_ap(m_,c_,i_,x_) m_(i_,x_)
+#define VRG_mapx_ap(m_,c_,i_,x_) m_(c_,x_)
+#define VRG_map_0(a_,m_,c_,s_,...)
+#define VRG_map_1(a_,m_,c_,s_,x0)                         a_(m_,c_,0,x0)
+#define VRG_map_2(a_,m_,c_,s_,x0,x1)                      VRG_map_1(a_,m_,c_,s_,x0) VRG_unp s_ a_(m_,c_,1,x1)
+#define VRG_map_3(a_,m_,c_,s_,x0,x1,x2)                   VRG_map_2(a_,m_,c_,s_,x0,x1) VRG_unp s_ a_(m_,c_,2,x2)
+#define VRG_map_4(a_,m_,c_,s_,x0,x1,x2,x3)                VRG_map_3(a_,m_,c_,s_,x0,x1,x2) VRG_unp s_ a_(m_,c_,3,x3)
+#define VRG_map_5(a_,m_,c_,s_,x0,x1,x2,x3,x4)             VRG_map_4(a_,m_,c_,s_,x0,x1,x2,x3) VRG_unp s_ a_(m_,c_,4,x4)
+#define VRG_map_6(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5)          VRG_map_5(a_,m_,c_,s_,x0,x1,x2,x3,x4) VRG_unp s_ a_(m_,c_,5,x5)
+#define VRG_map_7(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6)       VRG_map_6(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5) VRG_unp s_ a_(m_,c_,6,x6)
+#define VRG_map_8(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7)    VRG_map_7(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6) VRG_unp s_ a_(m_,c_,7,x7)
+#define VRG_map_9(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7,x8) VRG_map_8(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7) VRG_unp s_ a_(m_,c_,8,x8)
+#define VRG_map_go(a_,m_,c_,s_,...) \
+   VRG_join(VRG_map_, VRG_sel(VRG_nargs(__VA_ARGS__),__VA_ARGS__))(a_,m_,c_,s_,__VA_ARGS__)
+#define VRG_map(m_,s_,...)      VRG_map_go(VRG_map_ap,  m_, ~,  s_, __VA_ARGS__)
+#define VRG_mapi(m_,s_,...)     VRG_map_go(VRG_mapi_ap, m_, ~,  s_, __VA_ARGS__)
+#define VRG_mapx(m_,c_,s_,...)  VRG_map_go(VRG_mapx_ap, m_, c_, s_, __VA_ARGS__)
+#define VRG_foreach(m_,...)     VRG_map_go(VRG_map_ap,  m_, ~, (;), __VA_ARGS__)
+#define VRG_drop_0(...)                            __VA_ARGS__
+#define VRG_drop_1(x0,...)                         __VA_ARGS__
+#define VRG_drop_2(x0,x1,...)                      __VA_ARGS__
+#define VRG_drop_3(x0,x1,x2,...)                   __VA_ARGS__
+#define VRG_drop_4(x0,x1,x2,x3,...)                __VA_ARGS__
+#define VRG_drop_5(x0,x1,x2,x3,x4,...)             __VA_ARGS__
+#define VRG_drop_6(x0,x1,x2,x3,x4,x5,...)          __VA_ARGS__
+#define VRG_drop_7(x0,x1,x2,x3,x4,x5,x6,...)       __VA_ARGS__
+#define VRG_drop_8(x0,x1,x2,x3,x4,x5,x6,x7,...)    __VA_ARGS__
+#define VRG_drop_9(x0,x1,x2,x3,x4,x5,x6,x7,x8,...) __VA_ARGS__
+#define VRG_dflt_1(n_)      n_ ## _is_required
+#define VRG_dflt_2(n_,d_)   d_
+#define VRG_dflt(p_)        VRG_join(VRG_dflt_, VRG_nargs p_) p_
+#define VRG_dflt_next(p_)   , VRG_dflt(p_)
+#define VRG_defaults(f_,p_,...)   VRG_join(VRG_defaults_, VRG_sel(1,__VA_ARGS__))(f_,p_,__VA_ARGS__)
+#define VRG_defaults_0(f_,p_,...) f_(VRG_map(VRG_dflt, (,), VRG_unp p_))
+#define VRG_defaults_1(f_,p_,...) \
+   f_(__VA_ARGS__ VRG_map(VRG_dflt_next, (), VRG_join(VRG_drop_, VRG_nargs(__VA_ARGS__)) p_))
+#define VRG_args_0(a_)
+#define VRG_args_1(a_) (a_)[0]
+#define VRG_args_2(a_) VRG_args_1(a_), (a_)[1]
+#define VRG_args_3(a_) VRG_args_2(a_), (a_)[2]
+#define VRG_args_4(a_) VRG_args_3(a_), (a_)[3]
+#define VRG_args_5(a_) VRG_args_4(a_), (a_)[4]
+#define VRG_args_6(a_) VRG_args_5(a_), (a_)[5]
+#define VRG_args_7(a_) VRG_args_6(a_), (a_)[6]
+#define VRG_args_8(a_) VRG_args_7(a_), (a_)[7]
+#define VRG_args_9(a_) VRG_args_8(a_), (a_)[8]
+#define VRG_call(m_, args_) m_ args_
+#define VRG_apply_go(m_, args_) m_ args_  // Not VRG_call(): it would not expand inside itself
+#define VRG_apply_cs(f_, n_, a_, k_)  (n_) == k_ ? VRG_apply_go(VRG_join(f_, k_), (VRG_join(VRG_args_, k_)(a_))) :
+#define VRG_apply_case(c_, k_)        VRG_call(VRG_apply_cs, (VRG_unp c_, k_))
+#define VRG_apply(f_, n_, a_) \
+   (VRG_mapx(VRG_apply_case, (f_, n_, a_), (), f_ ## arities) f_ ## arity_error(n_))
+#if !defined(__cplusplus) && defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+typedef enum {
+  VRG_T_NONE = 0,
+  VRG_T_BOOL,   VRG_T_CHAR,   VRG_T_SCHAR,  VRG_T_UCHAR,
+  VRG_T_SHORT,  VRG_T_USHORT, VRG_T_INT,    VRG_T_UINT,
+  VRG_T_LONG,   VRG_T_ULONG,  VRG_T_LLONG,  VRG_T_ULLONG,
+  VRG_T_FLOAT,  VRG_T_DOUBLE, VRG_T_STR,    VRG_T_PTR
+} vrg_type_t;
+typedef struct {
+  vrg_type_t type;
+  union {
+             long long  i;
+    unsigned long long  u;
+                double  d;
+          const char   *s;
+          const void   *p;
+  } v;
+} vrg_val_t;
+#define VRG_val_fn(n_, t_, T_, f_) \
+  static inline vrg_val_t vrg_val_ ## n_(t_ x) { vrg_val_t r; r.type = T_; r.v.f_ = x; return r; }
+VRG_val_fn(bool,   _Bool,              VRG_T_BOOL,   i)
+VRG_val_fn(char,   char,               VRG_T_CHAR,   i)
+VRG_val_fn(schar,  signed char,        VRG_T_SCHAR,  i)
+VRG_val_fn(uchar,  unsigned char,      VRG_T_UCHAR,  u)
+VRG_val_fn(short,  short,              VRG_T_SHORT,  i)
+VRG_val_fn(ushort, unsigned short,     VRG_T_USHORT, u)
+VRG_val_fn(int,    int,                VRG_T_INT,    i)
+VRG_val_fn(uint,   unsigned int,       VRG_T_UINT,   u)
+VRG_val_fn(long,   long,               VRG_T_LONG,   i)
+VRG_val_fn(ulong,  unsigned long,      VRG_T_ULONG,  u)
+VRG_val_fn(llong,  long long,          VRG_T_LLONG,  i)
+VRG_val_fn(ullong, unsigned long long, VRG_T_ULLONG, u)
+VRG_val_fn(float,  float,              VRG_T_FLOAT,  d)
+VRG_val_fn(double, double,             VRG_T_DOUBLE, d)
+VRG_val_fn(str,    const char *,       VRG_T_STR,    s)
+VRG_val_fn(ptr,    const void *,       VRG_T_PTR,    p)
+#define vrg_val(x) \
+  _Generic((x), _Bool: vrg_val_bool,   char: vrg_val_char, \
+           signed char: vrg_val_schar, unsigned char: vrg_val_uchar, \
+                 short: vrg_val_short, unsigned short: vrg_val_ushort, \
+                   int: vrg_val_int,   unsigned int: vrg_val_uint, \
+                  long: vrg_val_long,  unsigned long: vrg_val_ulong, \
+             long long: vrg_val_llong, unsigned long long: vrg_val_ullong, \
+                 float: vrg_val_float, double: vrg_val_double, \
+                char *: vrg_val_str,   const char *: vrg_val_str, \
+               default: vrg_val_ptr)(x)
+#define VRG_pack(...)   VRG_join(VRG_pack_, VRG_sel(1,__VA_ARGS__))(__VA_ARGS__)
+#define VRG_pack_0(...) 0, (const vrg_val_t *)0
+#define VRG_pack_1(...) VRG_nargs(__VA_ARGS__), (const vrg_val_t[]){ VRG_map(vrg_val, (,), __VA_ARGS__) }
+#endif
+static inline char *vrg_utoa(char *end, unsigned long long u)
+{
+  static const char digits[] = "00010203040506070809101112131415161718192021222324"
+                               "25262728293031323334353637383940414243444546474849"
+                               "50515253545556575859606162636465666768697071727374"
+                               "75767778798081828384858687888990919293949596979899";
+  while (u >= 100) {
+    end -= 2;
+    end[0] = digits[(u % 100) * 2]; end[1] = digits[(u % 100) * 2 + 1];
+    u /= 100;
+  }
+  if (u >= 10) { end -= 2; end[0] = digits[u * 2]; end[1] = digits[u * 2 + 1]; }
+  else *--end = (char)('0' + u);
+  return end;
+}
+static inline int vrg_fixed(char *tmp, double d, int digits, int flt)
+{
+  static const double p10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  char dig[24], *p = tmp;
+  double a = d < 0 ? -d : d, q;
+  int e = 0, k, n = 0, z = 0;
+  unsigned long long m;
+  if (a < 1e-5 || a >= 1e15) return 0;
+  if (a >= 1) while (a >= p10[e + 1]) e++;
+  else while (a * p10[-e] < 1) e--;
+  if ((k = digits - 1 - e) < 0 || k > 22 || (q = a * p10[k] + 0.5) >= 9007199254740992.0) return 0;
+  m = (unsigned long long)q;
+  if (flt ? (float)(m / p10[k]) != (float)a : m / p10[k] != a) return 0;
+  do { dig[n++] = (char)('0' + m % 10); m /= 10; } while (m > 0);  // Reversed
+  while (k > 0 && dig[z] == '0') { z++; k--; }                      // No trailing zeros
+  if (d < 0) *p++ = '-';
+  if (n - z <= k) *p++ = '0';
+  while (n - z > k) *p++ = dig[--n];
+  if (k > 0) {
+    *p++ = '.';
+    for (int i = k - (n - z); i > 0; i--) *p++ = '0';
+    while (n > z) *p++ = dig[--n];
+  }
+  return (int)(p - tmp);
+}
+static inline int vrg_shortest(char *tmp, double d, int flt)
+{
+  union { double d; unsigned long long u; } bits;
+  int n;
+  if (d == 0) {
+    bits.d = d;
+    if (bits.u >> 63) { tmp[0] = '-'; tmp[1] = '0'; return 2; }
+    tmp[0] = '0';
+    return 1;
+  }
+  if ((n = vrg_fixed(tmp, d, flt ? 6 : 15, flt)) == 0 && flt) n = vrg_fixed(tmp, d, 9, 1);
+  return n;
+}
+#endif // VRG_VERSION_H
+
+typedef const char *rec_str_t;
+
+// ## Binary encoding
+
+static inline unsigned char *rec_put_raw(unsigned char *p, const void *x, size_t n)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  for (size_t k = 0; k < n; k++) p[k] = ((const unsigned char *)x)[n - 1 - k];
+#else
+  memcpy(p, x, n);
+#endif
+  return p + n;
+}
+
+// Returns NULL if there aren't `n` bytes left (or if `p` is already NULL)
+static inline const unsigned char *rec_get_raw(const unsigned char *p, const unsigned char *e, void *x, size_t n)
+{
+  if (p == NULL || (size_t)(e - p) < n) return NULL;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  for (size_t k = 0; k < n; k++) ((unsigned char *)x)[k] = p[n - 1 - k];
+#else
+  memcpy(x, p, n);
+#endif
+  return p + n;
+}
+
+// ## JSON
+
+typedef struct {
+  char  *buf;
+  size_t size;
+  size_t len;    // Of the whole text, even if it doesn't fit
+} rec_out_t;
+
+static inline void rec_putn(rec_out_t *o, const char *s, size_t n)
+{
+  if (o->len + n < o->size) memcpy(o->buf + o->len, s, n);
+  else if (o->len + 1 < o->size) memcpy(o->buf + o->len, s, o->size - 1 - o->len);
+  o->len += n;
+}
+
+static inline void rec_jint(rec_out_t *o, uint64_t u, int neg)
+{
+  char tmp[24], *p = vrg_utoa(tmp + sizeof(tmp), u);
+  if (neg) *--p = '-';
+  rec_putn(o, p, (size_t)(tmp + sizeof(tmp) - p));
+}
+
+#define rec_jsigned(o_, x_)   rec_jint(o_, (x_) < 0 ? 0 - (uint64_t)(x_) : (uint64_t)(x_), (x_) < 0)
+#define rec_junsigned(o_, x_) rec_jint(o_, (uint64_t)(x_), 0)
+
+// The shortest fixed form that reads back as the same value (see `vrg_shortest()`),
+// `%.17g` (`%.9g` for floats) if there's none. A JSON reader gets back the same value.
+static inline void rec_jdouble(rec_out_t *o, double d, int flt)
+{
+  char tmp[40];
+  int n;
+  if (d != d || d - d != 0) {
+    rec_putn(o, "null", 4);
+    return;
+  }
+  if ((n = vrg_shortest(tmp, d, flt)) == 0)
+    n = snprintf(tmp, sizeof(tmp), "%.*g", flt ? 9 : 17, d);
+  if ((size_t)n < sizeof(tmp)) rec_putn(o, tmp, (size_t)n);   // Always true
+}
+
+static inline void rec_jstr(rec_out_t *o, const char *s)
+{
+  static const char hex[] = "0123456789abcdef";
+  const char *b;
+  char esc[6] = {'\\', 'u', '0', '0'};
+  if (s == NULL) {
+    rec_putn(o, "null", 4);
+    return;
+  }
+  rec_putn(o, "\"", 1);
+  for (;;) {
+    for (b = s; (unsigned char)*s >= 0x20 && *s != '"' && *s != '\\'; s++) ;
+    rec_putn(o, b, (size_t)(s - b));
+    if (*s == '\0') break;
+    if (*s == '"' || *s == '\\') {
+      esc[1] = *s;
+      rec_putn(o, esc, 2);
+    }
+    else {
+      esc[1] = 'u';
+      esc[4] = hex[(*s >> 4) & 0x0F];
+      esc[5] = hex[*s & 0x0F];
+      rec_putn(o, esc, 6);
+    }
+    s++;
+  }
+  rec_putn(o, "\"", 1);
+}
+
+static inline void rec_end(rec_out_t *o)
+{
+  if (o->size > 0) o->buf[o->len < o->size ? o->len : o->size - 1] = '\0';
+}
+
+// ## Fields
+// For each type `T`, `rec_size_T()`, `rec_put_T()`, `rec_get_T()` and `rec_json_T()`
+// are the size of the encoding, the encoder, the decoder and the JSON writer.
+
+#define REC_number(T_, J_) \
+  static inline size_t rec_size_##T_(const T_ *x) { (void)x; return sizeof(T_); } \
+  static inline unsigned char *rec_put_##T_(unsigned char *p, const T_ *x) \
+    { return rec_put_raw(p, x, sizeof(T_)); } \
+  static inline const unsigned char *rec_get_##T_(const unsigned char *p, const unsigned char *e, T_ *x) \
+    { return rec_get_raw(p, e, x, sizeof(T_)); } \
+  static inline void rec_json_##T_(rec_out_t *o, const T_ *x) { J_; }
+
+REC_number(int8_t,   rec_jsigned(o, *x))
+REC_number(int16_t,  rec_jsigned(o, *x))
+REC_number(int32_t,  rec_jsigned(o, *x))
+REC_number(int64_t,  rec_jsigned(o, *x))
+REC_number(uint8_t,  rec_junsigned(o, *x))
+REC_number(uint16_t, rec_junsigned(o, *x))
+REC_number(uint32_t, rec_junsigned(o, *x))
+REC_number(uint64_t, rec_junsigned(o, *x))
+REC_number(float,    rec_jdouble(o, *x, 1))
+REC_number(double,   rec_jdouble(o, *x, 0))
+
+// A byte that is not 0 or 1 is not a valid `_Bool`: it's converted
+static inline size_t rec_size__Bool(const _Bool *x) { (void)x; return 1; }
+
+static inline unsigned char *rec_put__Bool(unsigned char *p, const _Bool *x)
+{
+  *p = (unsigned char)*x;
+  return p + 1;
+}
+
+static inline const unsigned char *rec_get__Bool(const unsigned char *p, const unsigned char *e, _Bool *x)
+{
+  if (p == NULL || p >= e) return NULL;
+  *x = (*p != 0);
+  return p + 1;
+}
+
+static inline void rec_json__Bool(rec_out_t *o, const _Bool *x)
+{
+  if (*x) rec_putn(o, "true", 4);
+  else rec_putn(o, "false", 5);
+}
+
+// `bool` is a keyword in C23, a macro for `_Bool` before
+#define rec_size_bool rec_size__Bool
+#define rec_put_bool  rec_put__Bool
+#define rec_get_bool  rec_get__Bool
+#define rec_json_bool rec_json__Bool
+
+#define REC_NULL_STR 0xFFFFFFFFu
+
+static inline size_t rec_size_rec_str_t(const rec_str_t *x)
+{
+  return *x ? 4 + strlen(*x) + 1 : 4;
+}
+
+static inline unsigned char *rec_put_rec_str_t(unsigned char *p, const rec_str_t *x)
+{
+  uint32_t n = *x ? (uint32_t)strlen(*x) : REC_NULL_STR;
+  p = rec_put_raw(p, &n, 4);
+  if (*x == NULL) return p;
+  memcpy(p, *x, (size_t)n + 1);
+  return p + n + 1;
+}
+
+static inline const unsigned char *rec_get_rec_str_t(const unsigned char *p, const unsigned char *e, rec_str_t *x)
+{
+  uint32_t n;
+  if ((p = rec_get_raw(p, e, &n, 4)) == NULL) return NULL;
+  if (n == REC_NULL_STR) {
+    *x = NULL;
+    return p;
+  }
+  if ((size_t)(e - p) <= n || p[n] != '\0') return NULL;
+  *x = (rec_str_t)p;
+  return p + n + 1;
+}
+
+static inline void rec_json_rec_str_t(rec_out_t *o, const rec_str_t *x) { rec_jstr(o, *x); }
+
+// ## Records
+// Each field is a pair `(type, name)`, unpacked with `VRG_call()`. The functions of the
+// record have the same form as the ones of the fields, so that records can be fields.
+
+#define rec_fld_decl(f_)        VRG_call(rec_fld_decl_, f_)
+#define rec_fld_decl_(T_, n_)   T_ n_
+
+#define rec_fld_size(f_)        + VRG_call(rec_fld_size_, f_)
+#define rec_fld_size_(T_, n_)   rec_size_##T_(&r->n_)
+
+#define rec_fld_put(f_)         VRG_call(rec_fld_put_, f_)
+#define rec_fld_put_(T_, n_)    p = rec_put_##T_(p, &r->n_);
+
+#define rec_fld_get(f_)         VRG_call(rec_fld_get_, f_)
+#define rec_fld_get_(T_, n_)    p = rec_get_##T_(p, e, &r->n_);
+
+// The name of the first field is not preceded by a comma
+#define rec_fld_json(i_, f_)    VRG_call(rec_fld_json_, (i_, VRG_unp f_))
+#define rec_fld_json_(i_, T_, n_) \
+  rec_putn(o, ",\"" #n_ "\":" + ((i_) == 0), sizeof(",\"" #n_ "\":") - 1 - ((i_) == 0)); \
+  rec_json_##T_(o, &r->n_);
+
+#define recdefine(T_, ...) \
+  typedef struct { VRG_foreach(rec_fld_decl, __VA_ARGS__); } T_; \
+  static inline size_t rec_size_##T_(const T_ *r) \
+    { return 0 VRG_map(rec_fld_size, (), __VA_ARGS__); } \
+  static inline unsigned char *rec_put_##T_(unsigned char *p, const T_ *r) \
+    { VRG_map(rec_fld_put, (), __VA_ARGS__) return p; } \
+  static inline const unsigned char *rec_get_##T_(const unsigned char *p, const unsigned char *e, T_ *r) \
+    { VRG_map(rec_fld_get, (), __VA_ARGS__) return p; } \
+  static inline void rec_json_##T_(rec_out_t *o, const T_ *r) \
+    { rec_putn(o, "{", 1); VRG_mapi(rec_fld_json, (), __VA_ARGS__) rec_putn(o, "}", 1); } \
+  static inline size_t rec_encode_##T_(const T_ *r, void *buf, size_t size) \
+    { size_t n = rec_size_##T_(r); if (n <= size) rec_put_##T_((unsigned char *)buf, r); return n; } \
+  static inline size_t rec_decode_##T_(T_ *r, const void *buf, size_t len) \
+    { const unsigned char *b = (const unsigned char *)buf, *p = rec_get_##T_(b, b + len, r); \
+      return p ? (size_t)(p - b) : 0; } \
+  static inline size_t rec_tojson_##T_(const T_ *r, char *buf, size_t size) \
+    { rec_out_t o = {buf, size, 0}; rec_json_##T_(&o, r); rec_end(&o); return o.len; } \
+  static inline size_t rec_size_##T_(const T_ *r)  // Takes the `;` after `recdefine()`
+
+#define recsize(T_, r_)                 rec_size_##T_(r_)
+#define recencode(T_, r_, buf_, size_)  rec_encode_##T_(r_, buf_, size_)
+#define recdecode(T_, r_, buf_, len_)   rec_decode_##T_(r_, buf_, len_)
+#define recjson(T_, r_, buf_, size_)    rec_tojson_##T_(r_, buf_, size_)
+
+#endif // REC_VERSION
@@ -0,0 +1,557 @@
+//.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//.  SPDX-License-Identifier: MIT
+
+//  ooooooooooooo ooooooooo.     .oooooo.
+//  8'   888   `8 `888   `Y88.  d8P'  `Y8b
+//       888       888   .d88' 888
+//       888       888ooo88P'  888
+//       888       888`88b.    888
+//       888       888  `88b.  `88b    ooo
+//      o888o     o888o  o888o  `Y8bood8P'
+
+#ifndef TRC_VERSION
+#define TRC_VERSION 0x0001000B // 0.1.0-beta
+
+// # Deferred tracing
+//
+// Tracing with `fprintf()` formats the message and makes (at least) one system call
+// for each trace: with heavy tracing, that's where the time goes.
+//
+// The `trc` functions only record the format string and the arguments (as a
+// `VRG_pack()`) into a ring buffer that belongs to the calling thread. Formatting and
+// writing happen later, in bulk:
+//
+//   - when `trcflush()` is called,
+//   - when the ring buffer of a thread is full (by that thread),
+//   - at exit,
+//   - periodically, if the background flusher is started with `trcstart()`.
+//
+//     #include "trc.h"
+//
+//     trcdebug("x = %d, name = %s", x, name);
+//     trcinfo("Starting");
+//
+// Messages are written as `cli_trace()` does: the formatted message followed by
+// ` :file:line`. Messages from the same thread are written in order; there's no
+// ordering between messages from different threads.
+//
+// Each record holds up to 9 arguments. Strings are copied in the record (up to
+// `TRC_STRBUF` bytes for all the strings of a record) so they don't need to live until
+// the flush. Any other pointer is just stored (`%p`).
+//
+// `trc.h` requires C11 (`_Thread_local`, `<stdatomic.h>` and `_Generic`). The background
+// flusher requires POSIX threads and must be enabled by defining `TRC_FLUSHER`.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+//.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//.  SPDX-License-Identifier: MIT
+#ifndef VRG_VERSION
+#define VRG_VERSION 0x0021000B // 0.21.0-beta
+#define VRG_jn(x,y)    VRG_exp(x ## y)
+#define VRG_join(x,y)  VRG_jn(x, y)
+#define VRG_exp(...) __VA_ARGS__
+#define VRG_count(x1,x2,x3,x4,x5,x6,x7,x8,x9,xA,xN, ...) xN
+#define VRG_nargs(...)    VRG_exp(VRG_count(__VA_ARGS__, A, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+#define VRG_ncommas(...)  VRG_exp(VRG_count(__VA_ARGS__, _, _, _, _, _, _, _, _, 1, _, _))
+#define VRG_comma(...) ,
+#define VRG_sel(x,...) \
+   VRG_join(VRG_sel_, \
+            VRG_join(VRG_ncommas(VRG_comma __VA_ARGS__ ()), VRG_ncommas(VRG_comma __VA_ARGS__ ))) (x)
+#define VRG_sel_1_(x) 0
+#define VRG_sel_11(x) x
+#define VRG_sel___(x) x
+#define vrg(f_,...)  VRG_join(f_, VRG_sel(VRG_nargs(__VA_ARGS__),__VA_ARGS__))(__VA_ARGS__)
+#define VRG_frst(x,...) x
+#define VRG_scnd(x,...) VRG_frst(__VA_ARGS__)
+#define VRG_tail(x,...) __VA_ARGS__
+#define VRG_tail2(x,...) VRG_tail(__VA_ARGS__)
+#define VRG_precomma(...) VRG_comma
+#define VRG_sel_n(x,...) \
+   VRG_join(VRG_sel_ ,VRG_ncommas(VRG_exp(VRG_precomma VRG_frst(__VA_ARGS__) () VRG_scnd(__VA_ARGS__) ())))(x)
+#define VRG_sel_1(x) x
+#define VRG_sel__(x) _
+#define vrg0(f_,...)  VRG_join(f_,VRG_sel_n(0,__VA_ARGS__))(__VA_ARGS__)
+#define vrg1(f_,...)  VRG_join(f_,VRG_sel_n(1,VRG_tail(__VA_ARGS__)))(__VA_ARGS__)
+#define vrg2(f_,...)  VRG_join(f_,VRG_sel_n(2,VRG_tail2(__VA_ARGS__)))(__VA_ARGS__)
+#define vrg_(f_,...)  vrg0(f_,...)
+#define VRG_kwargs(t_,...) ((t_){ t_ ## _defaults, __VA_ARGS__ })
+#define VRG_unp(...) __VA_ARGS__
+#define VRG_map_ap(m_,c_,i_,x_)  m_(x_)
+#define VRG_mapi_ap(m_,c_,i_,x_) m_(i_,x_)
+#define VRG_mapx_ap(m_,c_,i_,x_) m_(c_,x_)
+#define VRG_map_0(a_,m_,c_,s_,...)
+#define VRG_map_1(a_,m_,c_,s_,x0)                         a_(m_,c_,0,x0)
+#define VRG_map_2(a_,m_,c_,s_,x0,x1)                      VRG_map_1(a_,m_,c_,s_,x0) VRG_unp s_ a_(m_,c_,1,x1)
+#define VRG_map_3(a_,m_,c_,s_,x0,x1,x2)                   VRG_map_2(a_,m_,c_,s_,x0,x1) VRG_unp s_ a_(m_,c_,2,x2)
+#define VRG_map_4(a_,m_,c_,s_,x0,x1,x2,x3)                VRG_map_3(a_,m_,c_,s_,x0,x1,x2) VRG_unp s_ a_(m_,c_,3,x3)
+#define VRG_map_5(a_,m_,c_,s_,x0,x1,x2,x3,x4)             VRG_map_4(a_,m_,c_,s_,x0,x1,x2,x3) VRG_unp s_ a_(m_,c_,4,x4)
+#define VRG_map_6(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5)          VRG_map_5(a_,m_,c_,s_,x0,x1,x2,x3,x4) VRG_unp s_ a_(m_,c_,5,x5)
+#define VRG_map_7(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6)       VRG_map_6(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5) VRG_unp s_ a_(m_,c_,6,x6)
+#define VRG_map_8(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7)    VRG_map_7(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6) VRG_unp s_ a_(m_,c_,7,x7)
+#define VRG_map_9(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7,x8) VRG_map_8(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7) VRG_unp s_ a_(m_,c_,8,x8)
+#define VRG_map_go(a_,m_,c_,s_,...) \
+   VRG_join(VRG_map_, VRG_sel(VRG_nargs(__VA_ARGS__),__VA_ARGS__))(a_,m_,c_,s_,__VA_ARGS__)
+#define VRG_map(m_,s_,...)      VRG_map_go(VRG_map_ap,  m_, ~,  s_, __VA_ARGS__)
+#define VRG_mapi(m_,s_,...)     VRG_map_go(VRG_mapi_ap, m_, ~,  s_, __VA_ARGS__)
+#define VRG_mapx(m_,c_,s_,...)  VRG_map_go(VRG_mapx_ap, m_, c_, s_, __VA_ARGS__)
+#define VRG_foreach(m_,...)     VRG_map_go(VRG_map_ap,  m_, ~, (;), __VA_ARGS__)
+#define VRG_drop_0(...)                            __VA_ARGS__
+#define VRG_drop_1(x0,...)                         __VA_ARGS__
+#define VRG_drop_2(x0,x1,...)                      __VA_ARGS__
+#define VRG_drop_3(x0,x1,x2,...)                   __VA_ARGS__
+#define VRG_drop_4(x0,x1,x2,x3,...)                __VA_ARGS__
+#define VRG_drop_5(x0,x1,x2,x3,x4,...)             __VA_ARGS__
+#define VRG_drop_6(x0,x1,x2,x3,x4,x5,...)          __VA_ARGS__
+#define VRG_drop_7(x0,x1,x2,x3,x4,x5,x6,...)       __VA_ARGS__
+#define VRG_drop_8(x0,x1,x2,x3,x4,x5,x6,x7,...)    __VA_ARGS__
+#define VRG_drop_9(x0,x1,x2,x3,x4,x5,x6,x7,x8,...) __VA_ARGS__
+#define VRG_dflt_1(n_)      n_ ## _is_required
+#define VRG_dflt_2(n_,d_)   d_
+#define VRG_dflt(p_)        VRG_join(VRG_dflt_, VRG_nargs p_) p_
+#define VRG_dflt_next(p_)   , VRG_dflt(p_)
+#define VRG_defaults(f_,p_,...)   VRG_join(VRG_defaults_, VRG_sel(1,__VA_ARGS__))(f_,p_,__VA_ARGS__)
+#define VRG_defaults_0(f_,p_,...) f_(VRG_map(VRG_dflt, (,), VRG_unp p_))
+#define VRG_defaults_1(f_,p_,...) \
+   f_(__VA_ARGS__ VRG_map(VRG_dflt_next, (), VRG_join(VRG_drop_, VRG_nargs(__VA_ARGS__)) p_))
+#define VRG_args_0(a_)
+#define VRG_args_1(a_) (a_)[0]
+#define VRG_args_2(a_) VRG_args_1(a_), (a_)[1]
+#define VRG_args_3(a_) VRG_args_2(a_), (a_)[2]
+#define VRG_args_4(a_) VRG_args_3(a_), (a_)[3]
+#define VRG_args_5(a_) VRG_args_4(a_), (a_)[4]
+#define VRG_args_6(a_) VRG_args_5(a_), (a_)[5]
+#define VRG_args_7(a_) VRG_args_6(a_), (a_)[6]
+#define VRG_args_8(a_) VRG_args_7(a_), (a_)[7]
+#define VRG_args_9(a_) VRG_args_8(a_), (a_)[8]
+#define VRG_call(m_, args_) m_ args_
+#define VRG_apply_go(m_, args_) m_ args_  // Not VRG_call(): it would not expand inside itself
+#define VRG_apply_cs(f_, n_, a_, k_)  (n_) == k_ ? VRG_apply_go(VRG_join(f_, k_), (VRG_join(VRG_args_, k_)(a_))) :
+#define VRG_apply_case(c_, k_)        VRG_call(VRG_apply_cs, (VRG_unp c_, k_))
+#define VRG_apply(f_, n_, a_) \
+   (VRG_mapx(VRG_apply_case, (f_, n_, a_), (), f_ ## arities) f_ ## arity_error(n_))
+#if !defined(__cplusplus) && defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+typedef enum {
+  VRG_T_NONE = 0,
+  VRG_T_BOOL,   VRG_T_CHAR,   VRG_T_SCHAR,  VRG_T_UCHAR,
+  VRG_T_SHORT,  VRG_T_USHORT, VRG_T_INT,    VRG_T_UINT,
+  VRG_T_LONG,   VRG_T_ULONG,  VRG_T_LLONG,  VRG_T_ULLONG,
+  VRG_T_FLOAT,  VRG_T_DOUBLE, VRG_T_STR,    VRG_T_PTR
+} vrg_type_t;
+typedef struct {
+  vrg_type_t type;
+  union {
+             long long  i;
+    unsigned long long  u;
+                double  d;
+          const char   *s;
+          const void   *p;
+  } v;
+} vrg_val_t;
+#define VRG_val_fn(n_, t_, T_, f_) \
+  static inline vrg_val_t vrg_val_ ## n_(t_ x) { vrg_val_t r; r.type = T_; r.v.f_ = x; return r; }
+VRG_val_fn(bool,   _Bool,              VRG_T_BOOL,   i)
+VRG_val_fn(char,   char,               VRG_T_CHAR,   i)
+VRG_val_fn(schar,  signed char,        VRG_T_SCHAR,  i)
+VRG_val_fn(uchar,  unsigned char,      VRG_T_UCHAR,  u)
+VRG_val_fn(short,  short,              VRG_T_SHORT,  i)
+VRG_val_fn(ushort, unsigned short,     VRG_T_USHORT, u)
+VRG_val_fn(int,    int,                VRG_T_INT,    i)
+VRG_val_fn(uint,   unsigned int,       VRG_T_UINT,   u)
+VRG_val_fn(long,   long,               VRG_T_LONG,   i)
+VRG_val_fn(ulong,  unsigned long,      VRG_T_ULONG,  u)
+VRG_val_fn(llong,  long long,          VRG_T_LLONG,  i)
+VRG_val_fn(ullong, unsigned long long, VRG_T_ULLONG, u)
+VRG_val_fn(float,  float,              VRG_T_FLOAT,  d)
+VRG_val_fn(double, double,             VRG_T_DOUBLE, d)
+VRG_val_fn(str,    const char *,       VRG_T_STR,    s)
+VRG_val_fn(ptr,    const void *,       VRG_T_PTR,    p)
+#define vrg_val(x) \
+  _Generic((x), _Bool: vrg_val_bool,   char: vrg_val_char, \
+           signed char: vrg_val_schar, unsigned char: vrg_val_uchar, \
+                 short: vrg_val_short, unsigned short: vrg_val_ushort, \
+                   int: vrg_val_int,   unsigned int: vrg_val_uint, \
+                  long: vrg_val_long,  unsigned long: vrg_val_ulong, \
+             long long: vrg_val_llong, unsigned long long: vrg_val_ullong, \
+                 float: vrg_val_float, double: vrg_val_double, \
+                char *: vrg_val_str,   const char *: vrg_val_str, \
+               default: vrg_val_ptr)(x)
+#define VRG_pack(...)   VRG_join(VRG_pack_, VRG_sel(1,__VA_ARGS__))(__VA_ARGS__)
+#define VRG_pack_0(...) 0, (const vrg_val_t *)0
+#define VRG_pack_1(...) VRG_nargs(__VA_ARGS__), (const vrg_val_t[]){ VRG_map(vrg_val, (,), __VA_ARGS__) }
+#endif
+static inline char *vrg_utoa(char *end, unsigned long long u)
+{
+  static const char digits[] = "00010203040506070809101112131415161718192021222324"
+                               "25262728293031323334353637383940414243444546474849"
+                               "50515253545556575859606162636465666768697071727374"
+                               "75767778798081828384858687888990919293949596979899";
+  while (u >= 100) {
+    end -= 2;
+    end[0] = digits[(u % 100) * 2]; end[1] = digits[(u % 100) * 2 + 1];
+    u /= 100;
+  }
+  if (u >= 10) { end -= 2; end[0] = digits[u * 2]; end[1] = digits[u * 2 + 1]; }
+  else *--end = (char)('0' + u);
+  return end;
+}
+static inline int vrg_fixed(char *tmp, double d, int digits, int flt)
+{
+  static const double p10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  char dig[24], *p = tmp;
+  double a = d < 0 ? -d : d, q;
+  int e = 0, k, n = 0, z = 0;
+  unsigned long long m;
+  if (a < 1e-5 || a >= 1e15) return 0;
+  if (a >= 1) while (a >= p10[e + 1]) e++;
+  else while (a * p10[-e] < 1) e--;
+  if ((k = digits - 1 - e) < 0 || k > 22 || (q = a * p10[k] + 0.5) >= 9007199254740992.0) return 0;
+  m = (unsigned long long)q;
+  if (flt ? (float)(m / p10[k]) != (float)a : m / p10[k] != a) return 0;
+  do { dig[n++] = (char)('0' + m % 10); m /= 10; } while (m > 0);  // Reversed
+  while (k > 0 && dig[z] == '0') { z++; k--; }                      // No trailing zeros
+  if (d < 0) *p++ = '-';
+  if (n - z <= k) *p++ = '0';
+  while (n - z > k) *p++ = dig[--n];
+  if (k > 0) {
+    *p++ = '.';
+    for (int i = k - (n - z); i > 0; i--) *p++ = '0';
+    while (n > z) *p++ = dig[--n];
+  }
+  return (int)(p - tmp);
+}
+static inline int vrg_shortest(char *tmp, double d, int flt)
+{
+  union { double d; unsigned long long u; } bits;
+  int n;
+  if (d == 0) {
+    bits.d = d;
+    if (bits.u >> 63) { tmp[0] = '-'; tmp[1] = '0'; return 2; }
+    tmp[0] = '0';
+    return 1;
+  }
+  if ((n = vrg_fixed(tmp, d, flt ? 6 : 15, flt)) == 0 && flt) n = vrg_fixed(tmp, d, 9, 1);
+  return n;
+}
+#endif // VRG_VERSION_H
+
+// ## Levels
+// Levels are filtered at compile time: traces below `TRC_LEVEL` expand to nothing.
+// By default, debug traces are disabled if `NDEBUG` is defined.
+
+#define TRC_DEBUG 0
+#define TRC_INFO  1
+#define TRC_WARN  2
+#define TRC_ERROR 3
+#define TRC_NONE  4
+
+#ifndef TRC_LEVEL
+#ifdef NDEBUG
+#define TRC_LEVEL TRC_INFO
+#else
+#define TRC_LEVEL TRC_DEBUG
+#endif
+#endif
+
+#if TRC_LEVEL <= TRC_DEBUG
+#define trcdebug(...) trc_log(TRC_DEBUG, __VA_ARGS__)
+#else
+#define trcdebug(...) ((void)0)
+#endif
+
+#if TRC_LEVEL <= TRC_INFO
+#define trcinfo(...)  trc_log(TRC_INFO, __VA_ARGS__)
+#else
+#define trcinfo(...)  ((void)0)
+#endif
+
+#if TRC_LEVEL <= TRC_WARN
+#define trcwarn(...)  trc_log(TRC_WARN, __VA_ARGS__)
+#else
+#define trcwarn(...)  ((void)0)
+#endif
+
+#if TRC_LEVEL <= TRC_ERROR
+#define trcerror(...) trc_log(TRC_ERROR, __VA_ARGS__)
+#else
+#define trcerror(...) ((void)0)
+#endif
+
+#define trc_log(l_, f_, ...) trc_push(l_, __FILE__, __LINE__, "" f_, VRG_pack(__VA_ARGS__))
+
+// ## Ring buffers
+// Each thread gets its own ring buffer the first time it traces. Rings are never
+// freed and are linked in a list so that the flusher can find them.
+// The owner thread is the only one writing records (and advancing `head`); the
+// flusher is the only one consuming them (and advancing `tail`). No lock is needed
+// on the hot path: the flushers (`trcflush()`, the background thread, a thread whose
+// ring is full) take turns through `trc_lock`.
+
+#ifndef TRC_RING_SIZE
+#define TRC_RING_SIZE 512
+#endif
+
+#ifndef TRC_STRBUF
+#define TRC_STRBUF 96
+#endif
+
+#define TRC_MAXARGS 9
+
+typedef struct {
+  const char    *fmt;
+  const char    *file;
+  int            line;
+  unsigned char  level;
+  unsigned char  argc;
+  vrg_val_t      argv[TRC_MAXARGS];
+  char           sbuf[TRC_STRBUF];
+} trc_rec_t;
+
+typedef struct trc_ring_s {
+  struct trc_ring_s *next;
+  _Atomic size_t     head;
+  char               pad[64];  // Keep `head` and `tail` on different cache lines
+  _Atomic size_t     tail;
+  trc_rec_t          rec[TRC_RING_SIZE];
+} trc_ring_t;
+
+static FILE *trc_out = NULL; // Where the traces are written (`stderr` if NULL)
+
+static _Atomic(trc_ring_t *) trc_rings = NULL;
+static _Thread_local trc_ring_t *trc_my_ring = NULL;
+static atomic_flag trc_lock = ATOMIC_FLAG_INIT;
+
+static const char *trc_level_str[] = {"", "INFO: ", "WARNING: ", "ERROR: "};
+
+// ## Formatting
+// Each conversion specification is rebuilt using the actual type of the argument, so
+// a wrong format (e.g. `%d` for a string) prints the value rather than causing
+// undefined behaviour. Length modifiers in the format string are ignored, `*` for
+// width or precision is not supported.
+
+// Plain `%d` and `%s` (no flags, width or precision) are, by far, the most common
+// conversions and don't need `snprintf()`.
+static int trc_fmt_fast(char *buf, int size, const vrg_val_t *arg)
+{
+  char tmp[24];
+  const char *s = tmp;
+  int len = 0;
+
+  switch (arg->type) {
+    case VRG_T_FLOAT: case VRG_T_DOUBLE: case VRG_T_PTR: case VRG_T_CHAR:
+      return -1;
+
+    case VRG_T_STR:
+      s = arg->v.s;
+      len = (int)strlen(s);
+      break;
+
+    default: {
+      int neg = 0;
+      unsigned long long u = arg->v.u;
+      char *p;
+      switch (arg->type) {
+        case VRG_T_UCHAR: case VRG_T_USHORT: case VRG_T_UINT:
+        case VRG_T_ULONG: case VRG_T_ULLONG: break;
+        default: if (arg->v.i < 0) { neg = 1; u = 0 - u; }
+      }
+      p = vrg_utoa(tmp + sizeof(tmp), u);
+      if (neg) *--p = '-';
+      s = p; len = (int)(tmp + sizeof(tmp) - p);
+    }
+  }
+  if (len >= size) len = size - 1;
+  memcpy(buf, s, len);
+  return len;
+}
+
+static int trc_fmt_arg(char *buf, int size, char *spec, int len, char conv, const vrg_val_t *arg)
+{
+  int n;
+  if (len == 1 && (conv == 'd' || conv == 'i' || conv == 's' || conv == 'u')
+               && (n = trc_fmt_fast(buf, size, arg)) >= 0)
+    return n;
+
+  switch (arg->type) {
+    case VRG_T_FLOAT: case VRG_T_DOUBLE:
+      spec[len++] = strchr("fFeEgGaA", conv) ? conv : 'g'; spec[len] = '\0';
+      return snprintf(buf, size, spec, arg->v.d);
+
+    case VRG_T_STR:
+      spec[len++] = 's'; spec[len] = '\0';
+      return snprintf(buf, size, spec, arg->v.s);
+
+    case VRG_T_PTR:
+      spec[len++] = 'p'; spec[len] = '\0';
+      return snprintf(buf, size, spec, arg->v.p);
+
+    case VRG_T_UCHAR: case VRG_T_USHORT: case VRG_T_UINT:
+    case VRG_T_ULONG: case VRG_T_ULLONG:
+      if (conv == 'c') break;
+      spec[len++] = 'l'; spec[len++] = 'l';
+      spec[len++] = strchr("ouxX", conv) ? conv : 'u'; spec[len] = '\0';
+      return snprintf(buf, size, spec, arg->v.u);
+
+    default:
+      if (conv == 'c') break;
+      spec[len++] = 'l'; spec[len++] = 'l';
+      spec[len++] = strchr("diouxX", conv) ? conv : 'd'; spec[len] = '\0';
+      return snprintf(buf, size, spec, arg->v.i);
+  }
+  spec[len++] = 'c'; spec[len] = '\0';
+  return snprintf(buf, size, spec, (int)arg->v.i);
+}
+
+static int trc_format(char *buf, int size, const trc_rec_t *rec)
+{
+  const char *f = rec->fmt;
+  char spec[32];
+  int n = 0, k = 0, len;
+
+  n += trc_fmt_fast(buf, size, &(vrg_val_t){VRG_T_STR, {.s = trc_level_str[rec->level]}});
+  while (*f && n < size) {
+    if (*f != '%') {
+      const char *p = strchr(f, '%');
+      len = p ? (int)(p - f) : (int)strlen(f);
+      if (len > size - n) len = size - n;
+      memcpy(buf + n, f, len);
+      n += len; f += len;
+      continue;
+    }
+    if (f[1] == '%') { buf[n++] = '%'; f += 2; continue; }
+
+    len = 0;
+    spec[len++] = *f++;
+    while (*f && strchr("-+ #0123456789.", *f) && len < 24) spec[len++] = *f++;
+    while (*f && strchr("hljztL", *f)) f++;
+    if (*f == '\0') break;
+
+    if (k < rec->argc) n += trc_fmt_arg(buf+n, size-n, spec, len, *f, &rec->argv[k++]);
+    f++;
+  }
+  if (n < size) n += trc_fmt_fast(buf+n, size-n, &(vrg_val_t){VRG_T_STR, {.s = " :"}});
+  if (n < size) n += trc_fmt_fast(buf+n, size-n, &(vrg_val_t){VRG_T_STR, {.s = rec->file}});
+  if (n < size) buf[n++] = ':';
+  if (n < size) n += trc_fmt_fast(buf+n, size-n, &(vrg_val_t){VRG_T_INT, {.i = rec->line}});
+  if (n < size) buf[n++] = '\n';
+  if (n >= size) { n = size-1; buf[n-1] = '\n'; }
+  return n;
+}
+
+// ## Flushing
+// Records are formatted in a local buffer that is written with one `fwrite()` when
+// full, rather than one call for each record.
+
+#define TRC_OUTBUF 8192
+
+static void trc_flush_ring(trc_ring_t *r, char *out, int *n)
+{
+  size_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+  size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+  FILE *f = trc_out ? trc_out : stderr;
+
+  while (tail != head) {
+    if (*n > TRC_OUTBUF - 1024) { fwrite(out, 1, *n, f); *n = 0; }
+    *n += trc_format(out + *n, 1024, &r->rec[tail % TRC_RING_SIZE]);
+    tail++;
+  }
+  atomic_store_explicit(&r->tail, tail, memory_order_release);
+}
+
+static void trcflush(void)
+{
+  char out[TRC_OUTBUF];
+  int n = 0;
+
+  while (atomic_flag_test_and_set_explicit(&trc_lock, memory_order_acquire)) ;
+  for (trc_ring_t *r = atomic_load(&trc_rings); r != NULL; r = r->next)
+    trc_flush_ring(r, out, &n);
+  if (n > 0) {
+    FILE *f = trc_out ? trc_out : stderr;
+    fwrite(out, 1, n, f);
+    fflush(f);
+  }
+  atomic_flag_clear_explicit(&trc_lock, memory_order_release);
+}
+
+static trc_ring_t *trc_new_ring(void)
+{
+  trc_ring_t *r = calloc(1, sizeof(trc_ring_t));
+  if (r == NULL) return NULL;
+
+  r->next = atomic_load(&trc_rings);
+  while (!atomic_compare_exchange_weak(&trc_rings, &r->next, r)) ;
+
+  if (r->next == NULL) atexit(trcflush); // The first ring ever
+  return (trc_my_ring = r);
+}
+
+// ## Recording
+// This is the hot path: no system call and no formatting, unless the ring is full.
+
+static inline void trc_push(int level, const char *file, int line, const char *fmt,
+                            int argc, const vrg_val_t *argv)
+{
+  trc_ring_t *r = trc_my_ring ? trc_my_ring : trc_new_ring();
+  if (r == NULL) return;
+
+  size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+  if (head - atomic_load_explicit(&r->tail, memory_order_acquire) >= TRC_RING_SIZE)
+    trcflush();
+
+  trc_rec_t *rec = &r->rec[head % TRC_RING_SIZE];
+  rec->fmt   = fmt;
+  rec->file  = file;
+  rec->line  = line;
+  rec->level = (unsigned char)level;
+  rec->argc  = (unsigned char)(argc < TRC_MAXARGS ? argc : TRC_MAXARGS);
+
+  int s = 0;
+  for (int k = 0; k < rec->argc; k++) {
+    rec->argv[k] = argv[k];
+    if (argv[k].type == VRG_T_STR) {
+      const char *str = argv[k].v.s ? argv[k].v.s : "(null)";
+      int len = (int)strlen(str);
+      if (len > TRC_STRBUF - 1 - s) len = TRC_STRBUF - 1 - s;
+      memcpy(rec->sbuf + s, str, len);
+      rec->sbuf[s + len] = '\0';
+      rec->argv[k].v.s = rec->sbuf + s;
+      s += len + (s + len < TRC_STRBUF - 1);
+    }
+  }
+  atomic_store_explicit(&r->head, head + 1, memory_order_release);
+}
+
+// ## Background flusher
+// `trcstart(ms)` starts a thread that flushes the rings every `ms` milliseconds.
+
+#ifdef TRC_FLUSHER
+#include <pthread.h>
+#include <time.h>
+
+static void *trc_flusher(void *arg)
+{
+  long ms = (long)(size_t)arg;
+  struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+  for (;;) {
+    nanosleep(&ts, NULL);
+    trcflush();
+  }
+  return NULL;
+}
+
+static inline int trcstart(long ms)
+{
+  pthread_t t;
+  if (ms <= 0) ms = 100;
+  if (pthread_create(&t, NULL, trc_flusher, (void *)(size_t)ms) != 0) return 0;
+  pthread_detach(t);
+  return 1;
+}
+#endif
+
+#endif // TRC_VERSION
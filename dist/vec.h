@@ -0,0 +1,310 @@
+//.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//.  SPDX-License-Identifier: MIT
+
+//  oooooo     oooo oooooooooooo   .oooooo.
+//   `888.     .8'  `888'     `8  d8P'  `Y8b
+//    `888.   .8'    888         888
+//     `888. .8'     888oooo8    888
+//      `888.8'      888    "    888
+//       `888'       888       o `88b    ooo
+//        `8'       o888ooooood8  `Y8bood8P'
+
+#ifndef VEC_VERSION
+#define VEC_VERSION 0x0001000B // 0.1.0-beta
+
+// # Dynamic vectors
+//
+// A vector of elements of any type, with the first elements stored in the vector
+// itself: most vectors in a program are small, and they never call `malloc()`.
+// When they grow beyond that, the capacity doubles each time, so pushing `n` elements
+// one by one costs `O(log n)` allocations, not `n`.
+//
+//     typedef vec_t(int) intvec_t;         // Inline storage of VEC_SMALL bytes
+//     typedef vec_t(point_t, 4) ptvec_t;   // Inline storage of 4 elements
+//
+//     intvec_t v;
+//     vecinit(&v);
+//     vecpush(&v, 42);                     // Push one element
+//     vecpush(&v, array, 10);              // Push 10 elements from `array`
+//     int *p = vecpush(&v);                // Reserve one element, return a pointer to it
+//     vecreserve(&v, 1000);                // Make room for 1000 more elements
+//     for (size_t k = 0; k < v.len; k++) printf("%d\n", v.data[k]);
+//     vecfree(&v);
+//
+// The overloads of `vecpush()` (and of `vec_t()`) are selected by `vrg()`: there is no
+// dispatch at runtime. The common case of pushing one element in a vector that has room
+// for it is inlined as a comparison and a store.
+//
+// The fields of the vector are meant to be read directly: `data` (the elements), `len`
+// (how many they are) and `cap` (how many fit before the next allocation). `vecpush()`
+// returns a pointer to the first element pushed, or NULL if the memory can't be
+// allocated (the vector is unchanged); `vecreserve()` returns 0 in that case.
+//
+// As `data` may point to the vector itself, vectors can't be copied by assignment. The
+// arguments of the macros can be evaluated more than once, and a compound literal
+// must be enclosed in parentheses: `vecpush(&v, ((point_t){1, 2}))`.
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+//.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//.  SPDX-License-Identifier: MIT
+#ifndef VRG_VERSION
+#define VRG_VERSION 0x0021000B // 0.21.0-beta
+#define VRG_jn(x,y)    VRG_exp(x ## y)
+#define VRG_join(x,y)  VRG_jn(x, y)
+#define VRG_exp(...) __VA_ARGS__
+#define VRG_count(x1,x2,x3,x4,x5,x6,x7,x8,x9,xA,xN, ...) xN
+#define VRG_nargs(...)    VRG_exp(VRG_count(__VA_ARGS__, A, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+#define VRG_ncommas(...)  VRG_exp(VRG_count(__VA_ARGS__, _, _, _, _, _, _, _, _, 1, _, _))
+#define VRG_comma(...) ,
+#define VRG_sel(x,...) \
+   VRG_join(VRG_sel_, \
+            VRG_join(VRG_ncommas(VRG_comma __VA_ARGS__ ()), VRG_ncommas(VRG_comma __VA_ARGS__ ))) (x)
+#define VRG_sel_1_(x) 0
+#define VRG_sel_11(x) x
+#define VRG_sel___(x) x
+#define vrg(f_,...)  VRG_join(f_, VRG_sel(VRG_nargs(__VA_ARGS__),__VA_ARGS__))(__VA_ARGS__)
+#define VRG_frst(x,...) x
+#define VRG_scnd(x,...) VRG_frst(__VA_ARGS__)
+#define VRG_tail(x,...) __VA_ARGS__
+#define VRG_tail2(x,...) VRG_tail(__VA_ARGS__)
+#define VRG_precomma(...) VRG_comma
+#define VRG_sel_n(x,...) \
+   VRG_join(VRG_sel_ ,VRG_ncommas(VRG_exp(VRG_precomma VRG_frst(__VA_ARGS__) () VRG_scnd(__VA_ARGS__) ())))(x)
+#define VRG_sel_1(x) x
+#define VRG_sel__(x) _
+#define vrg0(f_,...)  VRG_join(f_,VRG_sel_n(0,__VA_ARGS__))(__VA_ARGS__)
+#define vrg1(f_,...)  VRG_join(f_,VRG_sel_n(1,VRG_tail(__VA_ARGS__)))(__VA_ARGS__)
+#define vrg2(f_,...)  VRG_join(f_,VRG_sel_n(2,VRG_tail2(__VA_ARGS__)))(__VA_ARGS__)
+#define vrg_(f_,...)  vrg0(f_,...)
+#define VRG_kwargs(t_,...) ((t_){ t_ ## _defaults, __VA_ARGS__ })
+#define VRG_unp(...) __VA_ARGS__
+#define VRG_map_ap(m_,c_,i_,x_)  m_(x_)
+#define VRG_mapi_ap(m_,c_,i_,x_) m_(i_,x_)
+#define VRG_mapx_ap(m_,c_,i_,x_) m_(c_,x_)
+#define VRG_map_0(a_,m_,c_,s_,...)
+#define VRG_map_1(a_,m_,c_,s_,x0)                         a_(m_,c_,0,x0)
+#define VRG_map_2(a_,m_,c_,s_,x0,x1)                      VRG_map_1(a_,m_,c_,s_,x0) VRG_unp s_ a_(m_,c_,1,x1)
+#define VRG_map_3(a_,m_,c_,s_,x0,x1,x2)                   VRG_map_2(a_,m_,c_,s_,x0,x1) VRG_unp s_ a_(m_,c_,2,x2)
+#define VRG_map_4(a_,m_,c_,s_,x0,x1,x2,x3)                VRG_map_3(a_,m_,c_,s_,x0,x1,x2) VRG_unp s_ a_(m_,c_,3,x3)
+#define VRG_map_5(a_,m_,c_,s_,x0,x1,x2,x3,x4)             VRG_map_4(a_,m_,c_,s_,x0,x1,x2,x3) VRG_unp s_ a_(m_,c_,4,x4)
+#define VRG_map_6(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5)          VRG_map_5(a_,m_,c_,s_,x0,x1,x2,x3,x4) VRG_unp s_ a_(m_,c_,5,x5)
+#define VRG_map_7(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6)       VRG_map_6(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5) VRG_unp s_ a_(m_,c_,6,x6)
+#define VRG_map_8(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7)    VRG_map_7(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6) VRG_unp s_ a_(m_,c_,7,x7)
+#define VRG_map_9(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7,x8) VRG_map_8(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7) VRG_unp s_ a_(m_,c_,8,x8)
+#define VRG_map_go(a_,m_,c_,s_,...) \
+   VRG_join(VRG_map_, VRG_sel(VRG_nargs(__VA_ARGS__),__VA_ARGS__))(a_,m_,c_,s_,__VA_ARGS__)
+#define VRG_map(m_,s_,...)      VRG_map_go(VRG_map_ap,  m_, ~,  s_, __VA_ARGS__)
+#define VRG_mapi(m_,s_,...)     VRG_map_go(VRG_mapi_ap, m_, ~,  s_, __VA_ARGS__)
+#define VRG_mapx(m_,c_,s_,...)  VRG_map_go(VRG_mapx_ap, m_, c_, s_, __VA_ARGS__)
+#define VRG_foreach(m_,...)     VRG_map_go(VRG_map_ap,  m_, ~, (;), __VA_ARGS__)
+#define VRG_drop_0(...)                            __VA_ARGS__
+#define VRG_drop_1(x0,...)                         __VA_ARGS__
+#define VRG_drop_2(x0,x1,...)                      __VA_ARGS__
+#define VRG_drop_3(x0,x1,x2,...)                   __VA_ARGS__
+#define VRG_drop_4(x0,x1,x2,x3,...)                __VA_ARGS__
+#define VRG_drop_5(x0,x1,x2,x3,x4,...)             __VA_ARGS__
+#define VRG_drop_6(x0,x1,x2,x3,x4,x5,...)          __VA_ARGS__
+#define VRG_drop_7(x0,x1,x2,x3,x4,x5,x6,...)       __VA_ARGS__
+#define VRG_drop_8(x0,x1,x2,x3,x4,x5,x6,x7,...)    __VA_ARGS__
+#define VRG_drop_9(x0,x1,x2,x3,x4,x5,x6,x7,x8,...) __VA_ARGS__
+#define VRG_dflt_1(n_)      n_ ## _is_required
+#define VRG_dflt_2(n_,d_)   d_
+#define VRG_dflt(p_)        VRG_join(VRG_dflt_, VRG_nargs p_) p_
+#define VRG_dflt_next(p_)   , VRG_dflt(p_)
+#define VRG_defaults(f_,p_,...)   VRG_join(VRG_defaults_, VRG_sel(1,__VA_ARGS__))(f_,p_,__VA_ARGS__)
+#define VRG_defaults_0(f_,p_,...) f_(VRG_map(VRG_dflt, (,), VRG_unp p_))
+#define VRG_defaults_1(f_,p_,...) \
+   f_(__VA_ARGS__ VRG_map(VRG_dflt_next, (), VRG_join(VRG_drop_, VRG_nargs(__VA_ARGS__)) p_))
+#define VRG_args_0(a_)
+#define VRG_args_1(a_) (a_)[0]
+#define VRG_args_2(a_) VRG_args_1(a_), (a_)[1]
+#define VRG_args_3(a_) VRG_args_2(a_), (a_)[2]
+#define VRG_args_4(a_) VRG_args_3(a_), (a_)[3]
+#define VRG_args_5(a_) VRG_args_4(a_), (a_)[4]
+#define VRG_args_6(a_) VRG_args_5(a_), (a_)[5]
+#define VRG_args_7(a_) VRG_args_6(a_), (a_)[6]
+#define VRG_args_8(a_) VRG_args_7(a_), (a_)[7]
+#define VRG_args_9(a_) VRG_args_8(a_), (a_)[8]
+#define VRG_call(m_, args_) m_ args_
+#define VRG_apply_go(m_, args_) m_ args_  // Not VRG_call(): it would not expand inside itself
+#define VRG_apply_cs(f_, n_, a_, k_)  (n_) == k_ ? VRG_apply_go(VRG_join(f_, k_), (VRG_join(VRG_args_, k_)(a_))) :
+#define VRG_apply_case(c_, k_)        VRG_call(VRG_apply_cs, (VRG_unp c_, k_))
+#define VRG_apply(f_, n_, a_) \
+   (VRG_mapx(VRG_apply_case, (f_, n_, a_), (), f_ ## arities) f_ ## arity_error(n_))
+#if !defined(__cplusplus) && defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+typedef enum {
+  VRG_T_NONE = 0,
+  VRG_T_BOOL,   VRG_T_CHAR,   VRG_T_SCHAR,  VRG_T_UCHAR,
+  VRG_T_SHORT,  VRG_T_USHORT, VRG_T_INT,    VRG_T_UINT,
+  VRG_T_LONG,   VRG_T_ULONG,  VRG_T_LLONG,  VRG_T_ULLONG,
+  VRG_T_FLOAT,  VRG_T_DOUBLE, VRG_T_STR,    VRG_T_PTR
+} vrg_type_t;
+typedef struct {
+  vrg_type_t type;
+  union {
+             long long  i;
+    unsigned long long  u;
+                double  d;
+          const char   *s;
+          const void   *p;
+  } v;
+} vrg_val_t;
+#define VRG_val_fn(n_, t_, T_, f_) \
+  static inline vrg_val_t vrg_val_ ## n_(t_ x) { vrg_val_t r; r.type = T_; r.v.f_ = x; return r; }
+VRG_val_fn(bool,   _Bool,              VRG_T_BOOL,   i)
+VRG_val_fn(char,   char,               VRG_T_CHAR,   i)
+VRG_val_fn(schar,  signed char,        VRG_T_SCHAR,  i)
+VRG_val_fn(uchar,  unsigned char,      VRG_T_UCHAR,  u)
+VRG_val_fn(short,  short,              VRG_T_SHORT,  i)
+VRG_val_fn(ushort, unsigned short,     VRG_T_USHORT, u)
+VRG_val_fn(int,    int,                VRG_T_INT,    i)
+VRG_val_fn(uint,   unsigned int,       VRG_T_UINT,   u)
+VRG_val_fn(long,   long,               VRG_T_LONG,   i)
+VRG_val_fn(ulong,  unsigned long,      VRG_T_ULONG,  u)
+VRG_val_fn(llong,  long long,          VRG_T_LLONG,  i)
+VRG_val_fn(ullong, unsigned long long, VRG_T_ULLONG, u)
+VRG_val_fn(float,  float,              VRG_T_FLOAT,  d)
+VRG_val_fn(double, double,             VRG_T_DOUBLE, d)
+VRG_val_fn(str,    const char *,       VRG_T_STR,    s)
+VRG_val_fn(ptr,    const void *,       VRG_T_PTR,    p)
+#define vrg_val(x) \
+  _Generic((x), _Bool: vrg_val_bool,   char: vrg_val_char, \
+           signed char: vrg_val_schar, unsigned char: vrg_val_uchar, \
+                 short: vrg_val_short, unsigned short: vrg_val_ushort, \
+                   int: vrg_val_int,   unsigned int: vrg_val_uint, \
+                  long: vrg_val_long,  unsigned long: vrg_val_ulong, \
+             long long: vrg_val_llong, unsigned long long: vrg_val_ullong, \
+                 float: vrg_val_float, double: vrg_val_double, \
+                char *: vrg_val_str,   const char *: vrg_val_str, \
+               default: vrg_val_ptr)(x)
+#define VRG_pack(...)   VRG_join(VRG_pack_, VRG_sel(1,__VA_ARGS__))(__VA_ARGS__)
+#define VRG_pack_0(...) 0, (const vrg_val_t *)0
+#define VRG_pack_1(...) VRG_nargs(__VA_ARGS__), (const vrg_val_t[]){ VRG_map(vrg_val, (,), __VA_ARGS__) }
+#endif
+static inline char *vrg_utoa(char *end, unsigned long long u)
+{
+  static const char digits[] = "00010203040506070809101112131415161718192021222324"
+                               "25262728293031323334353637383940414243444546474849"
+                               "50515253545556575859606162636465666768697071727374"
+                               "75767778798081828384858687888990919293949596979899";
+  while (u >= 100) {
+    end -= 2;
+    end[0] = digits[(u % 100) * 2]; end[1] = digits[(u % 100) * 2 + 1];
+    u /= 100;
+  }
+  if (u >= 10) { end -= 2; end[0] = digits[u * 2]; end[1] = digits[u * 2 + 1]; }
+  else *--end = (char)('0' + u);
+  return end;
+}
+static inline int vrg_fixed(char *tmp, double d, int digits, int flt)
+{
+  static const double p10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  char dig[24], *p = tmp;
+  double a = d < 0 ? -d : d, q;
+  int e = 0, k, n = 0, z = 0;
+  unsigned long long m;
+  if (a < 1e-5 || a >= 1e15) return 0;
+  if (a >= 1) while (a >= p10[e + 1]) e++;
+  else while (a * p10[-e] < 1) e--;
+  if ((k = digits - 1 - e) < 0 || k > 22 || (q = a * p10[k] + 0.5) >= 9007199254740992.0) return 0;
+  m = (unsigned long long)q;
+  if (flt ? (float)(m / p10[k]) != (float)a : m / p10[k] != a) return 0;
+  do { dig[n++] = (char)('0' + m % 10); m /= 10; } while (m > 0);  // Reversed
+  while (k > 0 && dig[z] == '0') { z++; k--; }                      // No trailing zeros
+  if (d < 0) *p++ = '-';
+  if (n - z <= k) *p++ = '0';
+  while (n - z > k) *p++ = dig[--n];
+  if (k > 0) {
+    *p++ = '.';
+    for (int i = k - (n - z); i > 0; i--) *p++ = '0';
+    while (n > z) *p++ = dig[--n];
+  }
+  return (int)(p - tmp);
+}
+static inline int vrg_shortest(char *tmp, double d, int flt)
+{
+  union { double d; unsigned long long u; } bits;
+  int n;
+  if (d == 0) {
+    bits.d = d;
+    if (bits.u >> 63) { tmp[0] = '-'; tmp[1] = '0'; return 2; }
+    tmp[0] = '0';
+    return 1;
+  }
+  if ((n = vrg_fixed(tmp, d, flt ? 6 : 15, flt)) == 0 && flt) n = vrg_fixed(tmp, d, 9, 1);
+  return n;
+}
+#endif // VRG_VERSION_H
+
+// ## The vector type
+
+#ifndef VEC_SMALL
+#define VEC_SMALL 64  // Bytes of inline storage for `vec_t(T)`
+#endif
+
+#define vec_t(...) vrg(vec_t_, __VA_ARGS__)
+#define vec_t_1(T_) vec_t_2(T_, VEC_SMALL / sizeof(T_) > 0 ? VEC_SMALL / sizeof(T_) : 1)
+#define vec_t_2(T_, N_) \
+  struct { union { T_ *data; void *ptr; }; size_t len; size_t cap; T_ small[N_]; }
+
+#define vec_small_cap(v_) (sizeof((v_)->small) / sizeof((v_)->small[0]))
+
+#define vecinit(v_)  ((v_)->data = (v_)->small, (v_)->len = 0, (v_)->cap = vec_small_cap(v_))
+#define vecfree(v_)  ((v_)->data != (v_)->small ? free((v_)->ptr) : (void)0, vecinit(v_))
+#define vecclear(v_) ((v_)->len = 0)
+#define vecpop(v_)   ((v_)->data[--(v_)->len])
+
+// ## Growing
+
+// Makes room for `more` elements of `size` bytes after the `len` ones. The elements are
+// moved out of the inline storage (`small`) the first time it's not enough.
+static inline int vec_grow(void **data, void *small, size_t len, size_t *cap, size_t more, size_t size)
+{
+  size_t n = *cap ? *cap : 1, need;
+  void *p;
+  if (more > (size_t)-1 - len) return 0;   // `len + more` would wrap around
+  need = len + more;
+  if (need > (size_t)-1 / 2 / size) return 0;
+  while (n < need) n *= 2;
+  if (*data == small) {
+    if ((p = malloc(n * size)) == NULL) return 0;
+    memcpy(p, small, len * size);
+  }
+  else if ((p = realloc(*data, n * size)) == NULL) return 0;
+  *data = p;
+  *cap = n;
+  return 1;
+}
+
+#define vecreserve(v_, n_) \
+  ((v_)->cap - (v_)->len >= (size_t)(n_) || \
+   vec_grow(&(v_)->ptr, (v_)->small, (v_)->len, &(v_)->cap, (n_), sizeof((v_)->data[0])))
+
+// ## Pushing
+
+#define vecpush(...) vrg(vec_push_, __VA_ARGS__)
+
+// Reserve one element
+#define vec_push_1(v_) \
+  (vecreserve(v_, 1) ? &(v_)->data[(v_)->len++] : NULL)
+
+// Push one element
+#define vec_push_2(v_, x_) \
+  (vecreserve(v_, 1) ? ((v_)->data[(v_)->len] = (x_), &(v_)->data[(v_)->len++]) : NULL)
+
+// Push `n_` elements from the array `p_`
+#define vec_push_3(v_, p_, n_) \
+  (vecreserve(v_, n_) ? (vec_append((v_)->data, &(v_)->len, (p_), (n_), sizeof((v_)->data[0])), \
+                         &(v_)->data[(v_)->len - (n_)]) : NULL)
+
+static inline void vec_append(void *data, size_t *len, const void *src, size_t n, size_t size)
+{
+  if (n > 0) memcpy((char *)data + *len * size, src, n * size);
+  *len += n;
+}
+
+#endif // VEC_VERSION
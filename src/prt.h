@@ -0,0 +1,233 @@
+//.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//.  SPDX-License-Identifier: MIT
+
+//  ooooooooo.   ooooooooo.   ooooooooooooo
+//  `888   `Y88. `888   `Y88. 8'   888   `8
+//   888   .d88'  888   .d88'      888
+//   888ooo88P'   888ooo88P'       888
+//   888          888`88b.         888
+//   888          888  `88b.       888
+//  o888o        o888o  o888o     o888o
+
+#ifndef PRT_VERSION
+#define PRT_VERSION 0x0001000B // 0.1.0-beta
+
+// # Typed print
+//
+// `printf()` parses its format string at each call to find out, from the conversions,
+// the types of its arguments. The compiler already knows them: `prt()` takes the values
+// to write, in order, and `_Generic` picks the writer for each of them at compile time.
+//
+//     prt("x = ", x, ", ratio = ", r, ", name = ", name, "\n");
+//     prtln("done in ", ms, " ms");                     // Followed by a '\n'
+//
+//     char buf[64];
+//     prt_out_t o = prtbuf(buf, sizeof(buf));
+//     size_t n = prtto(&o, "id=", id, " v=", v);       // Like `snprintf()`
+//
+// Values are written as:
+//
+//   - integers: in decimal (`char` as a character, `_Bool` as `true` or `false`);
+//   - `float` and `double`: with the fewest digits that read back as the same value, up
+//     to 15 (6 for floats), as in `1.5`, `0.1` or `-0.001`. The others (very large or
+//     very small values) are written by `%.17g` (`%.9g`). Zero keeps its sign (`-0`);
+//   - strings (`char *`): as they are, `(null)` for NULL;
+//   - any other pointer: in hexadecimal, as `0x7ffc10`.
+//
+// Character constants like `'a'` are `int` in C and are written as numbers.
+//
+// `prt()` and `prtln()` write into a buffer of `PRT_BUFSIZE` bytes that belongs to the
+// calling thread (and to the source file). It's written to the file descriptor `PRT_FD`
+// (the standard output) with one `write()`:
+//
+//   - when it's full,
+//   - when `prtflush()` is called,
+//   - at exit (for the thread that calls `exit()`: other threads must call `prtflush()`).
+//
+// This is not the `stdio` buffer: when mixing `prt()` and `printf()`, flush one before
+// using the other.
+//
+// `prtto(o, ...)` writes into a `prt_out_t`: a buffer of the caller (`prtbuf()`), where the
+// text is truncated and terminated as `snprintf()` does, or a buffer of the caller that is
+// written to a file descriptor when full (`prtfd()`). It returns the length of the text in
+// the buffer (for `prtbuf()`, even the part that didn't fit).
+//
+// Up to 9 values (8 for `prtln()`) for each call; the output argument of `prtto()` is
+// evaluated more than once.
+//
+// `prt.h` requires C11 (`_Generic`, `_Thread_local` and `<stdatomic.h>`) and `write()`
+// from POSIX.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "vrg.h"
+
+#ifndef PRT_BUFSIZE
+#define PRT_BUFSIZE 4096
+#endif
+
+#ifndef PRT_FD
+#define PRT_FD 1
+#endif
+
+// ## Output
+
+typedef struct {
+  char  *buf;
+  size_t size;
+  size_t len;
+  int    fd;     // -1 for a buffer that is never written
+} prt_out_t;
+
+#define prtbuf(b_, s_)     ((prt_out_t){(b_), (s_), 0, -1})
+#define prtfd(f_, b_, s_)  ((prt_out_t){(b_), (s_), 0, (f_)})
+
+// The buffer of the thread is set at the first write: the address of a `_Thread_local`
+// is not a constant. The first thread that gets there registers the exit handler.
+static _Thread_local char      prt_tlbuf[PRT_BUFSIZE];
+static _Thread_local prt_out_t prt_tl = {NULL, 0, 0, PRT_FD};
+static atomic_flag prt_atexit_set = ATOMIC_FLAG_INIT;
+
+static void prt_write(int fd, const char *s, size_t n)
+{
+  while (n > 0) {
+    ssize_t k = write(fd, s, n);
+    if (k < 0) {
+      if (errno == EINTR) continue;
+      return;
+    }
+    s += k; n -= (size_t)k;
+  }
+}
+
+static inline void prt_flush(prt_out_t *o)
+{
+  if (o == NULL) o = &prt_tl;
+  if (o->fd >= 0 && o->len > 0) prt_write(o->fd, o->buf, o->len);
+  if (o->fd >= 0) o->len = 0;
+}
+
+#define prtflush(...) prt_flush(__VA_ARGS__+0)
+
+static void prt_atexit(void) { prt_flush(&prt_tl); }
+
+// Only called when `s` doesn't fit
+static void prt_put_slow(prt_out_t *o, const char *s, size_t n)
+{
+  if (o->fd < 0) {   // Keep what fits, count the rest
+    size_t k = o->len + 1 < o->size ? o->size - 1 - o->len : 0;
+    memcpy(o->buf + o->len, s, k < n ? k : n);
+    o->len += n;
+    return;
+  }
+  if (o->buf == NULL) {
+    o->buf = prt_tlbuf; o->size = sizeof(prt_tlbuf);
+    if (!atomic_flag_test_and_set(&prt_atexit_set)) atexit(prt_atexit);
+  }
+  else prt_flush(o);
+  if (n < o->size) {
+    memcpy(o->buf + o->len, s, n);
+    o->len += n;
+  }
+  else prt_write(o->fd, s, n);
+}
+
+static inline void prt_put(prt_out_t *o, const char *s, size_t n)
+{
+  if (o->len + n < o->size) {
+    memcpy(o->buf + o->len, s, n);
+    o->len += n;
+  }
+  else prt_put_slow(o, s, n);
+}
+
+static inline size_t prt_end(prt_out_t *o)
+{
+  if (o->size > 0) o->buf[o->len < o->size ? o->len : o->size - 1] = '\0';
+  return o->len;
+}
+
+// ## Writers
+
+static inline void prt_uint(prt_out_t *o, unsigned long long u)
+{
+  char tmp[24], *p = vrg_utoa(tmp + sizeof(tmp), u);
+  prt_put(o, p, (size_t)(tmp + sizeof(tmp) - p));
+}
+
+static inline void prt_int(prt_out_t *o, long long i)
+{
+  if (i < 0) {
+    prt_put(o, "-", 1);
+    prt_uint(o, 0 - (unsigned long long)i);
+  }
+  else prt_uint(o, (unsigned long long)i);
+}
+
+static inline void prt_real(prt_out_t *o, double d, int flt)
+{
+  char tmp[40];
+  int n;
+  if (d != d) n = (memcpy(tmp, "nan", 3), 3);
+  else if (d - d != 0) n = d < 0 ? (memcpy(tmp, "-inf", 4), 4) : (memcpy(tmp, "inf", 3), 3);
+  else if ((n = vrg_shortest(tmp, d, flt)) == 0)
+    n = snprintf(tmp, sizeof(tmp), "%.*g", flt ? 9 : 17, d);
+  if ((size_t)n < sizeof(tmp)) prt_put(o, tmp, (size_t)n);   // Always true
+}
+
+static inline void prt_double(prt_out_t *o, double d) { prt_real(o, d, 0); }
+static inline void prt_float(prt_out_t *o, float f)   { prt_real(o, f, 1); }
+
+static inline void prt_str(prt_out_t *o, const char *s)
+{
+  if (s == NULL) s = "(null)";
+  prt_put(o, s, strlen(s));
+}
+
+static inline void prt_char(prt_out_t *o, char c) { prt_put(o, &c, 1); }
+
+static inline void prt_bool(prt_out_t *o, _Bool b)
+{
+  if (b) prt_put(o, "true", 4);
+  else prt_put(o, "false", 5);
+}
+
+static inline void prt_ptr(prt_out_t *o, const void *p)
+{
+  static const char hex[] = "0123456789abcdef";
+  char tmp[2 + 2 * sizeof(uintptr_t)], *s = tmp + sizeof(tmp);
+  uintptr_t u = (uintptr_t)p;
+  do { *--s = hex[u & 0x0F]; u >>= 4; } while (u > 0);
+  *--s = 'x'; *--s = '0';
+  prt_put(o, s, (size_t)(tmp + sizeof(tmp) - s));
+}
+
+// ## Printing
+// Only the selected function is called, this is why `_Generic` returns a function
+// rather than a call (all the associations must be valid for any argument).
+
+#define prt_fn(x_) \
+  _Generic((x_), _Bool: prt_bool,  char: prt_char, \
+           signed char: prt_int,   unsigned char: prt_uint, \
+                 short: prt_int,   unsigned short: prt_uint, \
+                   int: prt_int,   unsigned int: prt_uint, \
+                  long: prt_int,   unsigned long: prt_uint, \
+             long long: prt_int,   unsigned long long: prt_uint, \
+                 float: prt_float, double: prt_double, \
+                char *: prt_str,   const char *: prt_str, \
+               default: prt_ptr)
+
+#define prt_arg(o_, x_) prt_fn(x_)(o_, x_)
+
+#define prtto(o_, ...) (VRG_mapx(prt_arg, o_, (,), __VA_ARGS__), prt_end(o_))
+#define prt(...)       ((void)prtto(&prt_tl, __VA_ARGS__))
+#define prtln(...)     ((void)prtto(&prt_tl, __VA_ARGS__, "\n"))
+
+#endif // PRT_VERSION
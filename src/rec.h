@@ -0,0 +1,290 @@
+//.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//.  SPDX-License-Identifier: MIT
+
+//  ooooooooo.   oooooooooooo   .oooooo.
+//  `888   `Y88. `888'     `8  d8P'  `Y8b
+//   888   .d88'  888         888
+//   888ooo88P'   888oooo8    888
+//   888`88b.     888    "    888
+//   888  `88b.   888       o `88b    ooo
+//  o888o  o888o o888ooooood8  `Y8bood8P'
+
+#ifndef REC_VERSION
+#define REC_VERSION 0x0001000B // 0.1.0-beta
+
+// # Records
+//
+// Configurations, telemetry samples and messages are small structures that have to be
+// written to a file or a socket and read back, or dumped as JSON. `recdefine()` takes
+// the list of the fields of a structure, once, and defines the structure and the
+// functions to encode it in binary, to decode it and to write it as JSON:
+//
+//     recdefine(sample_t, (uint32_t, id), (double, value), (rec_str_t, unit), (point_t, pos));
+//
+//     size_t n = recencode(sample_t, &s, buf, size);   // Bytes needed (written if they fit)
+//     size_t n = recdecode(sample_t, &s, buf, len);    // Bytes read (0 if not valid)
+//     size_t n = recjson(sample_t, &s, txt, size);     // Like `snprintf()`
+//
+// The functions are expanded by `VRG_map()` one field after the other: there is no table
+// of fields to walk at runtime, and the compiler gets straight-line code for each type
+// of record, where the sizes of the fixed fields add up to a constant.
+//
+// The type of each field must be a single identifier:
+//
+//   - `int8_t` ... `int64_t`, `uint8_t` ... `uint64_t`, `float`, `double` and `bool`;
+//   - `rec_str_t` (a `const char *`) for strings;
+//   - a record type defined before with `recdefine()`.
+//
+// A record has up to 9 fields (the limit of `VRG_map()`); group them in records within
+// the record to have more.
+//
+// The binary encoding is the sequence of the fields, with no padding. Numbers are in
+// little endian, with their size. Strings are their length in 32 bits, followed by the
+// characters and a `\0`, NULL strings have length 0xFFFFFFFF. Decoded strings point into
+// the buffer, which must outlive them. When the buffer is not valid (e.g. truncated),
+// `recdecode()` returns 0 and the record is partially filled.
+//
+// In JSON, records are objects, strings are escaped and NaN and infinities are `null`.
+// Like `snprintf()`, `recjson()` returns the length of the whole text and writes as much
+// of it as fits in the buffer, always followed by a `\0`. Numbers are written with the
+// fewest digits that read back as the same value, up to 15 (6 for floats). The others
+// are written by `%.17g` (`%.9g`), whose output depends on the locale: `LC_NUMERIC`
+// must be "C" for a valid JSON.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "vrg.h"
+
+typedef const char *rec_str_t;
+
+// ## Binary encoding
+
+static inline unsigned char *rec_put_raw(unsigned char *p, const void *x, size_t n)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  for (size_t k = 0; k < n; k++) p[k] = ((const unsigned char *)x)[n - 1 - k];
+#else
+  memcpy(p, x, n);
+#endif
+  return p + n;
+}
+
+// Returns NULL if there aren't `n` bytes left (or if `p` is already NULL)
+static inline const unsigned char *rec_get_raw(const unsigned char *p, const unsigned char *e, void *x, size_t n)
+{
+  if (p == NULL || (size_t)(e - p) < n) return NULL;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  for (size_t k = 0; k < n; k++) ((unsigned char *)x)[k] = p[n - 1 - k];
+#else
+  memcpy(x, p, n);
+#endif
+  return p + n;
+}
+
+// ## JSON
+
+typedef struct {
+  char  *buf;
+  size_t size;
+  size_t len;    // Of the whole text, even if it doesn't fit
+} rec_out_t;
+
+static inline void rec_putn(rec_out_t *o, const char *s, size_t n)
+{
+  if (o->len + n < o->size) memcpy(o->buf + o->len, s, n);
+  else if (o->len + 1 < o->size) memcpy(o->buf + o->len, s, o->size - 1 - o->len);
+  o->len += n;
+}
+
+static inline void rec_jint(rec_out_t *o, uint64_t u, int neg)
+{
+  char tmp[24], *p = vrg_utoa(tmp + sizeof(tmp), u);
+  if (neg) *--p = '-';
+  rec_putn(o, p, (size_t)(tmp + sizeof(tmp) - p));
+}
+
+#define rec_jsigned(o_, x_)   rec_jint(o_, (x_) < 0 ? 0 - (uint64_t)(x_) : (uint64_t)(x_), (x_) < 0)
+#define rec_junsigned(o_, x_) rec_jint(o_, (uint64_t)(x_), 0)
+
+// The shortest fixed form that reads back as the same value (see `vrg_shortest()`),
+// `%.17g` (`%.9g` for floats) if there's none. A JSON reader gets back the same value.
+static inline void rec_jdouble(rec_out_t *o, double d, int flt)
+{
+  char tmp[40];
+  int n;
+  if (d != d || d - d != 0) {
+    rec_putn(o, "null", 4);
+    return;
+  }
+  if ((n = vrg_shortest(tmp, d, flt)) == 0)
+    n = snprintf(tmp, sizeof(tmp), "%.*g", flt ? 9 : 17, d);
+  if ((size_t)n < sizeof(tmp)) rec_putn(o, tmp, (size_t)n);   // Always true
+}
+
+static inline void rec_jstr(rec_out_t *o, const char *s)
+{
+  static const char hex[] = "0123456789abcdef";
+  const char *b;
+  char esc[6] = {'\\', 'u', '0', '0'};
+  if (s == NULL) {
+    rec_putn(o, "null", 4);
+    return;
+  }
+  rec_putn(o, "\"", 1);
+  for (;;) {
+    for (b = s; (unsigned char)*s >= 0x20 && *s != '"' && *s != '\\'; s++) ;
+    rec_putn(o, b, (size_t)(s - b));
+    if (*s == '\0') break;
+    if (*s == '"' || *s == '\\') {
+      esc[1] = *s;
+      rec_putn(o, esc, 2);
+    }
+    else {
+      esc[1] = 'u';
+      esc[4] = hex[(*s >> 4) & 0x0F];
+      esc[5] = hex[*s & 0x0F];
+      rec_putn(o, esc, 6);
+    }
+    s++;
+  }
+  rec_putn(o, "\"", 1);
+}
+
+static inline void rec_end(rec_out_t *o)
+{
+  if (o->size > 0) o->buf[o->len < o->size ? o->len : o->size - 1] = '\0';
+}
+
+// ## Fields
+// For each type `T`, `rec_size_T()`, `rec_put_T()`, `rec_get_T()` and `rec_json_T()`
+// are the size of the encoding, the encoder, the decoder and the JSON writer.
+
+#define REC_number(T_, J_) \
+  static inline size_t rec_size_##T_(const T_ *x) { (void)x; return sizeof(T_); } \
+  static inline unsigned char *rec_put_##T_(unsigned char *p, const T_ *x) \
+    { return rec_put_raw(p, x, sizeof(T_)); } \
+  static inline const unsigned char *rec_get_##T_(const unsigned char *p, const unsigned char *e, T_ *x) \
+    { return rec_get_raw(p, e, x, sizeof(T_)); } \
+  static inline void rec_json_##T_(rec_out_t *o, const T_ *x) { J_; }
+
+REC_number(int8_t,   rec_jsigned(o, *x))
+REC_number(int16_t,  rec_jsigned(o, *x))
+REC_number(int32_t,  rec_jsigned(o, *x))
+REC_number(int64_t,  rec_jsigned(o, *x))
+REC_number(uint8_t,  rec_junsigned(o, *x))
+REC_number(uint16_t, rec_junsigned(o, *x))
+REC_number(uint32_t, rec_junsigned(o, *x))
+REC_number(uint64_t, rec_junsigned(o, *x))
+REC_number(float,    rec_jdouble(o, *x, 1))
+REC_number(double,   rec_jdouble(o, *x, 0))
+
+// A byte that is not 0 or 1 is not a valid `_Bool`: it's converted
+static inline size_t rec_size__Bool(const _Bool *x) { (void)x; return 1; }
+
+static inline unsigned char *rec_put__Bool(unsigned char *p, const _Bool *x)
+{
+  *p = (unsigned char)*x;
+  return p + 1;
+}
+
+static inline const unsigned char *rec_get__Bool(const unsigned char *p, const unsigned char *e, _Bool *x)
+{
+  if (p == NULL || p >= e) return NULL;
+  *x = (*p != 0);
+  return p + 1;
+}
+
+static inline void rec_json__Bool(rec_out_t *o, const _Bool *x)
+{
+  if (*x) rec_putn(o, "true", 4);
+  else rec_putn(o, "false", 5);
+}
+
+// `bool` is a keyword in C23, a macro for `_Bool` before
+#define rec_size_bool rec_size__Bool
+#define rec_put_bool  rec_put__Bool
+#define rec_get_bool  rec_get__Bool
+#define rec_json_bool rec_json__Bool
+
+#define REC_NULL_STR 0xFFFFFFFFu
+
+static inline size_t rec_size_rec_str_t(const rec_str_t *x)
+{
+  return *x ? 4 + strlen(*x) + 1 : 4;
+}
+
+static inline unsigned char *rec_put_rec_str_t(unsigned char *p, const rec_str_t *x)
+{
+  uint32_t n = *x ? (uint32_t)strlen(*x) : REC_NULL_STR;
+  p = rec_put_raw(p, &n, 4);
+  if (*x == NULL) return p;
+  memcpy(p, *x, (size_t)n + 1);
+  return p + n + 1;
+}
+
+static inline const unsigned char *rec_get_rec_str_t(const unsigned char *p, const unsigned char *e, rec_str_t *x)
+{
+  uint32_t n;
+  if ((p = rec_get_raw(p, e, &n, 4)) == NULL) return NULL;
+  if (n == REC_NULL_STR) {
+    *x = NULL;
+    return p;
+  }
+  if ((size_t)(e - p) <= n || p[n] != '\0') return NULL;
+  *x = (rec_str_t)p;
+  return p + n + 1;
+}
+
+static inline void rec_json_rec_str_t(rec_out_t *o, const rec_str_t *x) { rec_jstr(o, *x); }
+
+// ## Records
+// Each field is a pair `(type, name)`, unpacked with `VRG_call()`. The functions of the
+// record have the same form as the ones of the fields, so that records can be fields.
+
+#define rec_fld_decl(f_)        VRG_call(rec_fld_decl_, f_)
+#define rec_fld_decl_(T_, n_)   T_ n_
+
+#define rec_fld_size(f_)        + VRG_call(rec_fld_size_, f_)
+#define rec_fld_size_(T_, n_)   rec_size_##T_(&r->n_)
+
+#define rec_fld_put(f_)         VRG_call(rec_fld_put_, f_)
+#define rec_fld_put_(T_, n_)    p = rec_put_##T_(p, &r->n_);
+
+#define rec_fld_get(f_)         VRG_call(rec_fld_get_, f_)
+#define rec_fld_get_(T_, n_)    p = rec_get_##T_(p, e, &r->n_);
+
+// The name of the first field is not preceded by a comma
+#define rec_fld_json(i_, f_)    VRG_call(rec_fld_json_, (i_, VRG_unp f_))
+#define rec_fld_json_(i_, T_, n_) \
+  rec_putn(o, ",\"" #n_ "\":" + ((i_) == 0), sizeof(",\"" #n_ "\":") - 1 - ((i_) == 0)); \
+  rec_json_##T_(o, &r->n_);
+
+#define recdefine(T_, ...) \
+  typedef struct { VRG_foreach(rec_fld_decl, __VA_ARGS__); } T_; \
+  static inline size_t rec_size_##T_(const T_ *r) \
+    { return 0 VRG_map(rec_fld_size, (), __VA_ARGS__); } \
+  static inline unsigned char *rec_put_##T_(unsigned char *p, const T_ *r) \
+    { VRG_map(rec_fld_put, (), __VA_ARGS__) return p; } \
+  static inline const unsigned char *rec_get_##T_(const unsigned char *p, const unsigned char *e, T_ *r) \
+    { VRG_map(rec_fld_get, (), __VA_ARGS__) return p; } \
+  static inline void rec_json_##T_(rec_out_t *o, const T_ *r) \
+    { rec_putn(o, "{", 1); VRG_mapi(rec_fld_json, (), __VA_ARGS__) rec_putn(o, "}", 1); } \
+  static inline size_t rec_encode_##T_(const T_ *r, void *buf, size_t size) \
+    { size_t n = rec_size_##T_(r); if (n <= size) rec_put_##T_((unsigned char *)buf, r); return n; } \
+  static inline size_t rec_decode_##T_(T_ *r, const void *buf, size_t len) \
+    { const unsigned char *b = (const unsigned char *)buf, *p = rec_get_##T_(b, b + len, r); \
+      return p ? (size_t)(p - b) : 0; } \
+  static inline size_t rec_tojson_##T_(const T_ *r, char *buf, size_t size) \
+    { rec_out_t o = {buf, size, 0}; rec_json_##T_(&o, r); rec_end(&o); return o.len; } \
+  static inline size_t rec_size_##T_(const T_ *r)  // Takes the `;` after `recdefine()`
+
+#define recsize(T_, r_)                 rec_size_##T_(r_)
+#define recencode(T_, r_, buf_, size_)  rec_encode_##T_(r_, buf_, size_)
+#define recdecode(T_, r_, buf_, len_)   rec_decode_##T_(r_, buf_, len_)
+#define recjson(T_, r_, buf_, size_)    rec_tojson_##T_(r_, buf_, size_)
+
+#endif // REC_VERSION
@@ -0,0 +1,367 @@
+//.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//.  SPDX-License-Identifier: MIT
+
+//  ooooooooooooo ooooooooo.     .oooooo.
+//  8'   888   `8 `888   `Y88.  d8P'  `Y8b
+//       888       888   .d88' 888
+//       888       888ooo88P'  888
+//       888       888`88b.    888
+//       888       888  `88b.  `88b    ooo
+//      o888o     o888o  o888o  `Y8bood8P'
+
+#ifndef TRC_VERSION
+#define TRC_VERSION 0x0001000B // 0.1.0-beta
+
+// # Deferred tracing
+//
+// Tracing with `fprintf()` formats the message and makes (at least) one system call
+// for each trace: with heavy tracing, that's where the time goes.
+//
+// The `trc` functions only record the format string and the arguments (as a
+// `VRG_pack()`) into a ring buffer that belongs to the calling thread. Formatting and
+// writing happen later, in bulk:
+//
+//   - when `trcflush()` is called,
+//   - when the ring buffer of a thread is full (by that thread),
+//   - at exit,
+//   - periodically, if the background flusher is started with `trcstart()`.
+//
+//     #include "trc.h"
+//
+//     trcdebug("x = %d, name = %s", x, name);
+//     trcinfo("Starting");
+//
+// Messages are written as `cli_trace()` does: the formatted message followed by
+// ` :file:line`. Messages from the same thread are written in order; there's no
+// ordering between messages from different threads.
+//
+// Each record holds up to 9 arguments. Strings are copied in the record (up to
+// `TRC_STRBUF` bytes for all the strings of a record) so they don't need to live until
+// the flush. Any other pointer is just stored (`%p`).
+//
+// `trc.h` requires C11 (`_Thread_local`, `<stdatomic.h>` and `_Generic`). The background
+// flusher requires POSIX threads and must be enabled by defining `TRC_FLUSHER`.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "vrg.h"
+
+// ## Levels
+// Levels are filtered at compile time: traces below `TRC_LEVEL` expand to nothing.
+// By default, debug traces are disabled if `NDEBUG` is defined.
+
+#define TRC_DEBUG 0
+#define TRC_INFO  1
+#define TRC_WARN  2
+#define TRC_ERROR 3
+#define TRC_NONE  4
+
+#ifndef TRC_LEVEL
+#ifdef NDEBUG
+#define TRC_LEVEL TRC_INFO
+#else
+#define TRC_LEVEL TRC_DEBUG
+#endif
+#endif
+
+#if TRC_LEVEL <= TRC_DEBUG
+#define trcdebug(...) trc_log(TRC_DEBUG, __VA_ARGS__)
+#else
+#define trcdebug(...) ((void)0)
+#endif
+
+#if TRC_LEVEL <= TRC_INFO
+#define trcinfo(...)  trc_log(TRC_INFO, __VA_ARGS__)
+#else
+#define trcinfo(...)  ((void)0)
+#endif
+
+#if TRC_LEVEL <= TRC_WARN
+#define trcwarn(...)  trc_log(TRC_WARN, __VA_ARGS__)
+#else
+#define trcwarn(...)  ((void)0)
+#endif
+
+#if TRC_LEVEL <= TRC_ERROR
+#define trcerror(...) trc_log(TRC_ERROR, __VA_ARGS__)
+#else
+#define trcerror(...) ((void)0)
+#endif
+
+#define trc_log(l_, f_, ...) trc_push(l_, __FILE__, __LINE__, "" f_, VRG_pack(__VA_ARGS__))
+
+// ## Ring buffers
+// Each thread gets its own ring buffer the first time it traces. Rings are never
+// freed and are linked in a list so that the flusher can find them.
+// The owner thread is the only one writing records (and advancing `head`); the
+// flusher is the only one consuming them (and advancing `tail`). No lock is needed
+// on the hot path: the flushers (`trcflush()`, the background thread, a thread whose
+// ring is full) take turns through `trc_lock`.
+
+#ifndef TRC_RING_SIZE
+#define TRC_RING_SIZE 512
+#endif
+
+#ifndef TRC_STRBUF
+#define TRC_STRBUF 96
+#endif
+
+#define TRC_MAXARGS 9
+
+typedef struct {
+  const char    *fmt;
+  const char    *file;
+  int            line;
+  unsigned char  level;
+  unsigned char  argc;
+  vrg_val_t      argv[TRC_MAXARGS];
+  char           sbuf[TRC_STRBUF];
+} trc_rec_t;
+
+typedef struct trc_ring_s {
+  struct trc_ring_s *next;
+  _Atomic size_t     head;
+  char               pad[64];  // Keep `head` and `tail` on different cache lines
+  _Atomic size_t     tail;
+  trc_rec_t          rec[TRC_RING_SIZE];
+} trc_ring_t;
+
+static FILE *trc_out = NULL; // Where the traces are written (`stderr` if NULL)
+
+static _Atomic(trc_ring_t *) trc_rings = NULL;
+static _Thread_local trc_ring_t *trc_my_ring = NULL;
+static atomic_flag trc_lock = ATOMIC_FLAG_INIT;
+
+static const char *trc_level_str[] = {"", "INFO: ", "WARNING: ", "ERROR: "};
+
+// ## Formatting
+// Each conversion specification is rebuilt using the actual type of the argument, so
+// a wrong format (e.g. `%d` for a string) prints the value rather than causing
+// undefined behaviour. Length modifiers in the format string are ignored, `*` for
+// width or precision is not supported.
+
+// Plain `%d` and `%s` (no flags, width or precision) are, by far, the most common
+// conversions and don't need `snprintf()`.
+static int trc_fmt_fast(char *buf, int size, const vrg_val_t *arg)
+{
+  char tmp[24];
+  const char *s = tmp;
+  int len = 0;
+
+  switch (arg->type) {
+    case VRG_T_FLOAT: case VRG_T_DOUBLE: case VRG_T_PTR: case VRG_T_CHAR:
+      return -1;
+
+    case VRG_T_STR:
+      s = arg->v.s;
+      len = (int)strlen(s);
+      break;
+
+    default: {
+      int neg = 0;
+      unsigned long long u = arg->v.u;
+      char *p;
+      switch (arg->type) {
+        case VRG_T_UCHAR: case VRG_T_USHORT: case VRG_T_UINT:
+        case VRG_T_ULONG: case VRG_T_ULLONG: break;
+        default: if (arg->v.i < 0) { neg = 1; u = 0 - u; }
+      }
+      p = vrg_utoa(tmp + sizeof(tmp), u);
+      if (neg) *--p = '-';
+      s = p; len = (int)(tmp + sizeof(tmp) - p);
+    }
+  }
+  if (len >= size) len = size - 1;
+  memcpy(buf, s, len);
+  return len;
+}
+
+static int trc_fmt_arg(char *buf, int size, char *spec, int len, char conv, const vrg_val_t *arg)
+{
+  int n;
+  if (len == 1 && (conv == 'd' || conv == 'i' || conv == 's' || conv == 'u')
+               && (n = trc_fmt_fast(buf, size, arg)) >= 0)
+    return n;
+
+  switch (arg->type) {
+    case VRG_T_FLOAT: case VRG_T_DOUBLE:
+      spec[len++] = strchr("fFeEgGaA", conv) ? conv : 'g'; spec[len] = '\0';
+      return snprintf(buf, size, spec, arg->v.d);
+
+    case VRG_T_STR:
+      spec[len++] = 's'; spec[len] = '\0';
+      return snprintf(buf, size, spec, arg->v.s);
+
+    case VRG_T_PTR:
+      spec[len++] = 'p'; spec[len] = '\0';
+      return snprintf(buf, size, spec, arg->v.p);
+
+    case VRG_T_UCHAR: case VRG_T_USHORT: case VRG_T_UINT:
+    case VRG_T_ULONG: case VRG_T_ULLONG:
+      if (conv == 'c') break;
+      spec[len++] = 'l'; spec[len++] = 'l';
+      spec[len++] = strchr("ouxX", conv) ? conv : 'u'; spec[len] = '\0';
+      return snprintf(buf, size, spec, arg->v.u);
+
+    default:
+      if (conv == 'c') break;
+      spec[len++] = 'l'; spec[len++] = 'l';
+      spec[len++] = strchr("diouxX", conv) ? conv : 'd'; spec[len] = '\0';
+      return snprintf(buf, size, spec, arg->v.i);
+  }
+  spec[len++] = 'c'; spec[len] = '\0';
+  return snprintf(buf, size, spec, (int)arg->v.i);
+}
+
+static int trc_format(char *buf, int size, const trc_rec_t *rec)
+{
+  const char *f = rec->fmt;
+  char spec[32];
+  int n = 0, k = 0, len;
+
+  n += trc_fmt_fast(buf, size, &(vrg_val_t){VRG_T_STR, {.s = trc_level_str[rec->level]}});
+  while (*f && n < size) {
+    if (*f != '%') {
+      const char *p = strchr(f, '%');
+      len = p ? (int)(p - f) : (int)strlen(f);
+      if (len > size - n) len = size - n;
+      memcpy(buf + n, f, len);
+      n += len; f += len;
+      continue;
+    }
+    if (f[1] == '%') { buf[n++] = '%'; f += 2; continue; }
+
+    len = 0;
+    spec[len++] = *f++;
+    while (*f && strchr("-+ #0123456789.", *f) && len < 24) spec[len++] = *f++;
+    while (*f && strchr("hljztL", *f)) f++;
+    if (*f == '\0') break;
+
+    if (k < rec->argc) n += trc_fmt_arg(buf+n, size-n, spec, len, *f, &rec->argv[k++]);
+    f++;
+  }
+  if (n < size) n += trc_fmt_fast(buf+n, size-n, &(vrg_val_t){VRG_T_STR, {.s = " :"}});
+  if (n < size) n += trc_fmt_fast(buf+n, size-n, &(vrg_val_t){VRG_T_STR, {.s = rec->file}});
+  if (n < size) buf[n++] = ':';
+  if (n < size) n += trc_fmt_fast(buf+n, size-n, &(vrg_val_t){VRG_T_INT, {.i = rec->line}});
+  if (n < size) buf[n++] = '\n';
+  if (n >= size) { n = size-1; buf[n-1] = '\n'; }
+  return n;
+}
+
+// ## Flushing
+// Records are formatted in a local buffer that is written with one `fwrite()` when
+// full, rather than one call for each record.
+
+#define TRC_OUTBUF 8192
+
+static void trc_flush_ring(trc_ring_t *r, char *out, int *n)
+{
+  size_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+  size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+  FILE *f = trc_out ? trc_out : stderr;
+
+  while (tail != head) {
+    if (*n > TRC_OUTBUF - 1024) { fwrite(out, 1, *n, f); *n = 0; }
+    *n += trc_format(out + *n, 1024, &r->rec[tail % TRC_RING_SIZE]);
+    tail++;
+  }
+  atomic_store_explicit(&r->tail, tail, memory_order_release);
+}
+
+static void trcflush(void)
+{
+  char out[TRC_OUTBUF];
+  int n = 0;
+
+  while (atomic_flag_test_and_set_explicit(&trc_lock, memory_order_acquire)) ;
+  for (trc_ring_t *r = atomic_load(&trc_rings); r != NULL; r = r->next)
+    trc_flush_ring(r, out, &n);
+  if (n > 0) {
+    FILE *f = trc_out ? trc_out : stderr;
+    fwrite(out, 1, n, f);
+    fflush(f);
+  }
+  atomic_flag_clear_explicit(&trc_lock, memory_order_release);
+}
+
+static trc_ring_t *trc_new_ring(void)
+{
+  trc_ring_t *r = calloc(1, sizeof(trc_ring_t));
+  if (r == NULL) return NULL;
+
+  r->next = atomic_load(&trc_rings);
+  while (!atomic_compare_exchange_weak(&trc_rings, &r->next, r)) ;
+
+  if (r->next == NULL) atexit(trcflush); // The first ring ever
+  return (trc_my_ring = r);
+}
+
+// ## Recording
+// This is the hot path: no system call and no formatting, unless the ring is full.
+
+static inline void trc_push(int level, const char *file, int line, const char *fmt,
+                            int argc, const vrg_val_t *argv)
+{
+  trc_ring_t *r = trc_my_ring ? trc_my_ring : trc_new_ring();
+  if (r == NULL) return;
+
+  size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+  if (head - atomic_load_explicit(&r->tail, memory_order_acquire) >= TRC_RING_SIZE)
+    trcflush();
+
+  trc_rec_t *rec = &r->rec[head % TRC_RING_SIZE];
+  rec->fmt   = fmt;
+  rec->file  = file;
+  rec->line  = line;
+  rec->level = (unsigned char)level;
+  rec->argc  = (unsigned char)(argc < TRC_MAXARGS ? argc : TRC_MAXARGS);
+
+  int s = 0;
+  for (int k = 0; k < rec->argc; k++) {
+    rec->argv[k] = argv[k];
+    if (argv[k].type == VRG_T_STR) {
+      const char *str = argv[k].v.s ? argv[k].v.s : "(null)";
+      int len = (int)strlen(str);
+      if (len > TRC_STRBUF - 1 - s) len = TRC_STRBUF - 1 - s;
+      memcpy(rec->sbuf + s, str, len);
+      rec->sbuf[s + len] = '\0';
+      rec->argv[k].v.s = rec->sbuf + s;
+      s += len + (s + len < TRC_STRBUF - 1);
+    }
+  }
+  atomic_store_explicit(&r->head, head + 1, memory_order_release);
+}
+
+// ## Background flusher
+// `trcstart(ms)` starts a thread that flushes the rings every `ms` milliseconds.
+
+#ifdef TRC_FLUSHER
+#include <pthread.h>
+#include <time.h>
+
+static void *trc_flusher(void *arg)
+{
+  long ms = (long)(size_t)arg;
+  struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+  for (;;) {
+    nanosleep(&ts, NULL);
+    trcflush();
+  }
+  return NULL;
+}
+
+static inline int trcstart(long ms)
+{
+  pthread_t t;
+  if (ms <= 0) ms = 100;
+  if (pthread_create(&t, NULL, trc_flusher, (void *)(size_t)ms) != 0) return 0;
+  pthread_detach(t);
+  return 1;
+}
+#endif
+
+#endif // TRC_VERSION
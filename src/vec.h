@@ -0,0 +1,120 @@
+//.  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//.  SPDX-License-Identifier: MIT
+
+//  oooooo     oooo oooooooooooo   .oooooo.
+//   `888.     .8'  `888'     `8  d8P'  `Y8b
+//    `888.   .8'    888         888
+//     `888. .8'     888oooo8    888
+//      `888.8'      888    "    888
+//       `888'       888       o `88b    ooo
+//        `8'       o888ooooood8  `Y8bood8P'
+
+#ifndef VEC_VERSION
+#define VEC_VERSION 0x0001000B // 0.1.0-beta
+
+// # Dynamic vectors
+//
+// A vector of elements of any type, with the first elements stored in the vector
+// itself: most vectors in a program are small, and they never call `malloc()`.
+// When they grow beyond that, the capacity doubles each time, so pushing `n` elements
+// one by one costs `O(log n)` allocations, not `n`.
+//
+//     typedef vec_t(int) intvec_t;         // Inline storage of VEC_SMALL bytes
+//     typedef vec_t(point_t, 4) ptvec_t;   // Inline storage of 4 elements
+//
+//     intvec_t v;
+//     vecinit(&v);
+//     vecpush(&v, 42);                     // Push one element
+//     vecpush(&v, array, 10);              // Push 10 elements from `array`
+//     int *p = vecpush(&v);                // Reserve one element, return a pointer to it
+//     vecreserve(&v, 1000);                // Make room for 1000 more elements
+//     for (size_t k = 0; k < v.len; k++) printf("%d\n", v.data[k]);
+//     vecfree(&v);
+//
+// The overloads of `vecpush()` (and of `vec_t()`) are selected by `vrg()`: there is no
+// dispatch at runtime. The common case of pushing one element in a vector that has room
+// for it is inlined as a comparison and a store.
+//
+// The fields of the vector are meant to be read directly: `data` (the elements), `len`
+// (how many they are) and `cap` (how many fit before the next allocation). `vecpush()`
+// returns a pointer to the first element pushed, or NULL if the memory can't be
+// allocated (the vector is unchanged); `vecreserve()` returns 0 in that case.
+//
+// As `data` may point to the vector itself, vectors can't be copied by assignment. The
+// arguments of the macros can be evaluated more than once, and a compound literal
+// must be enclosed in parentheses: `vecpush(&v, ((point_t){1, 2}))`.
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vrg.h"
+
+// ## The vector type
+
+#ifndef VEC_SMALL
+#define VEC_SMALL 64  // Bytes of inline storage for `vec_t(T)`
+#endif
+
+#define vec_t(...) vrg(vec_t_, __VA_ARGS__)
+#define vec_t_1(T_) vec_t_2(T_, VEC_SMALL / sizeof(T_) > 0 ? VEC_SMALL / sizeof(T_) : 1)
+#define vec_t_2(T_, N_) \
+  struct { union { T_ *data; void *ptr; }; size_t len; size_t cap; T_ small[N_]; }
+
+#define vec_small_cap(v_) (sizeof((v_)->small) / sizeof((v_)->small[0]))
+
+#define vecinit(v_)  ((v_)->data = (v_)->small, (v_)->len = 0, (v_)->cap = vec_small_cap(v_))
+#define vecfree(v_)  ((v_)->data != (v_)->small ? free((v_)->ptr) : (void)0, vecinit(v_))
+#define vecclear(v_) ((v_)->len = 0)
+#define vecpop(v_)   ((v_)->data[--(v_)->len])
+
+// ## Growing
+
+// Makes room for `more` elements of `size` bytes after the `len` ones. The elements are
+// moved out of the inline storage (`small`) the first time it's not enough.
+static inline int vec_grow(void **data, void *small, size_t len, size_t *cap, size_t more, size_t size)
+{
+  size_t n = *cap ? *cap : 1, need;
+  void *p;
+  if (more > (size_t)-1 - len) return 0;   // `len + more` would wrap around
+  need = len + more;
+  if (need > (size_t)-1 / 2 / size) return 0;
+  while (n < need) n *= 2;
+  if (*data == small) {
+    if ((p = malloc(n * size)) == NULL) return 0;
+    memcpy(p, small, len * size);
+  }
+  else if ((p = realloc(*data, n * size)) == NULL) return 0;
+  *data = p;
+  *cap = n;
+  return 1;
+}
+
+#define vecreserve(v_, n_) \
+  ((v_)->cap - (v_)->len >= (size_t)(n_) || \
+   vec_grow(&(v_)->ptr, (v_)->small, (v_)->len, &(v_)->cap, (n_), sizeof((v_)->data[0])))
+
+// ## Pushing
+
+#define vecpush(...) vrg(vec_push_, __VA_ARGS__)
+
+// Reserve one element
+#define vec_push_1(v_) \
+  (vecreserve(v_, 1) ? &(v_)->data[(v_)->len++] : NULL)
+
+// Push one element
+#define vec_push_2(v_, x_) \
+  (vecreserve(v_, 1) ? ((v_)->data[(v_)->len] = (x_), &(v_)->data[(v_)->len++]) : NULL)
+
+// Push `n_` elements from the array `p_`
+#define vec_push_3(v_, p_, n_) \
+  (vecreserve(v_, n_) ? (vec_append((v_)->data, &(v_)->len, (p_), (n_), sizeof((v_)->data[0])), \
+                         &(v_)->data[(v_)->len - (n_)]) : NULL)
+
+static inline void vec_append(void *data, size_t *len, const void *src, size_t n, size_t size)
+{
+  if (n > 0) memcpy((char *)data + *len * size, src, n * size);
+  *len += n;
+}
+
+#endif // VEC_VERSION
@@ -194,4 +194,330 @@
 // Just for backward compatibility. Deprecated.
 #define vrg_(f_,...)  vrg0(f_,...)
 
+// ## Keyword arguments
+//
+// Positional defaults are fine for two or three arguments but functions with many
+// tuning knobs are better called by name:
+//
+//     open_file("data.txt", .mode = "w", .bufsize = 1<<16);
+//
+// Group the optional parameters in a struct and define the macro `<type>_defaults`
+// with the default values as a list of designated initializers:
+//
+//     typedef struct { const char *mode; int flags; int bufsize; } open_opts;
+//     #define open_opts_defaults  .mode = "r", .flags = 0, .bufsize = 4096
+//
+//     int open_file_kw(const char *path, open_opts opts);
+//     #define open_file(path, ...) open_file_kw(path, VRG_kwargs(open_opts, __VA_ARGS__))
+//
+// `VRG_kwargs(t, ...)` expands to the compound literal `(t){t_defaults, ...}`. When a
+// member is initialized more than once, the last initializer wins (C11 §6.7.9) so
+// the keyword arguments override the defaults. The literal is built entirely of
+// constants and the compiler passes it as if the call was written by hand.
+//
+// With `-Wextra`, GCC and Clang warn when a member is initialized twice. That is
+// exactly what `VRG_kwargs()` relies upon: add `-Wno-override-init` to silence them.
+
+#define VRG_kwargs(t_,...) ((t_){ t_ ## _defaults, __VA_ARGS__ })
+
+// ## Iterating over arguments
+//
+// `VRG_map(m_, sep_, ...)` expands to a call of the macro (or function) `m_` for each
+// argument, separated by `sep_`:
+//
+//     #define sq(x) ((x)*(x))
+//     VRG_map(sq, (+), a, b, c)   ->  sq(a) + sq(b) + sq(c)
+//
+// The separator must be enclosed in parenthesis so that it can contain a comma: use
+// `(+)`, `(;)`, `(,)`, `(&&)`, etc. or `()` for no separator at all.
+//
+// Two variants pass additional information to `m_`:
+//
+//     VRG_mapi(m_, sep_, ...)       ->  m_(0, a) sep m_(1, b) sep m_(2, c)
+//     VRG_mapx(m_, ctx, sep_, ...)  ->  m_(ctx, a) sep m_(ctx, b) sep m_(ctx, c)
+//
+// `VRG_foreach(m_, ...)` is a shortcut for `VRG_map(m_, (;), ...)` to write statements.
+//
+// Everything happens in the preprocessor: the result is straight-line code that the
+// compiler can inline and constant-fold, unlike a `va_arg` loop. Up to 9 arguments
+// are supported; with no arguments, they expand to nothing.
+//
+// The macros `VRG_map_1` ... `VRG_map_9` do the work. Each one expands the previous
+// one and adds a call for its last argument. The applier `a_` determines how `m_` is
+// called (with or without index and context).
+
+#define VRG_unp(...) __VA_ARGS__
+
+#define VRG_map_ap(m_,c_,i_,x_)  m_(x_)
+#define VRG_mapi_ap(m_,c_,i_,x_) m_(i_,x_)
+#define VRG_mapx_ap(m_,c_,i_,x_) m_(c_,x_)
+
+#define VRG_map_0(a_,m_,c_,s_,...)
+#define VRG_map_1(a_,m_,c_,s_,x0)                         a_(m_,c_,0,x0)
+#define VRG_map_2(a_,m_,c_,s_,x0,x1)                      VRG_map_1(a_,m_,c_,s_,x0) VRG_unp s_ a_(m_,c_,1,x1)
+#define VRG_map_3(a_,m_,c_,s_,x0,x1,x2)                   VRG_map_2(a_,m_,c_,s_,x0,x1) VRG_unp s_ a_(m_,c_,2,x2)
+#define VRG_map_4(a_,m_,c_,s_,x0,x1,x2,x3)                VRG_map_3(a_,m_,c_,s_,x0,x1,x2) VRG_unp s_ a_(m_,c_,3,x3)
+#define VRG_map_5(a_,m_,c_,s_,x0,x1,x2,x3,x4)             VRG_map_4(a_,m_,c_,s_,x0,x1,x2,x3) VRG_unp s_ a_(m_,c_,4,x4)
+#define VRG_map_6(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5)          VRG_map_5(a_,m_,c_,s_,x0,x1,x2,x3,x4) VRG_unp s_ a_(m_,c_,5,x5)
+#define VRG_map_7(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6)       VRG_map_6(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5) VRG_unp s_ a_(m_,c_,6,x6)
+#define VRG_map_8(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7)    VRG_map_7(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6) VRG_unp s_ a_(m_,c_,7,x7)
+#define VRG_map_9(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7,x8) VRG_map_8(a_,m_,c_,s_,x0,x1,x2,x3,x4,x5,x6,x7) VRG_unp s_ a_(m_,c_,8,x8)
+
+#define VRG_map_go(a_,m_,c_,s_,...) \
+   VRG_join(VRG_map_, VRG_sel(VRG_nargs(__VA_ARGS__),__VA_ARGS__))(a_,m_,c_,s_,__VA_ARGS__)
+
+#define VRG_map(m_,s_,...)      VRG_map_go(VRG_map_ap,  m_, ~,  s_, __VA_ARGS__)
+#define VRG_mapi(m_,s_,...)     VRG_map_go(VRG_mapi_ap, m_, ~,  s_, __VA_ARGS__)
+#define VRG_mapx(m_,c_,s_,...)  VRG_map_go(VRG_mapx_ap, m_, c_, s_, __VA_ARGS__)
+#define VRG_foreach(m_,...)     VRG_map_go(VRG_map_ap,  m_, ~, (;), __VA_ARGS__)
+
+// ## Positional defaults
+//
+// Writing `f_0` ... `f_N` by hand to fill in the trailing defaults, as in `Example1`
+// above, gets tedious for long parameter lists and the macros easily drift out of sync
+// with the function. `VRG_defaults(f_, params_, ...)` generates them from the list of
+// the parameters, each with its default value:
+//
+//     int my_func(int a, char b, void *c);
+//     #define myfunc(...)  VRG_defaults(my_func, ((a, 0), (b, '\0'), (c, NULL)), __VA_ARGS__)
+//
+//     myfunc()          ->  my_func(0, '\0', NULL)
+//     myfunc(42)        ->  my_func(42, '\0', NULL)
+//     myfunc(42, 'x')   ->  my_func(42, 'x', NULL)
+//
+// The arguments of the call take the place of the first parameters, the defaults of the
+// others follow. Like for `vrg()`, everything happens in the preprocessor: the call is a
+// direct call to `f_` with the constants written in place.
+//
+// A parameter with no default, like `(path)`, is required and must precede the ones with
+// a default: a call that omits it refers to the undeclared identifier `path_is_required`
+// and doesn't compile. The names are otherwise unused. A call with more arguments than
+// parameters is an error of the preprocessor.
+//
+// Up to 9 parameters; a default value that contains commas must be in parenthesis.
+
+#define VRG_drop_0(...)                            __VA_ARGS__
+#define VRG_drop_1(x0,...)                         __VA_ARGS__
+#define VRG_drop_2(x0,x1,...)                      __VA_ARGS__
+#define VRG_drop_3(x0,x1,x2,...)                   __VA_ARGS__
+#define VRG_drop_4(x0,x1,x2,x3,...)                __VA_ARGS__
+#define VRG_drop_5(x0,x1,x2,x3,x4,...)             __VA_ARGS__
+#define VRG_drop_6(x0,x1,x2,x3,x4,x5,...)          __VA_ARGS__
+#define VRG_drop_7(x0,x1,x2,x3,x4,x5,x6,...)       __VA_ARGS__
+#define VRG_drop_8(x0,x1,x2,x3,x4,x5,x6,x7,...)    __VA_ARGS__
+#define VRG_drop_9(x0,x1,x2,x3,x4,x5,x6,x7,x8,...) __VA_ARGS__
+
+#define VRG_dflt_1(n_)      n_ ## _is_required
+#define VRG_dflt_2(n_,d_)   d_
+#define VRG_dflt(p_)        VRG_join(VRG_dflt_, VRG_nargs p_) p_
+#define VRG_dflt_next(p_)   , VRG_dflt(p_)
+
+#define VRG_defaults(f_,p_,...)   VRG_join(VRG_defaults_, VRG_sel(1,__VA_ARGS__))(f_,p_,__VA_ARGS__)
+#define VRG_defaults_0(f_,p_,...) f_(VRG_map(VRG_dflt, (,), VRG_unp p_))
+#define VRG_defaults_1(f_,p_,...) \
+   f_(__VA_ARGS__ VRG_map(VRG_dflt_next, (), VRG_join(VRG_drop_, VRG_nargs(__VA_ARGS__)) p_))
+
+// ## Calling with a runtime number of arguments
+//
+// Interpreters and FFI layers get their arguments as an array and know how many they
+// are only at runtime. `VRG_apply(f_, n, a)` calls the `f_<n>` that matches `n`,
+// passing the first `n` elements of the array `a`:
+//
+//     #define sum_arities   1, 2, 3
+//     #define sum_arity_error(n)  (-1)
+//
+//     VRG_apply(sum_, n, a)  ->  ((n) == 1 ? sum_1(a[0]) :
+//                                 (n) == 2 ? sum_2(a[0], a[1]) :
+//                                 (n) == 3 ? sum_3(a[0], a[1], a[2]) : sum_arity_error(n))
+//
+// The targets are the same `f_0` ... `f_9` used by `vrg()`. Since there is no way to
+// tell in the preprocessor which of them are defined, they are listed by the macro
+// `<f_>arities` (up to 9 of them), much like `<t>_defaults` for `VRG_kwargs()`. When
+// `n` is not in the list, `<f_>arity_error(n)` is evaluated instead.
+//
+// All the targets (and the error) must have compatible types, as the branches of
+// `?:`. Compilers turn the comparisons into a jump table (GCC and Clang do at `-O2`
+// when the arities are contiguous): a bounds check and a single indirect jump.
+// Note that `n` is evaluated more than once.
+
+#define VRG_args_0(a_)
+#define VRG_args_1(a_) (a_)[0]
+#define VRG_args_2(a_) VRG_args_1(a_), (a_)[1]
+#define VRG_args_3(a_) VRG_args_2(a_), (a_)[2]
+#define VRG_args_4(a_) VRG_args_3(a_), (a_)[3]
+#define VRG_args_5(a_) VRG_args_4(a_), (a_)[4]
+#define VRG_args_6(a_) VRG_args_5(a_), (a_)[5]
+#define VRG_args_7(a_) VRG_args_6(a_), (a_)[6]
+#define VRG_args_8(a_) VRG_args_7(a_), (a_)[7]
+#define VRG_args_9(a_) VRG_args_8(a_), (a_)[8]
+
+#define VRG_call(m_, args_) m_ args_
+#define VRG_apply_go(m_, args_) m_ args_  // Not VRG_call(): it would not expand inside itself
+
+#define VRG_apply_cs(f_, n_, a_, k_)  (n_) == k_ ? VRG_apply_go(VRG_join(f_, k_), (VRG_join(VRG_args_, k_)(a_))) :
+#define VRG_apply_case(c_, k_)        VRG_call(VRG_apply_cs, (VRG_unp c_, k_))
+
+#define VRG_apply(f_, n_, a_) \
+   (VRG_mapx(VRG_apply_case, (f_, n_, a_), (), f_ ## arities) f_ ## arity_error(n_))
+
+// ## Argument packs
+//
+// Functions like `printf()` receive their arguments through `stdarg.h`: the type of
+// each argument is lost and the callee has to walk the `va_list` with `va_arg()`.
+//
+// `VRG_pack(...)` expands to two arguments: the number of values (a constant) and a
+// pointer to an array of tagged values built on the stack as a compound literal:
+//
+//     void log_impl(const char *tag, int argc, const vrg_val_t *argv);
+//     #define log(tag, ...) log_impl(tag, VRG_pack(__VA_ARGS__))
+//
+//     log("DBG", "x=", x, 3.2);  ->  log_impl("DBG", 3, (const vrg_val_t[]){...})
+//
+// Each `vrg_val_t` holds the type of the argument (determined with `_Generic`) and its
+// value. The callee can go through them with a plain loop:
+//
+//     for (int k = 0; k < argc; k++)
+//       switch (argv[k].type) {
+//         case VRG_T_INT: ... argv[k].v.i ...
+//         case VRG_T_STR: ... argv[k].v.s ...
+//
+// Signed integers are stored in `v.i`, unsigned integers in `v.u`, floating point
+// values in `v.d`, strings in `v.s` and any other pointer in `v.p`. Arguments of any
+// other type (e.g. structures or `long double`) are a compile time error.
+// With no arguments, `VRG_pack()` expands to `0, NULL`.
+//
+// `_Generic` is a C11 feature, argument packs are not available in C++.
+
+#if !defined(__cplusplus) && defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+
+typedef enum {
+  VRG_T_NONE = 0,
+  VRG_T_BOOL,   VRG_T_CHAR,   VRG_T_SCHAR,  VRG_T_UCHAR,
+  VRG_T_SHORT,  VRG_T_USHORT, VRG_T_INT,    VRG_T_UINT,
+  VRG_T_LONG,   VRG_T_ULONG,  VRG_T_LLONG,  VRG_T_ULLONG,
+  VRG_T_FLOAT,  VRG_T_DOUBLE, VRG_T_STR,    VRG_T_PTR
+} vrg_type_t;
+
+typedef struct {
+  vrg_type_t type;
+  union {
+             long long  i;
+    unsigned long long  u;
+                double  d;
+          const char   *s;
+          const void   *p;
+  } v;
+} vrg_val_t;
+
+#define VRG_val_fn(n_, t_, T_, f_) \
+  static inline vrg_val_t vrg_val_ ## n_(t_ x) { vrg_val_t r; r.type = T_; r.v.f_ = x; return r; }
+
+VRG_val_fn(bool,   _Bool,              VRG_T_BOOL,   i)
+VRG_val_fn(char,   char,               VRG_T_CHAR,   i)
+VRG_val_fn(schar,  signed char,        VRG_T_SCHAR,  i)
+VRG_val_fn(uchar,  unsigned char,      VRG_T_UCHAR,  u)
+VRG_val_fn(short,  short,              VRG_T_SHORT,  i)
+VRG_val_fn(ushort, unsigned short,     VRG_T_USHORT, u)
+VRG_val_fn(int,    int,                VRG_T_INT,    i)
+VRG_val_fn(uint,   unsigned int,       VRG_T_UINT,   u)
+VRG_val_fn(long,   long,               VRG_T_LONG,   i)
+VRG_val_fn(ulong,  unsigned long,      VRG_T_ULONG,  u)
+VRG_val_fn(llong,  long long,          VRG_T_LLONG,  i)
+VRG_val_fn(ullong, unsigned long long, VRG_T_ULLONG, u)
+VRG_val_fn(float,  float,              VRG_T_FLOAT,  d)
+VRG_val_fn(double, double,             VRG_T_DOUBLE, d)
+VRG_val_fn(str,    const char *,       VRG_T_STR,    s)
+VRG_val_fn(ptr,    const void *,       VRG_T_PTR,    p)
+
+// Only the selected function is called, this is why `_Generic` returns a function
+// rather than the value (all the associations must be valid for any argument).
+#define vrg_val(x) \
+  _Generic((x), _Bool: vrg_val_bool,   char: vrg_val_char, \
+           signed char: vrg_val_schar, unsigned char: vrg_val_uchar, \
+                 short: vrg_val_short, unsigned short: vrg_val_ushort, \
+                   int: vrg_val_int,   unsigned int: vrg_val_uint, \
+                  long: vrg_val_long,  unsigned long: vrg_val_ulong, \
+             long long: vrg_val_llong, unsigned long long: vrg_val_ullong, \
+                 float: vrg_val_float, double: vrg_val_double, \
+                char *: vrg_val_str,   const char *: vrg_val_str, \
+               default: vrg_val_ptr)(x)
+
+#define VRG_pack(...)   VRG_join(VRG_pack_, VRG_sel(1,__VA_ARGS__))(__VA_ARGS__)
+#define VRG_pack_0(...) 0, (const vrg_val_t *)0
+#define VRG_pack_1(...) VRG_nargs(__VA_ARGS__), (const vrg_val_t[]){ VRG_map(vrg_val, (,), __VA_ARGS__) }
+
+#endif
+
+// ## Writing numbers
+//
+// The writers of `trc.h`, `rec.h` and `prt.h` convert numbers to text with these.
+
+// Writes `u` in decimal, two digits at a time, so that it ends right before `end`.
+// Returns where it starts (up to 20 chars before `end`).
+static inline char *vrg_utoa(char *end, unsigned long long u)
+{
+  static const char digits[] = "00010203040506070809101112131415161718192021222324"
+                               "25262728293031323334353637383940414243444546474849"
+                               "50515253545556575859606162636465666768697071727374"
+                               "75767778798081828384858687888990919293949596979899";
+  while (u >= 100) {
+    end -= 2;
+    end[0] = digits[(u % 100) * 2]; end[1] = digits[(u % 100) * 2 + 1];
+    u /= 100;
+  }
+  if (u >= 10) { end -= 2; end[0] = digits[u * 2]; end[1] = digits[u * 2 + 1]; }
+  else *--end = (char)('0' + u);
+  return end;
+}
+
+// Writes `d` in `tmp` as an integer `m` of `digits` digits divided by `10^k` and returns
+// its length, or 0 if that doesn't read back as `d` (as a float if `flt`). When `m` and
+// `10^k` are exact doubles, their division is correctly rounded, which makes the check
+// exact. It's the common case for values between 1e-5 and 1e15.
+static inline int vrg_fixed(char *tmp, double d, int digits, int flt)
+{
+  static const double p10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  char dig[24], *p = tmp;
+  double a = d < 0 ? -d : d, q;
+  int e = 0, k, n = 0, z = 0;
+  unsigned long long m;
+
+  if (a < 1e-5 || a >= 1e15) return 0;
+  if (a >= 1) while (a >= p10[e + 1]) e++;
+  else while (a * p10[-e] < 1) e--;
+  if ((k = digits - 1 - e) < 0 || k > 22 || (q = a * p10[k] + 0.5) >= 9007199254740992.0) return 0;
+  m = (unsigned long long)q;
+  if (flt ? (float)(m / p10[k]) != (float)a : m / p10[k] != a) return 0;
+
+  do { dig[n++] = (char)('0' + m % 10); m /= 10; } while (m > 0);  // Reversed
+  while (k > 0 && dig[z] == '0') { z++; k--; }                      // No trailing zeros
+  if (d < 0) *p++ = '-';
+  if (n - z <= k) *p++ = '0';
+  while (n - z > k) *p++ = dig[--n];
+  if (k > 0) {
+    *p++ = '.';
+    for (int i = k - (n - z); i > 0; i--) *p++ = '0';
+    while (n > z) *p++ = dig[--n];
+  }
+  return (int)(p - tmp);
+}
+
+// The shortest of the fixed forms of the finite value `d` (up to 15 digits, 6 then 9 for
+// floats) that reads back as `d`: `0.1` rather than `0.10000000000000001`. Zero keeps
+// its sign (`-0`). Returns 0 if there's none (the caller uses `%.17g` or `%.9g`).
+static inline int vrg_shortest(char *tmp, double d, int flt)
+{
+  union { double d; unsigned long long u; } bits;
+  int n;
+  if (d == 0) {
+    bits.d = d;
+    if (bits.u >> 63) { tmp[0] = '-'; tmp[1] = '0'; return 2; }
+    tmp[0] = '0';
+    return 1;
+  }
+  if ((n = vrg_fixed(tmp, d, flt ? 6 : 15, flt)) == 0 && flt) n = vrg_fixed(tmp, d, 9, 1);
+  return n;
+}
+
 #endif // VRG_VERSION_H
@@ -0,0 +1,70 @@
+//  SPDX-FileCopyrightText: © 2025 Remo Dentato (rdentato@gmail.com)
+//  SPDX-License-Identifier: MIT
+
+// # Fixture for the tests of `cli.h`
+//
+// Include it in place of `cli.h`, after the configuration macros. `CLI_EXIT()` jumps back
+// to the test instead of exiting, and what `cli.h` writes can go into `out` (set
+// `cliwrite = to_buffer;` at the start of the suite).
+//
+// The function that runs the parser calls `clitest_catch()` first: it clears `out` and, if
+// `CLI_EXIT(n)` is called later, that function returns `n + 1`.
+//
+//     static int parse_args(int argc, char **argv)
+//     {
+//       clitest_catch();
+//       clioptions("test", argc, argv) { ... }
+//       return 0;
+//     }
+//
+// With `CLITEST_PROG` defined, `parse("-v", "x")` calls `parse_args()` with the arguments
+// `{CLITEST_PROG, "-v", "x", NULL}`.
+//
+// With `CLITEST_SHARED` defined, `on_exit_jb` can be used by other translation units
+// (which declare it as `extern`).
+
+#ifndef CLITEST_H
+#define CLITEST_H
+
+#include <setjmp.h>
+#include <string.h>
+
+#ifdef CLITEST_SHARED
+jmp_buf on_exit_jb;
+#else
+static jmp_buf on_exit_jb;
+#endif
+
+#define CLI_EXIT(n) longjmp(on_exit_jb, (n) + 1)
+#include "cli.h"
+
+static char out[1024];
+static int  out_len = 0;
+
+static inline void out_reset(void)
+{
+  out_len = 0;
+  out[0] = '\0';
+}
+
+static inline void to_buffer(const char *s, int len)
+{
+  if (out_len + len >= (int)sizeof(out)) len = (int)sizeof(out) - 1 - out_len;
+  memcpy(out + out_len, s, len);
+  out_len += len;
+  out[out_len] = '\0';
+}
+
+#define clitest_catch() \
+  do { \
+    int clitest_ret; \
+    out_reset(); \
+    if ((clitest_ret = setjmp(on_exit_jb)) != 0) return clitest_ret; \
+  } while (0)
+
+#ifdef CLITEST_PROG
+#define parse(...) parse_args(sizeof((char *[]){CLITEST_PROG, __VA_ARGS__}) / sizeof(char *), \
+                              (char *[]){CLITEST_PROG, __VA_ARGS__, NULL})
+#endif
+
+#endif // CLITEST_H
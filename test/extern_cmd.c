@@ -0,0 +1,22 @@
+#define CLI_EXTERN
+#include <setjmp.h>
+
+extern jmp_buf on_exit_jb;
+
+#define CLI_EXIT(n) longjmp(on_exit_jb, (n) + 1)
+#include "cli.h"
+
+// The `build` command of t_extern.c: only calls to the parser are compiled here
+
+int jobs;
+
+int build_cli(int argc, char **argv)
+{
+  clioptions("Build the project", argc, argv) {
+    cliopt("-j, --jobs n (1)\tParallel jobs") { jobs = atoi(cliarg); }
+    cliopt("-k, --keep\tKeep going") { }
+    cliopt("[target]\tWhat to build") { }
+    cliopt() { cliunknown(); }
+  }
+  return 7;
+}
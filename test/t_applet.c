@@ -0,0 +1,94 @@
+#include "clitest.h"
+#include "tst.h"
+
+static int all, defined;
+static char *file;
+
+static int ls_main(int argc, char **argv)
+{
+  clioptions("List files", argc, argv) {
+    cliopt("-a, --all\tAll files") { all++; }
+    cliopt("[file]\tThe file") { file = cliarg; }
+    cliopt();
+  }
+  defined = cli_num_options + cli_num_commands + cli_num_arguments;
+  return 3;
+}
+
+static int cp_main(int argc, char **argv)
+{
+  clioptions("Copy files", argc, argv) {
+    cliopt("-f, --force\tOverwrite") { }
+    cliopt("src\tThe source") { }
+    cliopt("dst\tThe destination") { file = cliarg; }
+    cliopt();
+  }
+  defined = cli_num_options + cli_num_commands + cli_num_arguments;
+  return 4;
+}
+
+static int true_main(int argc, char **argv)
+{
+  return 0;
+}
+
+static cli_applet_t applets[] = {
+  {"ls", ls_main},
+  {"cp", cp_main},
+  {"true", true_main},
+};
+
+// Returns what the applet returned + 10, to tell it from a `CLI_EXIT()`.
+static int run_args(int argc, char **argv)
+{
+  all = defined = 0;
+  file = NULL;
+  cliprogname = NULL;
+  clitest_catch();
+  return cliapplet(argc, argv, applets) + 10;
+}
+
+#define run(...) run_args(sizeof((char *[]){__VA_ARGS__}) / sizeof(char *), \
+                          (char *[]){__VA_ARGS__, NULL})
+
+tstsuite("Multi-call programs")
+{
+  cliwrite = to_buffer;
+
+  tstcase("Applet from the name of the executable") {
+    tstcheck(run("/usr/bin/ls", "-a", "x") == 13, "%s", out);
+    tstcheck(all == 1 && strcmp(file, "x") == 0);
+    tstcheck(defined == 2, "defined: %d", defined);
+    tstcheck(run("cp", "a", "b") == 14, "%s", out);
+    tstcheck(defined == 3 && strcmp(file, "b") == 0);
+    tstcheck(run("C:\\bin\\true.exe") == 10);
+  }
+
+  tstcase("Applet from the first argument") {
+    tstcheck(run("./box", "ls", "--all") == 13, "%s", out);
+    tstcheck(all == 1 && file == NULL);
+    tstcheck(run("box", "cp", "a") == 2);
+    tstcheck(strcmp(out, "box cp: ERROR: Missing or invalid value for 'dst'\n\n") == 0, "%s", out);
+  }
+
+  tstcase("Unknown applets") {
+    tstcheck(run("/bin/box") == 2);
+    tstcheck(strcmp(out, "box: ERROR: Unknown applet 'box'\n\n") == 0, "%s", out);
+    tstcheck(run("box", "rm", "x") == 2);
+    tstcheck(strcmp(out, "box: ERROR: Unknown applet 'rm'\n\n") == 0, "%s", out);
+    tstcheck(run("box", "l") == 2);
+    tstcheck(run("box", "lsx") == 2);
+  }
+
+  tstcase("Tables that are not arrays") {
+    cli_applet_t *tbl = applets + 1;   // "cp" and "true"
+    char *ls[] = {"ls", NULL}, *tr[] = {"true", NULL};
+    int ret;
+    out_reset();
+    cliprogname = NULL;
+    if ((ret = setjmp(on_exit_jb)) == 0) ret = cliapplet(1, ls, tbl, 2) + 10;
+    tstcheck(ret == 2);
+    tstcheck(strcmp(out, "ls: ERROR: Unknown applet 'ls'\n\n") == 0, "%s", out);
+    tstcheck(cliapplet(1, tr, tbl, 2) == 0);
+  }
+}
@@ -0,0 +1,57 @@
+#include "tst.h"
+#include "vrg.h"
+
+static int sum_0(void)                    { return 0; }
+static int sum_1(int a)                   { return a; }
+static int sum_2(int a, int b)            { return a + b; }
+static int sum_3(int a, int b, int c)     { return a + b + c; }
+static int sum_4(int a, int b, int c, int d) { return a + b + c + d; }
+
+#define sum_arities  0, 1, 2, 3, 4
+#define sum_arity_error(n)  (-1)
+
+// Targets can be macros as well
+#define mul_1(a)        (a)
+#define mul_2(a,b)      ((a)*(b))
+#define mul_9(a,b,c,d,e,f,g,h,i)  ((a)*(b)*(c)*(d)*(e)*(f)*(g)*(h)*(i))
+
+#define mul_arities  1, 2, 9
+#define mul_arity_error(n)  (errors++, 0)
+
+static int errors = 0;
+
+// An interpreter call site: the arity is only known at runtime
+int call_sum(int n, const int *a) { return VRG_apply(sum_, n, a); }
+
+tstsuite("Calling with a runtime number of arguments")
+{
+  int a[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+  tstcase("Functions") {
+    tstcheck(call_sum(0, a) == 0);
+    tstcheck(call_sum(1, a) == 1);
+    tstcheck(call_sum(2, a) == 3);
+    tstcheck(call_sum(3, a) == 6);
+    tstcheck(call_sum(4, a) == 10);
+  }
+
+  tstcase("Wrong number of arguments") {
+    tstcheck(call_sum(5, a) == -1);
+    tstcheck(call_sum(-1, a) == -1);
+  }
+
+  tstcase("Macros") {
+    int n;
+    n = 1; tstcheck(VRG_apply(mul_, n, a) == 1);
+    n = 2; tstcheck(VRG_apply(mul_, n, a) == 2);
+    n = 9; tstcheck(VRG_apply(mul_, n, a) == 362880);
+    n = 3; tstcheck(VRG_apply(mul_, n, a) == 0 && errors == 1);
+  }
+
+  tstcase("Other element types") {
+    double d[] = {0.5, 0.25};
+    int n = 2;
+    tstcheck(VRG_apply(mul_, n, d) == 0.125);
+    tstcheck(VRG_apply(sum_, n, d) == 0);   // Converted to int as any argument
+  }
+}
@@ -0,0 +1,76 @@
+#define _POSIX_C_SOURCE 200809L
+#define CLI_THREADS 4
+#define CLITEST_PROG "t_async"
+#include "clitest.h"
+#include "tst.h"
+
+#include <time.h>
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static int done;         // Jobs completed
+static int order[16];    // The ordered handlers, as they were run
+static int n_order;
+
+// Waits for `arg` milliseconds (as if waiting for I/O); fails if `arg` is "x"
+static char *slow(char *arg)
+{
+  int ms = atoi(arg);
+  if (*arg == 'x') return "Can't load";
+  nanosleep(&(struct timespec){0, ms * 1000000L}, NULL);
+  pthread_mutex_lock(&lock);
+  done++;
+  pthread_mutex_unlock(&lock);
+  return NULL;
+}
+
+static int parse_args(int argc, char **argv)
+{
+  done = n_order = 0;
+  clitest_catch();
+  clioptions("async test", argc, argv) {
+    cliopt("-m, --model ms\tLoad the model") { cliasync(slow); }
+    cliopt("-c, --cache ms\tWarm the cache") { cliasync(slow); }
+    cliopt("-o, --order n\tAn ordered handler") { order[n_order++] = atoi(cliarg); }
+    cliopt();
+  }
+  return 0;
+}
+
+tstsuite("Asynchronous handlers")
+{
+  cliwrite = to_buffer;
+
+  tstcase("Jobs run concurrently") {
+    double t0 = now();
+    tstcheck(parse("-m", "100", "-o", "1", "-c", "100", "-o", "2", "--model", "100") == 0, "%s", out);
+    double t = now() - t0;
+    tstcheck(done == 3, "done: %d", done);
+    tstcheck(t < 0.25, "%.3f s", t);
+  }
+
+  tstcase("Ordered handlers keep their order") {
+    tstcheck(parse("-o", "1", "-m", "10", "-o", "2", "-o", "3", "-c", "0", "-o", "4") == 0);
+    tstcheck(n_order == 4 && order[0] == 1 && order[1] == 2 && order[2] == 3 && order[3] == 4);
+  }
+
+  tstcase("Many jobs") {
+    char *argv[41];
+    argv[0] = "t_async";
+    for (int k = 1; k < 41; k += 2) { argv[k] = "-c"; argv[k + 1] = "1"; }
+    tstcheck(parse_args(41, argv) == 0);
+    tstcheck(done == 20, "done: %d", done);
+  }
+
+  tstcase("Errors are reported in order") {
+    tstcheck(parse("-m", "x", "-c", "20", "--cache", "x") == 2);
+    tstcheck(strcmp(out, "t_async: ERROR: Can't load 'x'\n\nt_async: ERROR: Can't load 'x'\n\n") == 0, "%s", out);
+    tstcheck(done == 1);
+  }
+}
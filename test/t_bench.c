@@ -0,0 +1,52 @@
+#define _POSIX_C_SOURCE 200809L
+#include "cli.h"
+#include "tst.h"
+
+// Performance checks: run with `--save=bench.base` to record a baseline and with
+// `--baseline=bench.base` to compare with it (see `make bench_save` and `make bench_check`).
+
+static volatile int sink;
+
+static int parse(int argc, char **argv)
+{
+  int n = 0;
+  clioptions("bench test", argc, argv) {
+    cliopt("-a, --all\tAll") { n++; }
+    cliopt("-b, --block-size size\tBlock size") { n += atoi(cliarg); }
+    cliopt("-l, --long-listing-format\tLong") { n++; }
+    cliopt("-r, --reverse\tReverse") { n++; }
+    cliopt("-w, --width cols\tWidth") { n += atoi(cliarg); }
+    cliopt("--color [when]\tColor") { n++; }
+    cliopt("--time-style style\tTime style") { n++; }
+    cliopt("[file]\tFile") { n++; }
+    cliopt() { }
+  }
+  return n;
+}
+
+static int f(int a, int b, int c) { return a + b * c; }
+
+#define call(...)    vrg(call_, __VA_ARGS__)
+#define call_0()     f(0, 0, 0)
+#define call_1(a)    f(a, 1, 1)
+#define call_2(a,b)  f(a, b, 1)
+#define call_3(a,b,c) f(a, b, c)
+
+tstsuite("Performance checks")
+{
+  tstcase("cli") {
+    char *argv[] = {"t_bench", "--long-listing-format", "--width=120", "-ar", "file.txt",
+                    "--color=always", "-b", "4096", NULL};
+    tstcheck(parse(8, argv) == 4221);
+    tstbench("clioptions() with 7 arguments") {
+      sink = parse(8, argv);
+    }
+  }
+
+  tstcase("vrg") {
+    volatile int x = 3;
+    tstbench("vrg() dispatch") {
+      sink = call() + call(x) + call(x, 2) + call(x, 2, x);
+    }
+  }
+}
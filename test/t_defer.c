@@ -0,0 +1,100 @@
+#define _POSIX_C_SOURCE 200809L
+#define CLI_THREADS 4
+#define CLI_DEFER_SLICE 16
+#include "cli.h"
+#include "tst.h"
+
+#include <unistd.h>
+#include <sys/wait.h>
+
+static int n_seen;
+static int when[256];  // The number of handlers executed when `k` was checked
+
+static char *is_number(char *arg)
+{
+  for (char *s = arg; *s; s++)
+    if (*s < '0' || *s > '9') return "Not a number";
+  if (atoi(arg) < 256) when[atoi(arg)] = n_seen;
+  return NULL;
+}
+
+static char *is_short(char *arg) { return strlen(arg) < 4 ? NULL : "Too long"; }
+
+static char *seen[256];
+static char *label;
+
+static int parse(int argc, char **argv)
+{
+  n_seen = 0;
+  label = NULL;
+  clioptions("defer test", argc, argv) {
+    cliopt("-l, --label name\tA label", is_short, CLIDEFER) {
+      label = cliarg;
+    }
+    cliopt() {
+      clidefer(is_number);
+      seen[n_seen++] = cliarg;
+    }
+  }
+  return 0;
+}
+
+// Runs `parse()` in a child process; returns the exit status and what it wrote on stderr.
+static int run(int argc, char **argv, char *err, int size)
+{
+  int fd[2], status = 0, n = 0, r;
+  if (pipe(fd) != 0) return -1;
+  pid_t pid = fork();
+  if (pid == 0) {
+    dup2(fd[1], 2);
+    close(fd[0]);
+    parse(argc, argv);
+    exit(0);
+  }
+  close(fd[1]);
+  while (n < size - 1 && (r = read(fd[0], err + n, size - 1 - n)) > 0) n += r;
+  err[n] = '\0';
+  close(fd[0]);
+  waitpid(pid, &status, 0);
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+tstsuite("Deferred validation")
+{
+  static char nums[200][8];
+  char *argv[210];
+  char err[4096];
+
+  argv[0] = "t_defer";
+  for (int k = 0; k < 200; k++) {
+    snprintf(nums[k], sizeof(nums[k]), "%d", k);
+    argv[k + 1] = nums[k];
+  }
+
+  tstcase("All valid") {
+    argv[201] = "-l"; argv[202] = "abc";
+    parse(203, argv);
+    tstcheck(n_seen == 200 && label != NULL && strcmp(label, "abc") == 0);
+    tstcheck(strcmp(seen[0], "0") == 0 && strcmp(seen[199], "199") == 0);
+    tstcheck(cli_num_deferred == 0 && cli_deferred == NULL);
+  }
+
+  tstcase("All errors are reported, in order") {
+    argv[201] = "-l"; argv[202] = "abcdef";
+    argv[50] = "x49"; argv[150] = "x149";
+    tstcheck(run(203, argv, err, sizeof(err)) == 1);
+    char *e1 = strstr(err, "Not a number 'x49'");
+    char *e2 = strstr(err, "Not a number 'x149'");
+    char *e3 = strstr(err, "Too long '-l'");
+    tstcheck(e1 && e2 && e3 && e1 < e2 && e2 < e3, "%s", err);
+    argv[50] = nums[49]; argv[150] = nums[149];
+  }
+
+  tstcase("Handlers run in order, before the checks") {
+    int errors = 0;
+    argv[201] = "-l"; argv[202] = "abc";
+    parse(203, argv);
+    for (int k = 0; k < 200; k++) errors += (seen[k] != nums[k]) + (when[k] != 200);
+    tstcheck(errors == 0, "%d", errors);
+  }
+}
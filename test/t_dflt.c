@@ -0,0 +1,63 @@
+#include "tst.h"
+#include "vrg.h"
+
+int open_file_impl(const char *path, const char *mode, int flags, int bufsize);
+
+#define open_file(...) \
+  VRG_defaults(open_file_impl, ((path), (mode, "r"), (flags, 0), (bufsize, 4096)), __VA_ARGS__)
+
+typedef struct { int x, y; } point_t;
+
+static int mark(int a, char b, const char *c, point_t p) { return a + b + (c != NULL) + p.x + p.y; }
+
+#define mark(...) VRG_defaults(mark, ((a, 1), (b, 'b'), (c, NULL), (p, ((point_t){2, 3}))), __VA_ARGS__)
+
+static struct { const char *path, *mode; int flags, bufsize; } last;
+
+#ifdef __GNUC__
+__attribute__((noinline))
+#endif
+int open_file_impl(const char *path, const char *mode, int flags, int bufsize)
+{
+  last.path = path; last.mode = mode;
+  last.flags = flags; last.bufsize = bufsize;
+  return path != NULL;
+}
+
+// These two functions must compile to the same code (see `make asm_dflt`)
+int call_with_defaults(void) { return open_file("x.txt", "w"); }
+int call_by_hand(void)       { return open_file_impl("x.txt", "w", 0, 4096); }
+
+tstsuite("Positional defaults")
+{
+  tstcase("Required argument only") {
+    open_file("a.txt");
+    tstcheck(strcmp(last.path, "a.txt") == 0 && strcmp(last.mode, "r") == 0);
+    tstcheck(last.flags == 0 && last.bufsize == 4096);
+  }
+
+  tstcase("Some defaults") {
+    open_file("a.txt", "w");
+    tstcheck(strcmp(last.mode, "w") == 0 && last.flags == 0 && last.bufsize == 4096);
+    open_file("a.txt", "a", 3);
+    tstcheck(strcmp(last.mode, "a") == 0 && last.flags == 3 && last.bufsize == 4096);
+  }
+
+  tstcase("No defaults") {
+    open_file("a.txt", "r+", 7, 16);
+    tstcheck(strcmp(last.mode, "r+") == 0 && last.flags == 7 && last.bufsize == 16);
+  }
+
+  tstcase("All optional") {
+    tstcheck(mark() == 1 + 'b' + 0 + 5);
+    tstcheck(mark(10) == 10 + 'b' + 5);
+    tstcheck(mark((int)10, 'a') == 10 + 'a' + 5);
+    tstcheck(mark(0, 0, "c") == 1 + 5);
+    tstcheck(mark(0, 0, NULL, ((point_t){0, 1})) == 1);
+  }
+
+  tstcase("Same as hand written") {
+    tstcheck(call_with_defaults() == call_by_hand());
+    tstcheck(strcmp(last.mode, "w") == 0 && last.bufsize == 4096);
+  }
+}
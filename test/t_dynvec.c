@@ -0,0 +1,87 @@
+#include "tst.h"
+#include "vec.h"
+
+typedef struct { int x, y; } point_t;
+
+typedef vec_t(int) intvec_t;
+typedef vec_t(point_t, 2) ptvec_t;
+
+tstsuite("Dynamic vectors")
+{
+  tstcase("Inline storage") {
+    intvec_t v;
+    vecinit(&v);
+    tstcheck(v.len == 0 && v.cap == VEC_SMALL / sizeof(int) && v.data == v.small);
+    for (int k = 0; k < (int)v.cap; k++) vecpush(&v, k);
+    tstcheck(v.len == v.cap && v.data == v.small);
+    tstcheck(v.data[0] == 0 && v.data[v.len - 1] == (int)v.len - 1);
+    vecfree(&v);
+    tstcheck(v.len == 0 && v.data == v.small);
+  }
+
+  tstcase("Growth") {
+    intvec_t v;
+    int ok = 1;
+    size_t cap = 0;
+    int grown = 0;
+    vecinit(&v);
+    for (int k = 0; k < 10000; k++) {
+      ok &= vecpush(&v, k) == &v.data[k];
+      if (v.cap != cap) { grown++; cap = v.cap; }
+    }
+    tstcheck(ok && v.len == 10000 && v.data != v.small);
+    tstcheck(grown <= 12, "%d", grown);   // Doubling: 16 -> 16384
+    for (int k = 0; k < 10000; k++) ok &= v.data[k] == k;
+    tstcheck(ok);
+    tstcheck(vecpop(&v) == 9999 && v.len == 9999);
+    vecclear(&v);
+    tstcheck(v.len == 0 && v.cap == cap);
+    vecfree(&v);
+    tstcheck(v.data == v.small && v.cap == VEC_SMALL / sizeof(int));
+  }
+
+  tstcase("Bulk push and reserve") {
+    intvec_t v;
+    int a[100];
+    for (int k = 0; k < 100; k++) a[k] = k * 2;
+    vecinit(&v);
+    vecpush(&v, -1);
+    tstcheck(vecpush(&v, a, 100) == &v.data[1]);
+    tstcheck(v.len == 101 && v.data[1] == 0 && v.data[100] == 198);
+    tstcheck(vecpush(&v, a, 0) == &v.data[101] && v.len == 101);
+    tstcheck(vecreserve(&v, 1000) && v.cap >= 1101);
+    int *d = v.data;
+    for (int k = 0; k < 1000; k++) vecpush(&v, k);
+    tstcheck(v.data == d);   // No reallocation after reserve
+    vecfree(&v);
+  }
+
+  tstcase("Structures") {
+    ptvec_t v;
+    vecinit(&v);
+    tstcheck(v.cap == 2);
+    vecpush(&v, ((point_t){1, 2}));
+    point_t *p = vecpush(&v);
+    p->x = 3; p->y = 4;
+    vecpush(&v)->x = 5;
+    tstcheck(v.len == 3 && v.data != v.small);
+    tstcheck(v.data[0].y == 2 && v.data[1].x == 3 && v.data[2].x == 5);
+    vecfree(&v);
+  }
+
+  tstcase("Out of memory") {
+    intvec_t v;
+    volatile size_t huge = (size_t)-1 / 4;   // Not a constant the compiler can check
+    vecinit(&v);
+    vecpush(&v, 1);
+    tstcheck(!vecreserve(&v, huge));
+    tstcheck(vecpush(&v, v.data, huge) == NULL);
+    vecpush(&v, 2);
+    huge = (size_t)-1;                       // `len + huge` wraps around
+    tstcheck(!vecreserve(&v, huge));
+    tstcheck(vecpush(&v, v.data, huge) == NULL);
+    tstcheck(!vecreserve(&v, huge - 1) && !vecreserve(&v, huge - 2));
+    tstcheck(v.len == 2 && v.data[0] == 1 && v.data[1] == 2 && v.data == v.small);
+    vecfree(&v);
+  }
+}
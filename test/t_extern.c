@@ -0,0 +1,52 @@
+#define CLI_IMPLEMENTATION
+#define CLITEST_SHARED    // `on_exit_jb` is used by extern_cmd.c
+#define CLITEST_PROG "t_extern"
+#include "clitest.h"
+#include "tst.h"
+
+// The `clioptions()` block of the `build` command is in another translation unit
+// (extern_cmd.c), which includes `cli.h` with `CLI_EXTERN` defined.
+int build_cli(int argc, char **argv);
+extern int jobs;
+
+static int verbose;
+
+static int parse_args(int argc, char **argv)
+{
+  verbose = jobs = 0;
+  cliprogname = NULL;
+  clicmdrc = -1;
+  clitest_catch();
+  clioptions("extern test", argc, argv) {
+    cliopt("-v, --verbose\tVerbose") { verbose++; }
+    cliopt("<build>\tBuild the project") { clicommand(build_cli); }
+    cliopt();
+  }
+  return 0;
+}
+
+tstsuite("One implementation shared by two translation units")
+{
+  cliwrite = to_buffer;
+
+  tstcase("Parsing in the other unit") {
+    tstcheck(parse("-v", "build", "-j", "3", "all") == 0, "%s", out);
+    tstcheck(verbose == 1 && jobs == 3);
+    tstcheck(clicmdrc == 7);
+  }
+
+  tstcase("The state is shared") {
+    // The counters have been set by the block of `build`
+    tstcheck(parse("build", "-k") == 0, "%s", out);
+    tstcheck(cli_num_options == 2 && cli_num_arguments == 1,
+             "%d %d", cli_num_options, cli_num_arguments);
+    tstcheck(jobs == 1);
+  }
+
+  tstcase("Errors in the other unit") {
+    tstcheck(parse("build", "-j") == 2);
+    tstcheck(strcmp(out, "t_extern build: ERROR: Missing or invalid value for '-j'\n\n") == 0, "%s", out);
+    tstcheck(parse("build", "-x") == 2);
+    tstcheck(strncmp(out, "t_extern build: ERROR: Unknown option '-x'", 42) == 0, "%s", out);
+  }
+}
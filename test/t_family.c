@@ -0,0 +1,116 @@
+#define CLITEST_PROG "t_family"
+#include "clitest.h"
+#include "tst.h"
+
+static int verbose, jobs, defined, fast;
+static char *target;
+
+static int remote_cli(int argc, char **argv)
+{
+  clioptions("Manage remotes", argc, argv) {
+    cliopt("-f, --fast\tFast") { fast++; }
+    cliopt("name\tThe remote") { target = cliarg; }
+    cliopt();
+  }
+  return 3;
+}
+
+static int build_cli(int argc, char **argv)
+{
+  clioptions("Build the project", argc, argv) {
+    cliopt("-h, --help\tThis help") { cliusage(CLIEXIT); }
+    cliopt("-j, --jobs n\tParallel jobs") { jobs = atoi(cliarg); }
+    cliopt("-f, --fast\tFast") { fast++; }
+    cliopt("-q, --quiet\tQuiet") { }
+    cliopt("<remote>\tBuild remotely") { clicommand(remote_cli); }
+    cliopt("[target]\tWhat to build") { target = cliarg; }
+    cliexclusive("-f", "-q");
+    cliopt();
+  }
+  defined = cli_num_options + cli_num_commands + cli_num_arguments;
+  return 7;
+}
+
+static int test_cli(int argc, char **argv)
+{
+  clioptions("Run the tests", argc, argv) {
+    cliopt("-k, --keep\tKeep going") { }
+    cliopt();
+  }
+  return 0;
+}
+
+static int parse_args(int argc, char **argv)
+{
+  verbose = jobs = defined = fast = 0;
+  target = NULL;
+  cliprogname = NULL;
+  clicmdrc = -1;
+  clitest_catch();
+  clioptions("family test", argc, argv) {
+    cliopt("-v, --verbose\tVerbose") { verbose++; }
+    cliopt("<build>\tBuild the project") { clicommand(build_cli); }
+    cliopt("<test>\tRun the tests") { clicommand(test_cli); }
+    cliopt();
+  }
+  return 0;
+}
+
+tstsuite("Command families")
+{
+  cliwrite = to_buffer;
+
+  tstcase("Only the selected command is defined") {
+    tstcheck(parse("-v", "build", "-j", "4", "all") == 0, "%s", out);
+    tstcheck(verbose == 1 && jobs == 4 && target && strcmp(target, "all") == 0);
+    tstcheck(clicmdrc == 7);
+    tstcheck(defined == 6, "defined: %d", defined);
+  }
+
+  tstcase("No command") {
+    tstcheck(parse("-v") == 0);
+    tstcheck(verbose == 1 && clicmdrc == -1);
+  }
+
+  tstcase("Options of other commands") {
+    tstcheck(parse("test", "-j", "4") == 0);
+    tstcheck(jobs == 0 && clicmdrc == 0);
+    tstcheck(parse("-j", "4", "build") == 0);
+    tstcheck(jobs == 0 && clicmdrc == 7);
+  }
+
+  tstcase("Nested commands") {
+    tstcheck(parse("build", "-f", "remote", "--fast", "origin") == 0, "%s", out);
+    tstcheck(fast == 2 && target && strcmp(target, "origin") == 0);
+    tstcheck(clicmdrc == 7);
+  }
+
+  tstcase("The help of a command") {
+    tstcheck(parse("-v", "build", "-h") == 2, "%s", out);
+    tstcheck(strstr(out, "--jobs") && strstr(out, "remote") && strstr(out, "target"), "%s", out);
+    tstcheck(!strstr(out, "--verbose") && !strstr(out, "test"), "%s", out);
+  }
+
+  tstcase("Constraint groups of a command") {
+    tstcheck(parse("-v", "build", "-q", "x") == 0, "%s", out);
+    tstcheck(parse("build", "-h", "-q") == 2, "%s", out);
+    tstcheck(strstr(out, "can't be used together") == NULL, "%s", out);
+    tstcheck(parse("build", "-f", "-q") == 2);
+    tstcheck(strcmp(out, "t_family build: ERROR: '-f', '-q' can't be used together\n\n") == 0, "%s", out);
+  }
+
+  tstcase("The outer options after a command") {
+    tstcheck(parse("build", "-h") == 2);        // Leaves the block of `build` with a jump
+    tstcheck(parse("build", "-f") == 0, "%s", out);
+    tstcheck(cli_head != NULL && strncmp(cli_head->def, "-v", 2) == 0, "%s", cli_head ? cli_head->def : "");
+    tstcheck(parse("-v", "test", "-k") == 0, "%s", out);
+    tstcheck(verbose == 1 && clicmdrc == 0);
+  }
+
+  tstcase("Messages mention the command") {
+    tstcheck(parse("build", "-j") == 2);
+    tstcheck(strcmp(out, "t_family build: ERROR: Missing or invalid value for '-j'\n\n") == 0, "%s", out);
+    tstcheck(parse("build", "remote") == 2);
+    tstcheck(strcmp(out, "t_family build remote: ERROR: Missing or invalid value for 'name'\n\n") == 0, "%s", out);
+  }
+}
@@ -0,0 +1,60 @@
+#define _POSIX_C_SOURCE 200809L
+#define CLI_FREESTANDING
+#include "clitest.h"
+
+#if defined(EOF) || defined(EXIT_FAILURE)
+#error "cli.h should not include stdio.h or stdlib.h in the freestanding profile"
+#endif
+
+#include "tst.h"
+
+static int count;
+
+static int parse(int argc, char **argv)
+{
+  count = 0;
+  clitest_catch();
+  clioptions("free test", argc, argv) {
+    cliopt("-h, --help\tThis help") {
+      cliusage(CLIEXIT);
+    }
+    cliopt("-n, --num n ($T_FREE_NUM,3)\tA number") {
+      count = atoi(cliarg);
+    }
+    cliopt();
+  }
+  return 0;
+}
+
+tstsuite("Freestanding profile")
+{
+  cliwrite = to_buffer;
+
+  tstcase("No output, no exit") {
+    tstcheck(parse(3, (char *[]){"t_free", "-n", "5", NULL}) == 0);
+    tstcheck(count == 5 && out_len == 0);
+  }
+
+  tstcase("Errors") {
+    tstcheck(parse(2, (char *[]){"t_free", "-n", NULL}) == 2);
+    tstcheck(strcmp(out, "t_free: ERROR: Missing or invalid value for '-n'\n\n") == 0, "%s", out);
+  }
+
+  tstcase("Usage") {
+    tstcheck(parse(2, (char *[]){"t_free", "-h", NULL}) == 2);
+    tstcheck(strncmp(out, "free test\nUSAGE: t_free OPTIONS\n", 32) == 0, "%s", out);
+    tstcheck(strstr(out, "  -n, --num n ($T_FREE_NUM,3)\tA number\n") != NULL, "%s", out);
+  }
+
+  tstcase("No environment") {
+    setenv("T_FREE_NUM", "9", 1);
+    tstcheck(parse(1, (char *[]){"t_free", NULL}) == 0);
+    tstcheck(count == 3);
+  }
+
+  tstcase("Floats") {
+    double v[4];
+    tstcheck(clifloats("1.5,-2,0.25", v, 4) == 3 && v[0] == 1.5 && v[1] == -2.0);
+    tstcheck(clifloats("1e3", v, 4) == -1);
+  }
+}
@@ -0,0 +1,58 @@
+#define CLITEST_PROG "t_group"
+#include "clitest.h"
+#include "tst.h"
+
+static int parse_args(int argc, char **argv)
+{
+  clitest_catch();
+  clioptions("group test", argc, argv) {
+    cliopt("-L\tFollow all symlinks") { }
+    cliopt("-P\tNever follow symlinks") { }
+    cliopt("-l, --long\tLong format") { }
+    cliopt("-h, --human\tHuman readable sizes") { }
+    cliopt("-k, --kilo\tSizes in KB") { }
+    cliopt("-a, --all\tAll files") { }
+    cliopt("[file]\tThe file") { }
+
+    cliexclusive("-L", "-P");
+    clirequires("--human", "-l", "--kilo");
+    cliatleastone("-a", "file");
+    cliopt();
+  }
+  return 0;
+}
+
+tstsuite("Constraint groups")
+{
+  cliwrite = to_buffer;
+
+  tstcase("No violations") {
+    tstcheck(parse("-a") == 0, "%s", out);
+    tstcheck(parse("x", "-L") == 0, "%s", out);
+    tstcheck(parse("-P", "-a", "-h", "-l", "-k") == 0, "%s", out);
+    tstcheck(parse("-Pa") == 0, "%s", out);
+  }
+
+  tstcase("Exclusive") {
+    tstcheck(parse("-a", "-L", "-P") == 2);
+    tstcheck(strcmp(out, "t_group: ERROR: '-L', '-P' can't be used together\n\n") == 0, "%s", out);
+    tstcheck(parse("-LPa") == 2);
+  }
+
+  tstcase("Requires") {
+    tstcheck(parse("-a", "--human", "-l") == 2);
+    tstcheck(strcmp(out, "t_group: ERROR: '--human' requires '--kilo'\n\n") == 0, "%s", out);
+    tstcheck(parse("-a", "-h") == 2);
+    tstcheck(strcmp(out, "t_group: ERROR: '--human' requires '-l', '--kilo'\n\n") == 0, "%s", out);
+  }
+
+  tstcase("At least one") {
+    tstcheck(parse("-l") == 2);
+    tstcheck(strcmp(out, "t_group: ERROR: At least one is required of '-a', 'file'\n\n") == 0, "%s", out);
+  }
+
+  tstcase("All violations are reported") {
+    tstcheck(parse("-L", "-P", "-h") == 2);
+    tstcheck(strstr(out, "can't be used") && strstr(out, "requires") && strstr(out, "At least one"), "%s", out);
+  }
+}
@@ -0,0 +1,111 @@
+#define _POSIX_C_SOURCE 200809L
+#define CLI_INDIRECT
+#define CLITEST_PROG "t_indirect"
+#include "clitest.h"
+#include "tst.h"
+
+static char  *seen;      // What the validator has seen
+static char  *query, *cert, *note;
+static size_t query_len, cert_len;
+
+static char *is_select(char *arg)
+{
+  seen = arg;
+  return strncmp(arg, "select", 6) == 0 ? NULL : "Not a query";
+}
+
+static int parse_args(int argc, char **argv)
+{
+  seen = query = cert = note = NULL;
+  query_len = cert_len = 0;
+  clitest_catch();
+  clioptions("indirect test", argc, argv) {
+    cliopt("-q, --query @sql\tThe query", is_select) { query = cliargview(&query_len); }
+    cliopt("-c, --cert @pem ($T_INDIRECT_CERT)\tThe certificate") {
+      if (*cliarg && (cert = cliargview(&cert_len)) == NULL) clierror("", cliarg);
+    }
+    cliopt("-n, --note text\tA note") { note = cliarg; }
+    cliopt();
+  }
+  return 0;
+}
+
+static char *make_file(char *name, char *text, size_t len)
+{
+  FILE *f = fopen(name, "wb");
+  if (f == NULL) return NULL;
+  fwrite(text, 1, len, f);
+  fclose(f);
+  return name;
+}
+
+tstsuite("Values read from files")
+{
+  static char page[65536];
+  long page_size = sysconf(_SC_PAGESIZE);
+  char *sql = "select * from t;\n";
+
+  cliwrite = to_buffer;
+  unsetenv("T_INDIRECT_CERT");
+  tstassert(make_file("t_indirect_q.sql", sql, strlen(sql)) != NULL);
+  tstassert(make_file("t_indirect_e.sql", "", 0) != NULL);
+  tstassert(page_size > 0 && page_size <= (long)sizeof(page));
+  memset(page, 'x', sizeof(page));
+  memcpy(page, "select", 6);
+  tstassert(make_file("t_indirect_p.sql", page, page_size) != NULL);
+
+  tstcase("Values given on the command line") {
+    tstcheck(parse("-q", "select 1", "-n", "@x") == 0, "%s", out);
+    tstcheck(strcmp(query, "select 1") == 0 && query_len == 8);
+    tstcheck(strcmp(note, "@x") == 0);
+    tstcheck(parse("--query=@@select") == 2);
+    tstcheck(strcmp(seen, "@select") == 0);
+    tstcheck(cli_num_views == 0);
+  }
+
+  tstcase("Values from files") {
+    tstcheck(parse("-q", "@t_indirect_q.sql") == 0, "%s", out);
+    tstcheck(query != NULL && strcmp(query, sql) == 0, "%s", query);
+    tstcheck(query_len == strlen(sql));
+    tstcheck(seen == query);       // The file is read once
+    tstcheck(parse("--query=@t_indirect_q.sql", "-c", "@t_indirect_q.sql") == 0, "%s", out);
+    tstcheck(cert == query && cert_len == query_len);
+    tstcheck(cli_num_views == 1);
+    tstcheck(cli_views[0].mapped);
+  }
+
+  tstcase("Files that are not mapped") {
+    tstcheck(parse("-c", "@t_indirect_e.sql") == 0, "%s", out);
+    tstcheck(cert != NULL && cert[0] == '\0' && cert_len == 0);
+    tstcheck(parse("-q", "@t_indirect_p.sql") == 0, "%s", out);
+    tstcheck(query_len == (size_t)page_size && query[query_len] == '\0');
+    tstcheck(memcmp(query, page, query_len) == 0);
+    tstcheck(!cli_views[cli_num_views - 1].mapped);
+  }
+
+  tstcase("Defaults") {
+    setenv("T_INDIRECT_CERT", "@t_indirect_q.sql", 1);
+    tstcheck(parse("-n", "x") == 0, "%s", out);
+    tstcheck(cert != NULL && strcmp(cert, sql) == 0);
+    unsetenv("T_INDIRECT_CERT");
+  }
+
+  tstcase("Files that can't be read") {
+    tstcheck(parse("-q", "@t_indirect_none.sql") == 2);
+    tstcheck(strcmp(out, "t_indirect: ERROR: Can't read the file for '-q'\n\n") == 0, "%s", out);
+    tstcheck(parse("-c", "@t_indirect_none.sql") == 2);
+    tstcheck(strcmp(out, "t_indirect: ERROR: Can't read the file for '@t_indirect_none.sql'\n\n") == 0, "%s", out);
+  }
+
+  tstcase("Releasing the files") {
+    cliunmap();
+    tstcheck(cli_num_views == 0 && cli_views == NULL);
+    tstcheck(parse("-q", "@t_indirect_q.sql") == 0, "%s", out);
+    tstcheck(cli_num_views == 1);
+    cliunmap();
+  }
+
+  remove("t_indirect_q.sql");
+  remove("t_indirect_e.sql");
+  remove("t_indirect_p.sql");
+}
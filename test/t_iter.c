@@ -0,0 +1,149 @@
+#define _POSIX_C_SOURCE 200809L
+#include "cli.h"
+#include "tst.h"
+
+static char *is_num(char *arg)
+{
+  if (*arg == '\0') return NULL;
+  for (char *s = arg; *s; s++)
+    if (*s < '0' || *s > '9') return "Not a number";
+  return NULL;
+}
+
+static cli_optdef_t opts[] = {
+  {"-v, --verbose\tMore output"},                    // 0
+  {"-o, --output file (out.txt)\tThe output file"},  // 1
+  {"-n, --num [n]\tA number", is_num},               // 2
+  {"-L, --level n ($T_ITER_LEVEL,3)\tThe level", is_num},  // 3
+  {"<build>\tBuild"},                                // 4
+  {"input\tThe input file"},                         // 5
+  {"[extra]\tMore input"},                           // 6
+  {NULL}
+};
+
+// All the events as "opt:ndx:val" (with "!err" for errors), separated by spaces
+static char log_buf[512];
+
+static char *events(int argc, char **argv)
+{
+  cli_iter_t it;
+  cli_event_t *ev;
+  int n = 0;
+  log_buf[0] = '\0';
+  if (cliiter(&it, opts, argc, argv) < 0) return "FAIL";
+  while ((ev = clinext(&it)) != NULL && n < (int)sizeof(log_buf) - 64) {
+    n += snprintf(log_buf + n, sizeof(log_buf) - n, "%s%d:%d:%s", n ? " " : "", ev->opt, ev->ndx, ev->val);
+    if (ev->err) n += snprintf(log_buf + n, sizeof(log_buf) - n, "!%s", ev->err);
+  }
+  return log_buf;
+}
+
+// More long options than the index of the names can hold (`CLI_ITER_SLOTS / 2`)
+#define MANY 300
+static char         many_names[MANY][24];
+static cli_optdef_t many[MANY + 2];
+
+static char *many_events(int n)
+{
+  char *argv[] = {"t_iter", "--opt0", "run", "--opt299", "--opt150", "--opt", NULL};
+  cli_iter_t it;
+  cli_event_t *ev;
+  int len = 0;
+  for (int k = 0; k < n; k++) {
+    snprintf(many_names[k], sizeof(many_names[k]), "--opt%d\tOption %d", k, k);
+    many[k] = (cli_optdef_t){many_names[k]};
+  }
+  many[n]     = (cli_optdef_t){"<run>\tRun"};
+  many[n + 1] = (cli_optdef_t){NULL};
+  log_buf[0] = '\0';
+  if (cliiter(&it, many, 6, argv) != n + 1) return "FAIL";
+  while ((ev = clinext(&it)) != NULL)
+    len += snprintf(log_buf + len, sizeof(log_buf) - len, "%s%d", len ? " " : "", ev->opt);
+  return log_buf;
+}
+
+#define iter(...) events(sizeof((char *[]){"t_iter", __VA_ARGS__}) / sizeof(char *), \
+                         (char *[]){"t_iter", __VA_ARGS__, NULL})
+
+tstsuite("Iterating over the options")
+{
+  unsetenv("T_ITER_LEVEL");
+
+  tstcase("Options and values") {
+    char *s = iter("-v", "--output", "a.txt", "in.txt", "-n5", "--num=6", "-L", "2");
+    tstcheck(strcmp(s, "1:0:out.txt 3:0:3 0:1: 1:2:a.txt 5:4:in.txt 2:5:5 2:6:6 3:7:2") == 0, "%s", s);
+  }
+
+  tstcase("Defaults from the environment") {
+    setenv("T_ITER_LEVEL", "7", 1);
+    char *s = iter("x");
+    tstcheck(strcmp(s, "1:0:out.txt 3:0:7 5:1:x") == 0, "%s", s);
+    setenv("T_ITER_LEVEL", "seven", 1);
+    s = iter("x");
+    tstcheck(strcmp(s, "1:0:out.txt 3:0:seven!Not a number 5:1:x") == 0, "%s", s);
+    unsetenv("T_ITER_LEVEL");
+  }
+
+  tstcase("Grouped short options") {
+    char *s = iter("-vvo", "f", "x");
+    tstcheck(strcmp(s, "1:0:out.txt 3:0:3 0:1: 0:1: 1:1:f 5:3:x") == 0, "%s", s);
+    s = iter("-von", "x");
+    tstcheck(strcmp(s, "1:0:out.txt 3:0:3 0:1: 1:1:n 5:2:x") == 0, "%s", s);
+  }
+
+  tstcase("Commands and positional arguments") {
+    char *s = iter("build", "x", "build", "y");
+    tstcheck(strcmp(s, "1:0:out.txt 3:0:3 4:1: 5:2:x 6:3:build -1:4:y") == 0, "%s", s);
+    s = iter("x", "build");
+    tstcheck(strcmp(s, "1:0:out.txt 3:0:3 5:1:x 6:2:build") == 0, "%s", s);
+  }
+
+  tstcase("After --") {
+    char *s = iter("--", "-v", "--num=3");
+    tstcheck(strcmp(s, "1:0:out.txt 3:0:3 5:2:-v 6:3:--num=3") == 0, "%s", s);
+  }
+
+  tstcase("Errors are events") {
+    char *s = iter("-o");
+    tstcheck(strcmp(s, "1:0:out.txt 3:0:3 1:1:!Missing or invalid value for 5:0:!Missing or invalid value for") == 0, "%s", s);
+    s = iter("-n", "x", "--num=abc", "--nope", "-q");
+    tstcheck(strcmp(s, "1:0:out.txt 3:0:3 2:1:x!Not a number 2:3:abc!Not a number -1:4:--nope -1:5:-q 5:0:!Missing or invalid value for") == 0, "%s", s);
+  }
+
+  tstcase("Stopping and resuming") {
+    char *argv[] = {"t_iter", "-v", "x", "-n", "4", NULL};
+    cli_iter_t it, saved;
+    cli_event_t *ev;
+    tstcheck(cliiter(&it, opts, 5, argv) == 7);
+    for (int k = 0; k < 3; k++) ev = clinext(&it);
+    tstcheck(ev->opt == 0 && clindx == 1);
+    saved = it;
+    ev = clinext(&it);
+    tstcheck(ev->opt == 5 && strcmp(ev->val, "x") == 0 && cliarg == ev->val);
+    it = saved;       // Back to where it was
+    ev = clinext(&it);
+    tstcheck(ev->opt == 5 && ev->ndx == 2);
+    ev = clinext(&it);
+    tstcheck(ev->opt == 2 && ev->ndx == 3 && strcmp(ev->val, "4") == 0);
+    tstcheck(clinext(&it) == NULL && clinext(&it) == NULL);
+  }
+
+  tstcase("What the error refers to") {
+    char *argv[] = {"t_iter", "--num=abc", NULL};
+    cli_iter_t it;
+    cli_event_t *ev;
+    char *msg = NULL, *arg = NULL;
+    cliiter(&it, opts, 2, argv);
+    while ((ev = clinext(&it)) != NULL) if (ev->err && !msg) { msg = ev->err; arg = ev->arg; }
+    tstcheck(msg && strcmp(msg, "Not a number") == 0 && strcmp(arg, "--num=abc") == 0);
+  }
+
+  tstcase("More names than slots") {
+    char *ev = many_events(100);
+    tstcheck(strcmp(ev, "0 100 -1 -1 -1") == 0, "%s", ev);
+    ev = many_events(MANY);
+    tstcheck(strcmp(ev, "0 300 299 150 -1") == 0, "%s", ev);
+    ev = many_events(CLI_ITER_SLOTS / 2);
+    tstcheck(strcmp(ev, "0 128 -1 -1 -1") == 0, "%s", ev);
+  }
+}
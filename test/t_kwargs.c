@@ -0,0 +1,59 @@
+#include "tst.h"
+#include "vrg.h"
+
+typedef struct {
+  const char *mode;
+  int flags;
+  int bufsize;
+  int retries;
+} open_opts;
+
+#define open_opts_defaults .mode = "r", .flags = 0, .bufsize = 4096, .retries = 3
+
+int open_file_kw(const char *path, open_opts opts);
+
+#define open_file(path, ...) open_file_kw(path, VRG_kwargs(open_opts, __VA_ARGS__))
+
+static open_opts last;
+
+#ifdef __GNUC__
+__attribute__((noinline))
+#endif
+int open_file_kw(const char *path, open_opts opts)
+{
+  last = opts;
+  return path != NULL;
+}
+
+// These two functions must compile to the same code (see `make asm_kwargs`)
+int call_by_name(void) { return open_file("x.txt", .flags = 3, .mode = "w"); }
+int call_by_hand(void) { return open_file_kw("x.txt", (open_opts){"w", 3, 4096, 3}); }
+
+tstsuite("Keyword arguments")
+{
+  tstcase("Defaults only") {
+    open_file("a.txt");
+    tstcheck(strcmp(last.mode, "r") == 0);
+    tstcheck(last.flags == 0 && last.bufsize == 4096 && last.retries == 3);
+  }
+
+  tstcase("Override some") {
+    open_file("a.txt", .bufsize = 16, .mode = "w");
+    tstcheck(strcmp(last.mode, "w") == 0);
+    tstcheck(last.flags == 0 && last.bufsize == 16 && last.retries == 3);
+  }
+
+  tstcase("Override all") {
+    open_file("a.txt", .retries = 0, .flags = 7, .bufsize = 1, .mode = "a");
+    tstcheck(strcmp(last.mode, "a") == 0);
+    tstcheck(last.flags == 7 && last.bufsize == 1 && last.retries == 0);
+  }
+
+  tstcase("Same as hand written") {
+    open_opts by_name, by_hand;
+    call_by_name(); by_name = last;
+    call_by_hand(); by_hand = last;
+    tstcheck(by_name.mode == by_hand.mode && by_name.flags == by_hand.flags);
+    tstcheck(by_name.bufsize == by_hand.bufsize && by_name.retries == by_hand.retries);
+  }
+}
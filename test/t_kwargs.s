@@ -0,0 +1,1702 @@
+	.file	"t_kwargs.c"
+	.text
+	.section	.rodata.str1.1,"aMS",@progbits,1
+.LC0:
+	.string	"%Y-%m-%d %H:%M:%S"
+	.text
+	.p2align 4
+	.type	tst_time, @function
+tst_time:
+.LFB12:
+	.cfi_startproc
+	pushq	%rbx
+	.cfi_def_cfa_offset 16
+	.cfi_offset 3, -16
+	subq	$16, %rsp
+	.cfi_def_cfa_offset 32
+	leaq	8(%rsp), %rbx
+	movq	%rbx, %rdi
+	call	time@PLT
+	movq	%rbx, %rdi
+	leaq	tstr.0(%rip), %rbx
+	call	localtime@PLT
+	movq	%rbx, %rdi
+	movl	$32, %esi
+	leaq	.LC0(%rip), %rdx
+	movq	%rax, %rcx
+	call	strftime@PLT
+	addq	$16, %rsp
+	.cfi_def_cfa_offset 16
+	movq	%rbx, %rax
+	popq	%rbx
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+.LFE12:
+	.size	tst_time, .-tst_time
+	.section	.rodata.str1.8,"aMS",@progbits,1
+	.align 8
+.LC1:
+	.string	"[--help] [--color] [--report-error] [--list]"
+	.section	.rodata.str1.1
+.LC2:
+	.string	"Test suite: \"%s\"\n%s %s"
+.LC3:
+	.string	" [+/-]tag ... ]\ntags:"
+.LC4:
+	.string	"%s \"%s\""
+.LC5:
+	.string	" %s"
+	.text
+	.p2align 4
+	.type	tst_parse_tags.constprop.0, @function
+tst_parse_tags.constprop.0:
+.LFB24:
+	.cfi_startproc
+	pushq	%r15
+	.cfi_def_cfa_offset 16
+	.cfi_offset 15, -16
+	movq	%rsi, %r15
+	pushq	%r14
+	.cfi_def_cfa_offset 24
+	.cfi_offset 14, -24
+	pushq	%r13
+	.cfi_def_cfa_offset 32
+	.cfi_offset 13, -32
+	pushq	%r12
+	.cfi_def_cfa_offset 40
+	.cfi_offset 12, -40
+	pushq	%rbp
+	.cfi_def_cfa_offset 48
+	.cfi_offset 6, -48
+	pushq	%rbx
+	.cfi_def_cfa_offset 56
+	.cfi_offset 3, -56
+	subq	$40, %rsp
+	.cfi_def_cfa_offset 96
+	movzwl	tst_report_err(%rip), %eax
+	movl	$1, 24(%rsp)
+	movw	%ax, 30(%rsp)
+	movq	tst_tag_names(%rip), %rax
+	cmpb	$0, (%rax)
+	je	.L67
+.L5:
+	movq	(%r15), %rax
+	movq	%rax, 8(%rsp)
+	testq	%rax, %rax
+	je	.L4
+	testl	%edi, %edi
+	jle	.L4
+	movslq	%edi, %rdi
+	movq	%r15, (%rsp)
+	movslq	24(%rsp), %r12
+	leaq	tst_tag_names(%rip), %rbp
+	leaq	(%r15,%rdi,8), %rax
+	movq	%rax, 16(%rsp)
+.L35:
+	movq	(%rsp), %rax
+	movq	(%rax), %r15
+	.p2align 4,,10
+	.p2align 3
+.L65:
+	movzbl	(%r15), %eax
+	testb	%al, %al
+	je	.L7
+	cmpb	$45, %al
+	je	.L8
+	movzbl	(%r15), %r14d
+	movl	$-1, %ebx
+.L9:
+	cmpb	$43, %r14b
+	jne	.L22
+	movzbl	1(%r15), %r14d
+	movl	$-1, %ebx
+	addq	$1, %r15
+.L22:
+	cmpb	$42, %r14b
+	je	.L68
+	testb	%r14b, %r14b
+	jne	.L69
+.L7:
+	addq	$8, (%rsp)
+	movq	(%rsp), %rax
+	cmpq	%rax, 16(%rsp)
+	jne	.L35
+.L4:
+	movzwl	30(%rsp), %eax
+	addq	$40, %rsp
+	.cfi_remember_state
+	.cfi_def_cfa_offset 56
+	popq	%rbx
+	.cfi_def_cfa_offset 48
+	popq	%rbp
+	.cfi_def_cfa_offset 40
+	popq	%r12
+	.cfi_def_cfa_offset 32
+	popq	%r13
+	.cfi_def_cfa_offset 24
+	popq	%r14
+	.cfi_def_cfa_offset 16
+	popq	%r15
+	.cfi_def_cfa_offset 8
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L8:
+	.cfi_restore_state
+	movzbl	1(%r15), %r14d
+	cmpb	$45, %r14b
+	je	.L70
+	addq	$1, %r15
+	xorl	%ebx, %ebx
+	jmp	.L9
+	.p2align 4,,10
+	.p2align 3
+.L69:
+	movl	24(%rsp), %eax
+	testl	%eax, %eax
+	je	.L24
+	xorl	%r13d, %r13d
+	.p2align 4,,10
+	.p2align 3
+.L28:
+	movq	0(%rbp,%r13,8), %rsi
+	movq	%r15, %rdi
+	call	strcmp@PLT
+	testl	%eax, %eax
+	jne	.L26
+	movl	$1, %eax
+	movl	%r13d, %ecx
+	sall	%cl, %eax
+	movl	%eax, %esi
+	orb	tst_tags_val(%rip), %al
+	notl	%esi
+	andb	tst_tags_val(%rip), %sil
+	testb	%bl, %bl
+	cmove	%esi, %eax
+	movb	%al, tst_tags_val(%rip)
+.L26:
+	addq	$1, %r13
+	cmpq	%r12, %r13
+	jne	.L28
+	.p2align 4,,10
+	.p2align 3
+.L24:
+	call	__ctype_b_loc@PLT
+	movq	(%rax), %rcx
+	jmp	.L29
+	.p2align 4,,10
+	.p2align 3
+.L31:
+	movzbl	1(%r15), %r14d
+	addq	$1, %r15
+	testb	%r14b, %r14b
+	je	.L7
+.L29:
+	movsbq	%r14b, %r8
+	testb	$32, 1(%rcx,%r8,2)
+	je	.L31
+	jmp	.L66
+	.p2align 4,,10
+	.p2align 3
+.L33:
+	addq	$1, %r15
+.L66:
+	movsbq	(%r15), %rax
+	testb	%al, %al
+	je	.L7
+	testb	$32, 1(%rcx,%rax,2)
+	jne	.L33
+	jmp	.L65
+	.p2align 4,,10
+	.p2align 3
+.L68:
+	movb	%bl, tst_tags_val(%rip)
+	jmp	.L24
+	.p2align 4,,10
+	.p2align 3
+.L70:
+	movzbl	2(%r15), %eax
+	cmpb	$108, %al
+	je	.L11
+	jg	.L12
+	cmpb	$99, %al
+	je	.L13
+	cmpb	$104, %al
+	jne	.L15
+	movq	8(%rsp), %rcx
+	movq	tst_title(%rip), %rdx
+	xorl	%eax, %eax
+	leaq	.LC1(%rip), %r8
+	movq	stderr(%rip), %rdi
+	leaq	.LC2(%rip), %rsi
+	call	fprintf@PLT
+	cmpl	$0, 24(%rsp)
+	jne	.L18
+.L20:
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	xorl	%edi, %edi
+	call	exit@PLT
+.L12:
+	cmpb	$114, %al
+	jne	.L15
+	movw	$1, 30(%rsp)
+	movzbl	(%r15), %r14d
+.L17:
+	testb	%r14b, %r14b
+	jne	.L24
+	jmp	.L7
+.L15:
+	movzbl	(%r15), %r14d
+	jmp	.L17
+.L11:
+	movq	tst_title(%rip), %rcx
+	movq	8(%rsp), %rdx
+	xorl	%eax, %eax
+	leaq	.LC4(%rip), %rsi
+	movq	stderr(%rip), %rdi
+	call	fprintf@PLT
+	cmpl	$0, 24(%rsp)
+	je	.L20
+.L19:
+	xorl	%ebx, %ebx
+	leaq	tst_tag_names(%rip), %r12
+	leaq	.LC5(%rip), %rbp
+	.p2align 4,,10
+	.p2align 3
+.L21:
+	movq	(%r12,%rbx,8), %rdx
+	movq	stderr(%rip), %rdi
+	movq	%rbp, %rsi
+	xorl	%eax, %eax
+	addq	$1, %rbx
+	call	fprintf@PLT
+	cmpl	%ebx, 24(%rsp)
+	jg	.L21
+	jmp	.L20
+.L13:
+	xorw	$1, tst_color(%rip)
+	movzbl	(%r15), %r14d
+	jmp	.L17
+.L67:
+	movzwl	tst_zero(%rip), %r14d
+	movzbl	%r14b, %eax
+	movl	%eax, 24(%rsp)
+	jmp	.L5
+.L18:
+	movq	stderr(%rip), %rcx
+	movl	$21, %edx
+	movl	$1, %esi
+	leaq	.LC3(%rip), %rdi
+	call	fwrite@PLT
+	jmp	.L19
+	.cfi_endproc
+.LFE24:
+	.size	tst_parse_tags.constprop.0, .-tst_parse_tags.constprop.0
+	.section	.rodata
+.LC6:
+	.string	""
+	.string	"\033[0m"
+.LC7:
+	.string	""
+	.string	"\033[1;31m"
+	.section	.rodata.str1.1
+.LC8:
+	.string	"%s%d FAIL%s | "
+	.section	.rodata
+.LC9:
+	.string	""
+	.string	"\033[0;32m"
+	.section	.rodata.str1.1
+.LC10:
+	.string	"%s%d PASS%s | "
+	.section	.rodata
+.LC11:
+	.string	""
+	.string	"\033[0;33m"
+	.section	.rodata.str1.1
+.LC12:
+	.string	"%s%d SKIP%s"
+	.text
+	.p2align 4
+	.type	tst_prt_results.isra.0, @function
+tst_prt_results.isra.0:
+.LFB25:
+	.cfi_startproc
+	pushq	%r12
+	.cfi_def_cfa_offset 16
+	.cfi_offset 12, -16
+	movswq	tst_color(%rip), %rax
+	movl	%edi, %ecx
+	movl	%esi, %r12d
+	pushq	%rbp
+	.cfi_def_cfa_offset 24
+	.cfi_offset 6, -24
+	movq	stderr(%rip), %rdi
+	leaq	.LC6(%rip), %rbp
+	leaq	.LC8(%rip), %rsi
+	pushq	%rbx
+	.cfi_def_cfa_offset 32
+	.cfi_offset 3, -32
+	movl	%edx, %ebx
+	leaq	.LC7(%rip), %rdx
+	leaq	0(%rbp,%rax), %r8
+	addq	%rax, %rdx
+	xorl	%eax, %eax
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rax
+	movq	stderr(%rip), %rdi
+	leaq	.LC9(%rip), %rdx
+	movl	%r12d, %ecx
+	leaq	.LC10(%rip), %rsi
+	leaq	0(%rbp,%rax), %r8
+	addq	%rax, %rdx
+	xorl	%eax, %eax
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rax
+	leaq	.LC11(%rip), %rdx
+	movl	%ebx, %ecx
+	movq	stderr(%rip), %rdi
+	popq	%rbx
+	.cfi_def_cfa_offset 24
+	leaq	.LC12(%rip), %rsi
+	leaq	0(%rbp,%rax), %r8
+	addq	%rax, %rdx
+	popq	%rbp
+	.cfi_def_cfa_offset 16
+	xorl	%eax, %eax
+	popq	%r12
+	.cfi_def_cfa_offset 8
+	jmp	fprintf@PLT
+	.cfi_endproc
+.LFE25:
+	.size	tst_prt_results.isra.0, .-tst_prt_results.isra.0
+	.p2align 4
+	.globl	open_file_kw
+	.type	open_file_kw, @function
+open_file_kw:
+.LFB16:
+	.cfi_startproc
+	movq	24(%rsp), %rax
+	movdqu	8(%rsp), %xmm0
+	movq	%rax, 16+last(%rip)
+	xorl	%eax, %eax
+	testq	%rdi, %rdi
+	movaps	%xmm0, last(%rip)
+	setne	%al
+	ret
+	.cfi_endproc
+.LFE16:
+	.size	open_file_kw, .-open_file_kw
+	.section	.rodata.str1.1
+.LC13:
+	.string	"w"
+.LC15:
+	.string	"x.txt"
+	.text
+	.p2align 4
+	.globl	call_by_name
+	.type	call_by_name, @function
+call_by_name:
+.LFB17:
+	.cfi_startproc
+	subq	$72, %rsp
+	.cfi_def_cfa_offset 80
+	leaq	.LC13(%rip), %rax
+	leaq	.LC15(%rip), %rdi
+	movq	%rax, 32(%rsp)
+	movq	.LC14(%rip), %rax
+	movl	$3, 48(%rsp)
+	movq	%rax, 40(%rsp)
+	movq	48(%rsp), %rax
+	movdqa	32(%rsp), %xmm0
+	movq	%rax, 16(%rsp)
+	movups	%xmm0, (%rsp)
+	call	open_file_kw
+	addq	$72, %rsp
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+.LFE17:
+	.size	call_by_name, .-call_by_name
+	.p2align 4
+	.globl	call_by_hand
+	.type	call_by_hand, @function
+call_by_hand:
+.LFB18:
+	.cfi_startproc
+	subq	$72, %rsp
+	.cfi_def_cfa_offset 80
+	leaq	.LC13(%rip), %rax
+	leaq	.LC15(%rip), %rdi
+	movq	%rax, 32(%rsp)
+	movq	.LC14(%rip), %rax
+	movl	$3, 48(%rsp)
+	movq	%rax, 40(%rsp)
+	movq	48(%rsp), %rax
+	movdqa	32(%rsp), %xmm0
+	movq	%rax, 16(%rsp)
+	movups	%xmm0, (%rsp)
+	call	open_file_kw
+	addq	$72, %rsp
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+.LFE18:
+	.size	call_by_hand, .-call_by_hand
+	.section	.rodata.str1.1
+.LC16:
+	.string	"%5d %s"
+.LC17:
+	.string	" Defaults only"
+.LC18:
+	.string	" Override some"
+.LC19:
+	.string	"r"
+.LC21:
+	.string	"a.txt"
+.LC22:
+	.string	"strcmp(last.mode, \"r\") == 0"
+.LC23:
+	.string	"%s%s"
+.LC24:
+	.string	" \""
+.LC25:
+	.string	" %s\n"
+	.section	.rodata.str1.8
+	.align 8
+.LC26:
+	.string	"last.flags == 0 && last.bufsize == 4096 && last.retries == 3"
+	.section	.rodata.str1.1
+.LC27:
+	.string	" Override all"
+.LC29:
+	.string	"strcmp(last.mode, \"w\") == 0"
+	.section	.rodata.str1.8
+	.align 8
+.LC30:
+	.string	"last.flags == 0 && last.bufsize == 16 && last.retries == 3"
+	.section	.rodata.str1.1
+.LC31:
+	.string	" Same as hand written"
+.LC32:
+	.string	"a"
+.LC34:
+	.string	"strcmp(last.mode, \"a\") == 0"
+	.section	.rodata.str1.8
+	.align 8
+.LC35:
+	.string	"last.flags == 7 && last.bufsize == 1 && last.retries == 0"
+	.align 8
+.LC36:
+	.string	"by_name.mode == by_hand.mode && by_name.flags == by_hand.flags"
+	.align 8
+.LC37:
+	.string	"by_name.bufsize == by_hand.bufsize && by_name.retries == by_hand.retries"
+	.text
+	.p2align 4
+	.globl	tst__run
+	.type	tst__run, @function
+tst__run:
+.LFB22:
+	.cfi_startproc
+	pushq	%rbp
+	.cfi_def_cfa_offset 16
+	.cfi_offset 6, -16
+	movl	$34, %edx
+	xorl	%eax, %eax
+	movq	%rsp, %rbp
+	.cfi_def_cfa_register 6
+	pushq	%r15
+	pushq	%r14
+	pushq	%r13
+	pushq	%r12
+	pushq	%rbx
+	.cfi_offset 15, -24
+	.cfi_offset 14, -32
+	.cfi_offset 13, -40
+	.cfi_offset 12, -48
+	.cfi_offset 3, -56
+	leaq	.LC16(%rip), %rbx
+	movq	%rbx, %rsi
+	subq	$88, %rsp
+	movq	tst_str_case(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	call	fprintf@PLT
+	movl	$14, %edx
+	movq	stderr(%rip), %rcx
+	movl	$1, %esi
+	leaq	.LC17(%rip), %rdi
+	call	fwrite@PLT
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	movzwl	tst_zero(%rip), %edx
+	andl	%eax, %edx
+	movw	%dx, tst_zero(%rip)
+	testw	%dx, %dx
+	jne	.L89
+	movl	%edx, %r12d
+	leaq	.LC21(%rip), %rax
+	xorl	%edx, %edx
+	movq	%rax, -112(%rbp)
+	leaq	last(%rip), %r15
+	leaq	.LC6(%rip), %r14
+	movw	%dx, -98(%rbp)
+	leaq	.LC23(%rip), %r13
+	jmp	.L79
+	.p2align 4,,10
+	.p2align 3
+.L161:
+	movq	%rbx, %rsi
+	movl	$36, %edx
+	xorl	%eax, %eax
+	addw	$1, -98(%rbp)
+	movq	tst_str_fail(%rip), %rcx
+	addl	$1, tst_fail(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	leaq	.LC7(%rip), %rax
+	movq	stderr(%rip), %rsi
+	addq	%rax, %rdi
+	call	fputs@PLT
+.L84:
+	movswq	tst_color(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	xorl	%eax, %eax
+	movq	%r13, %rsi
+	leaq	.LC22(%rip), %rdx
+	addq	%r14, %rcx
+	call	fprintf@PLT
+	cmpw	$0, tst_result(%rip)
+	jne	.L85
+	movq	stderr(%rip), %rcx
+	movl	$2, %edx
+	movl	$1, %esi
+	leaq	.LC24(%rip), %rdi
+	call	fwrite@PLT
+	movq	stderr(%rip), %rsi
+	movl	$34, %edi
+	call	fputc@PLT
+	movzwl	tst_zero(%rip), %eax
+	testw	%ax, %ax
+	jne	.L159
+.L85:
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	movabsq	$17592186044416, %rax
+	cmpq	%rax, 8+last(%rip)
+	je	.L160
+.L86:
+	xorl	%eax, %eax
+	movq	%rbx, %rsi
+	movl	$37, %edx
+	addw	$1, -98(%rbp)
+	movq	stderr(%rip), %rdi
+	movq	tst_str_fail(%rip), %rcx
+	movw	%ax, tst_result(%rip)
+	xorl	%eax, %eax
+	addl	$1, tst_fail(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	leaq	.LC7(%rip), %rax
+	movq	stderr(%rip), %rsi
+	addq	%rax, %rdi
+	call	fputs@PLT
+.L87:
+	movswq	tst_color(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	xorl	%eax, %eax
+	movq	%r13, %rsi
+	leaq	.LC26(%rip), %rdx
+	addq	%r14, %rcx
+	call	fprintf@PLT
+	cmpw	$0, tst_result(%rip)
+	jne	.L88
+	movq	stderr(%rip), %rcx
+	movl	$2, %edx
+	movl	$1, %esi
+	leaq	.LC24(%rip), %rdi
+	call	fwrite@PLT
+	movq	stderr(%rip), %rsi
+	movl	$34, %edi
+	call	fputc@PLT
+	movzwl	tst_zero(%rip), %eax
+	testw	%ax, %ax
+	jne	.L159
+.L88:
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	movl	$34, %edx
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	movq	tst_str_case_end(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	call	fprintf@PLT
+	movswl	-98(%rbp), %edi
+	xorl	%edx, %edx
+	movswl	%r12w, %esi
+	call	tst_prt_results.isra.0
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	andw	%ax, tst_zero(%rip)
+	je	.L89
+.L79:
+	leaq	.LC19(%rip), %rax
+	subq	$32, %rsp
+	movl	$3, -64(%rbp)
+	movq	%rax, -80(%rbp)
+	movq	.LC20(%rip), %rax
+	movq	%rax, -72(%rbp)
+	movdqa	-80(%rbp), %xmm0
+	movups	%xmm0, (%rsp)
+	movq	-64(%rbp), %rax
+	movq	%rax, 16(%rsp)
+	movq	-112(%rbp), %rdi
+	call	open_file_kw
+	movq	(%r15), %rdx
+	movzbl	(%rdx), %eax
+	subl	$114, %eax
+	jne	.L82
+	movzbl	1(%rdx), %eax
+.L82:
+	addq	$32, %rsp
+	testl	%eax, %eax
+	movq	stderr(%rip), %rdi
+	sete	%al
+	movzbl	%al, %eax
+	movw	%ax, tst_result(%rip)
+	jne	.L161
+	movq	tst_str_pass(%rip), %rcx
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	addl	$1, %r12d
+	movl	$36, %edx
+	addl	$1, tst_pass(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	movq	stderr(%rip), %rsi
+	leaq	.LC9(%rip), %rax
+	addq	%rax, %rdi
+	call	fputs@PLT
+	jmp	.L84
+	.p2align 4,,10
+	.p2align 3
+.L160:
+	cmpl	$3, 16+last(%rip)
+	jne	.L86
+	movq	tst_str_pass(%rip), %rcx
+	movl	$1, %eax
+	movq	%rbx, %rsi
+	movl	$37, %edx
+	movq	stderr(%rip), %rdi
+	movw	%ax, tst_result(%rip)
+	xorl	%eax, %eax
+	addl	$1, %r12d
+	addl	$1, tst_pass(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	movq	stderr(%rip), %rsi
+	leaq	.LC9(%rip), %rax
+	addq	%rax, %rdi
+	call	fputs@PLT
+	jmp	.L87
+	.p2align 4,,10
+	.p2align 3
+.L159:
+	movq	stderr(%rip), %rsi
+	movq	tst_str_file_abr(%rip), %rdi
+	leaq	-88(%rbp), %rbx
+	call	fputs@PLT
+	movl	tst_pass(%rip), %esi
+	movl	tst_fail(%rip), %edi
+	xorl	%edx, %edx
+	call	tst_prt_results.isra.0
+.L157:
+	movq	%rbx, %rdi
+	call	time@PLT
+	movq	%rbx, %rdi
+	leaq	tstr.0(%rip), %rbx
+	call	localtime@PLT
+	leaq	.LC0(%rip), %rdx
+	movl	$32, %esi
+	movq	%rbx, %rdi
+	movq	%rax, %rcx
+	call	strftime@PLT
+	movq	stderr(%rip), %rdi
+	movq	%rbx, %rdx
+	xorl	%eax, %eax
+	leaq	.LC25(%rip), %rsi
+	call	fprintf@PLT
+	xorl	%edi, %edi
+	call	exit@PLT
+	.p2align 4,,10
+	.p2align 3
+.L89:
+	movq	tst_str_case(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	movl	$40, %edx
+	call	fprintf@PLT
+	movl	$14, %edx
+	movq	stderr(%rip), %rcx
+	movl	$1, %esi
+	leaq	.LC18(%rip), %rdi
+	call	fwrite@PLT
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	movzwl	tst_zero(%rip), %edx
+	andl	%eax, %edx
+	movw	%dx, tst_zero(%rip)
+	movl	%edx, %r12d
+	testw	%dx, %dx
+	jne	.L80
+	leaq	.LC21(%rip), %rax
+	xorl	%edx, %edx
+	leaq	last(%rip), %r15
+	movq	%rax, -112(%rbp)
+	leaq	.LC13(%rip), %rax
+	leaq	.LC6(%rip), %r14
+	movq	%rax, -120(%rbp)
+	leaq	.LC23(%rip), %r13
+	movw	%dx, -98(%rbp)
+	jmp	.L81
+	.p2align 4,,10
+	.p2align 3
+.L163:
+	movq	%rbx, %rsi
+	movl	$42, %edx
+	xorl	%eax, %eax
+	addw	$1, -98(%rbp)
+	movq	tst_str_fail(%rip), %rcx
+	addl	$1, tst_fail(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	leaq	.LC7(%rip), %rax
+	movq	stderr(%rip), %rsi
+	addq	%rax, %rdi
+	call	fputs@PLT
+.L94:
+	movswq	tst_color(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	xorl	%eax, %eax
+	movq	%r13, %rsi
+	leaq	.LC29(%rip), %rdx
+	addq	%r14, %rcx
+	call	fprintf@PLT
+	cmpw	$0, tst_result(%rip)
+	jne	.L95
+	movq	stderr(%rip), %rcx
+	movl	$2, %edx
+	movl	$1, %esi
+	leaq	.LC24(%rip), %rdi
+	call	fwrite@PLT
+	movq	stderr(%rip), %rsi
+	movl	$34, %edi
+	call	fputc@PLT
+	movzwl	tst_zero(%rip), %eax
+	testw	%ax, %ax
+	jne	.L159
+.L95:
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	movabsq	$68719476736, %rax
+	cmpq	%rax, 8+last(%rip)
+	je	.L162
+.L96:
+	movq	stderr(%rip), %rdi
+	xorl	%r11d, %r11d
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	movq	tst_str_fail(%rip), %rcx
+	movl	$43, %edx
+	addl	$1, tst_fail(%rip)
+	addw	$1, -98(%rbp)
+	movw	%r11w, tst_result(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	leaq	.LC7(%rip), %rax
+	movq	stderr(%rip), %rsi
+	addq	%rax, %rdi
+	call	fputs@PLT
+.L98:
+	movswq	tst_color(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	xorl	%eax, %eax
+	movq	%r13, %rsi
+	leaq	.LC30(%rip), %rdx
+	addq	%r14, %rcx
+	call	fprintf@PLT
+	cmpw	$0, tst_result(%rip)
+	jne	.L99
+	movq	stderr(%rip), %rcx
+	movl	$2, %edx
+	movl	$1, %esi
+	leaq	.LC24(%rip), %rdi
+	call	fwrite@PLT
+	movq	stderr(%rip), %rsi
+	movl	$34, %edi
+	call	fputc@PLT
+	movzwl	tst_zero(%rip), %eax
+	testw	%ax, %ax
+	jne	.L159
+.L99:
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	movl	$40, %edx
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	movq	tst_str_case_end(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	call	fprintf@PLT
+	movswl	-98(%rbp), %edi
+	xorl	%edx, %edx
+	movswl	%r12w, %esi
+	call	tst_prt_results.isra.0
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	andw	%ax, tst_zero(%rip)
+	je	.L80
+.L81:
+	movq	-120(%rbp), %rax
+	subq	$32, %rsp
+	movl	$3, -64(%rbp)
+	movq	%rax, -80(%rbp)
+	movq	.LC28(%rip), %rax
+	movq	%rax, -72(%rbp)
+	movdqa	-80(%rbp), %xmm1
+	movups	%xmm1, (%rsp)
+	movq	-64(%rbp), %rax
+	movq	%rax, 16(%rsp)
+	movq	-112(%rbp), %rdi
+	call	open_file_kw
+	movq	(%r15), %rdx
+	movzbl	(%rdx), %eax
+	subl	$119, %eax
+	jne	.L92
+	movzbl	1(%rdx), %eax
+.L92:
+	addq	$32, %rsp
+	testl	%eax, %eax
+	movq	stderr(%rip), %rdi
+	sete	%al
+	movzbl	%al, %eax
+	movw	%ax, tst_result(%rip)
+	jne	.L163
+	movq	tst_str_pass(%rip), %rcx
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	addl	$1, %r12d
+	movl	$42, %edx
+	addl	$1, tst_pass(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	movq	stderr(%rip), %rsi
+	leaq	.LC9(%rip), %rax
+	addq	%rax, %rdi
+	call	fputs@PLT
+	jmp	.L94
+	.p2align 4,,10
+	.p2align 3
+.L80:
+	movq	tst_str_case(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	movl	$46, %edx
+	call	fprintf@PLT
+	movl	$13, %edx
+	movq	stderr(%rip), %rcx
+	movl	$1, %esi
+	leaq	.LC27(%rip), %rdi
+	call	fwrite@PLT
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	movzwl	tst_zero(%rip), %edx
+	andl	%eax, %edx
+	movw	%dx, tst_zero(%rip)
+	movl	%edx, %r12d
+	testw	%dx, %dx
+	jne	.L90
+	xorl	%edx, %edx
+	leaq	.LC21(%rip), %rax
+	leaq	last(%rip), %r15
+	movq	%rax, -112(%rbp)
+	leaq	.LC6(%rip), %r14
+	leaq	.LC23(%rip), %r13
+	movw	%dx, -98(%rbp)
+	jmp	.L91
+	.p2align 4,,10
+	.p2align 3
+.L165:
+	movq	%rbx, %rsi
+	movl	$48, %edx
+	xorl	%eax, %eax
+	addw	$1, -98(%rbp)
+	movq	tst_str_fail(%rip), %rcx
+	addl	$1, tst_fail(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	leaq	.LC7(%rip), %rax
+	movq	stderr(%rip), %rsi
+	addq	%rax, %rdi
+	call	fputs@PLT
+.L104:
+	movswq	tst_color(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	xorl	%eax, %eax
+	movq	%r13, %rsi
+	leaq	.LC34(%rip), %rdx
+	addq	%r14, %rcx
+	call	fprintf@PLT
+	cmpw	$0, tst_result(%rip)
+	jne	.L105
+	movq	stderr(%rip), %rcx
+	movl	$2, %edx
+	movl	$1, %esi
+	leaq	.LC24(%rip), %rdi
+	call	fwrite@PLT
+	movq	stderr(%rip), %rsi
+	movl	$34, %edi
+	call	fputc@PLT
+	movzwl	tst_zero(%rip), %eax
+	testw	%ax, %ax
+	jne	.L159
+.L105:
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	movabsq	$4294967303, %rax
+	cmpq	%rax, 8+last(%rip)
+	je	.L164
+.L106:
+	movq	stderr(%rip), %rdi
+	xorl	%r8d, %r8d
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	movq	tst_str_fail(%rip), %rcx
+	movl	$49, %edx
+	addl	$1, tst_fail(%rip)
+	addw	$1, -98(%rbp)
+	movw	%r8w, tst_result(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	leaq	.LC7(%rip), %rax
+	movq	stderr(%rip), %rsi
+	addq	%rax, %rdi
+	call	fputs@PLT
+.L108:
+	movswq	tst_color(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	xorl	%eax, %eax
+	movq	%r13, %rsi
+	leaq	.LC35(%rip), %rdx
+	addq	%r14, %rcx
+	call	fprintf@PLT
+	cmpw	$0, tst_result(%rip)
+	jne	.L109
+	movq	stderr(%rip), %rcx
+	movl	$2, %edx
+	movl	$1, %esi
+	leaq	.LC24(%rip), %rdi
+	call	fwrite@PLT
+	movq	stderr(%rip), %rsi
+	movl	$34, %edi
+	call	fputc@PLT
+	movzwl	tst_zero(%rip), %eax
+	testw	%ax, %ax
+	jne	.L159
+.L109:
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	movl	$46, %edx
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	movq	tst_str_case_end(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	call	fprintf@PLT
+	movswl	-98(%rbp), %edi
+	xorl	%edx, %edx
+	movswl	%r12w, %esi
+	call	tst_prt_results.isra.0
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	andw	%ax, tst_zero(%rip)
+	je	.L90
+.L91:
+	leaq	.LC32(%rip), %rax
+	subq	$32, %rsp
+	movl	$0, -64(%rbp)
+	movq	%rax, -80(%rbp)
+	movq	.LC33(%rip), %rax
+	movq	%rax, -72(%rbp)
+	movdqa	-80(%rbp), %xmm2
+	movups	%xmm2, (%rsp)
+	movq	-64(%rbp), %rax
+	movq	%rax, 16(%rsp)
+	movq	-112(%rbp), %rdi
+	call	open_file_kw
+	movq	(%r15), %rdx
+	movzbl	(%rdx), %eax
+	subl	$97, %eax
+	jne	.L102
+	movzbl	1(%rdx), %eax
+.L102:
+	addq	$32, %rsp
+	testl	%eax, %eax
+	movq	stderr(%rip), %rdi
+	sete	%al
+	movzbl	%al, %eax
+	movw	%ax, tst_result(%rip)
+	jne	.L165
+	movq	tst_str_pass(%rip), %rcx
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	addl	$1, %r12d
+	movl	$48, %edx
+	addl	$1, tst_pass(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	movq	stderr(%rip), %rsi
+	leaq	.LC9(%rip), %rax
+	addq	%rax, %rdi
+	call	fputs@PLT
+	jmp	.L104
+	.p2align 4,,10
+	.p2align 3
+.L162:
+	cmpl	$3, 16+last(%rip)
+	jne	.L96
+	movq	tst_str_pass(%rip), %rcx
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	addl	$1, %r12d
+	movq	stderr(%rip), %rdi
+	movl	$1, %r10d
+	movl	$43, %edx
+	addl	$1, tst_pass(%rip)
+	movw	%r10w, tst_result(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	movq	stderr(%rip), %rsi
+	leaq	.LC9(%rip), %rax
+	addq	%rax, %rdi
+	call	fputs@PLT
+	jmp	.L98
+	.p2align 4,,10
+	.p2align 3
+.L164:
+	movl	16+last(%rip), %r9d
+	testl	%r9d, %r9d
+	jne	.L106
+	movl	$1, %edi
+	movq	%rbx, %rsi
+	movl	$49, %edx
+	xorl	%eax, %eax
+	movw	%di, tst_result(%rip)
+	movq	tst_str_pass(%rip), %rcx
+	addl	$1, %r12d
+	movq	stderr(%rip), %rdi
+	addl	$1, tst_pass(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	movq	stderr(%rip), %rsi
+	leaq	.LC9(%rip), %rax
+	addq	%rax, %rdi
+	call	fputs@PLT
+	jmp	.L108
+	.p2align 4,,10
+	.p2align 3
+.L90:
+	movq	tst_str_case(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	movl	$52, %edx
+	call	fprintf@PLT
+	movl	$21, %edx
+	movq	stderr(%rip), %rcx
+	movl	$1, %esi
+	leaq	.LC31(%rip), %rdi
+	call	fwrite@PLT
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	movzwl	tst_zero(%rip), %edx
+	andl	%eax, %edx
+	movw	%dx, tst_zero(%rip)
+	movl	%edx, %eax
+	testw	%dx, %dx
+	jne	.L78
+	leaq	.LC6(%rip), %r14
+	xorl	%r12d, %r12d
+	movw	%ax, -98(%rbp)
+	leaq	.LC23(%rip), %r13
+	leaq	.LC13(%rip), %rdx
+	movq	%r13, -112(%rbp)
+	leaq	last(%rip), %r15
+	movq	%r14, %r13
+	movq	%rdx, -120(%rbp)
+	movl	%r12d, %r14d
+	jmp	.L101
+	.p2align 4,,10
+	.p2align 3
+.L120:
+	movq	stderr(%rip), %rdi
+	xorl	%edx, %edx
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	movq	tst_str_fail(%rip), %rcx
+	movw	%dx, tst_result(%rip)
+	movl	$57, %edx
+	addl	$1, tst_fail(%rip)
+	addw	$1, -98(%rbp)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	leaq	.LC7(%rip), %rax
+	movq	stderr(%rip), %rsi
+	addq	%rax, %rdi
+	call	fputs@PLT
+.L116:
+	movswq	tst_color(%rip), %rcx
+	movq	-112(%rbp), %rsi
+	xorl	%eax, %eax
+	leaq	.LC37(%rip), %rdx
+	movq	stderr(%rip), %rdi
+	addq	%r13, %rcx
+	call	fprintf@PLT
+	cmpw	$0, tst_result(%rip)
+	jne	.L117
+	movq	stderr(%rip), %rcx
+	movl	$2, %edx
+	movl	$1, %esi
+	leaq	.LC24(%rip), %rdi
+	call	fwrite@PLT
+	movq	stderr(%rip), %rsi
+	movl	$34, %edi
+	call	fputc@PLT
+	movzwl	tst_zero(%rip), %eax
+	testw	%ax, %ax
+	jne	.L158
+.L117:
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	movl	$52, %edx
+	movq	%rbx, %rsi
+	xorl	%eax, %eax
+	movq	tst_str_case_end(%rip), %rcx
+	movq	stderr(%rip), %rdi
+	call	fprintf@PLT
+	movswl	-98(%rbp), %edi
+	xorl	%edx, %edx
+	movswl	%r14w, %esi
+	call	tst_prt_results.isra.0
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	andw	%ax, tst_zero(%rip)
+	je	.L78
+.L101:
+	movq	-120(%rbp), %rsi
+	movq	.LC14(%rip), %rax
+	subq	$32, %rsp
+	movl	$3, -64(%rbp)
+	leaq	.LC15(%rip), %rdi
+	movq	%rax, -72(%rbp)
+	movq	%rsi, -80(%rbp)
+	movdqa	-80(%rbp), %xmm3
+	movups	%xmm3, (%rsp)
+	movq	-64(%rbp), %rax
+	movq	%rax, 16(%rsp)
+	call	open_file_kw
+	movl	12+last(%rip), %eax
+	movq	(%r15), %rdx
+	movq	%rsi, -80(%rbp)
+	movl	$3, -64(%rbp)
+	movl	8+last(%rip), %ecx
+	movl	%eax, -124(%rbp)
+	movl	16+last(%rip), %eax
+	movl	%eax, -104(%rbp)
+	movq	.LC14(%rip), %rax
+	movq	%rax, -72(%rbp)
+	movdqa	-80(%rbp), %xmm4
+	movups	%xmm4, (%rsp)
+	movq	-64(%rbp), %rax
+	movq	%rax, 16(%rsp)
+	call	open_file_kw
+	movl	12+last(%rip), %eax
+	movl	16+last(%rip), %r12d
+	addq	$32, %rsp
+	movq	stderr(%rip), %rdi
+	movl	%eax, -128(%rbp)
+	cmpq	%rdx, (%r15)
+	jne	.L119
+	cmpl	%ecx, 8+last(%rip)
+	je	.L110
+.L119:
+	xorl	%esi, %esi
+	movq	tst_str_fail(%rip), %rcx
+	movl	$56, %edx
+	xorl	%eax, %eax
+	movw	%si, tst_result(%rip)
+	movq	%rbx, %rsi
+	addl	$1, tst_fail(%rip)
+	addw	$1, -98(%rbp)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	leaq	.LC7(%rip), %rax
+	movq	stderr(%rip), %rsi
+	addq	%rax, %rdi
+	call	fputs@PLT
+.L112:
+	movswq	tst_color(%rip), %rcx
+	movq	-112(%rbp), %rsi
+	xorl	%eax, %eax
+	leaq	.LC36(%rip), %rdx
+	movq	stderr(%rip), %rdi
+	addq	%r13, %rcx
+	call	fprintf@PLT
+	cmpw	$0, tst_result(%rip)
+	jne	.L113
+	movq	stderr(%rip), %rcx
+	movl	$2, %edx
+	movl	$1, %esi
+	leaq	.LC24(%rip), %rdi
+	call	fwrite@PLT
+	movq	stderr(%rip), %rsi
+	movl	$34, %edi
+	call	fputc@PLT
+	movzwl	tst_zero(%rip), %eax
+	testw	%ax, %ax
+	jne	.L158
+.L113:
+	movq	stderr(%rip), %rsi
+	movl	$10, %edi
+	call	fputc@PLT
+	cmpl	%r12d, -104(%rbp)
+	jne	.L120
+	movl	-128(%rbp), %edx
+	cmpl	%edx, -124(%rbp)
+	jne	.L120
+	movq	tst_str_pass(%rip), %rcx
+	movl	$1, %eax
+	movq	%rbx, %rsi
+	movl	$57, %edx
+	movq	stderr(%rip), %rdi
+	movw	%ax, tst_result(%rip)
+	xorl	%eax, %eax
+	addl	$1, %r14d
+	addl	$1, tst_pass(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	movq	stderr(%rip), %rsi
+	leaq	.LC9(%rip), %rax
+	addq	%rax, %rdi
+	call	fputs@PLT
+	jmp	.L116
+	.p2align 4,,10
+	.p2align 3
+.L78:
+	leaq	-40(%rbp), %rsp
+	popq	%rbx
+	popq	%r12
+	popq	%r13
+	popq	%r14
+	popq	%r15
+	popq	%rbp
+	.cfi_remember_state
+	.cfi_def_cfa 7, 8
+	ret
+	.p2align 4,,10
+	.p2align 3
+.L110:
+	.cfi_restore_state
+	movl	$1, %ecx
+	movq	%rbx, %rsi
+	movl	$56, %edx
+	xorl	%eax, %eax
+	movw	%cx, tst_result(%rip)
+	movq	tst_str_pass(%rip), %rcx
+	addl	$1, %r14d
+	addl	$1, tst_pass(%rip)
+	call	fprintf@PLT
+	movswq	tst_color(%rip), %rdi
+	movq	stderr(%rip), %rsi
+	leaq	.LC9(%rip), %rax
+	addq	%rax, %rdi
+	call	fputs@PLT
+	jmp	.L112
+.L158:
+	movq	stderr(%rip), %rsi
+	movq	tst_str_file_abr(%rip), %rdi
+	leaq	-80(%rbp), %rbx
+	call	fputs@PLT
+	movl	tst_pass(%rip), %esi
+	movl	tst_fail(%rip), %edi
+	xorl	%edx, %edx
+	call	tst_prt_results.isra.0
+	jmp	.L157
+	.cfi_endproc
+.LFE22:
+	.size	tst__run, .-tst__run
+	.section	.rodata.str1.1
+.LC38:
+	.string	""
+.LC39:
+	.string	" (disabled)"
+.LC40:
+	.string	"TSTOPTIONS"
+.LC41:
+	.string	"Keyword arguments"
+.LC42:
+	.string	"t_kwargs.c"
+	.section	.rodata
+.LC43:
+	.string	""
+	.string	"\033[1;36m"
+	.section	.rodata.str1.1
+.LC44:
+	.string	"----- %s%s %s \"%s\" %s%s%s\n"
+	.section	.text.startup,"ax",@progbits
+	.p2align 4
+	.globl	main
+	.type	main, @function
+main:
+.LFB21:
+	.cfi_startproc
+	pushq	%rbp
+	.cfi_def_cfa_offset 16
+	.cfi_offset 6, -16
+	movq	%rsi, %rbp
+	pushq	%rbx
+	.cfi_def_cfa_offset 24
+	.cfi_offset 3, -24
+	movl	%edi, %ebx
+	leaq	.LC40(%rip), %rdi
+	subq	$24, %rsp
+	.cfi_def_cfa_offset 48
+	call	getenv@PLT
+	leaq	8(%rsp), %rsi
+	movl	$1, %edi
+	movq	%rax, 8(%rsp)
+	leaq	.LC41(%rip), %rax
+	movq	%rax, tst_title(%rip)
+	call	tst_parse_tags.constprop.0
+	movq	%rbp, %rsi
+	movl	%ebx, %edi
+	movw	%ax, tst_report_err(%rip)
+	call	tst_parse_tags.constprop.0
+	movw	%ax, tst_report_err(%rip)
+	movzwl	tst_zero(%rip), %eax
+	testw	%ax, %ax
+	js	.L167
+	movzwl	tst_zero(%rip), %eax
+.L167:
+	movzwl	tst_zero(%rip), %eax
+	movswq	tst_color(%rip), %rbx
+	leaq	.LC39(%rip), %rbp
+	testw	%ax, %ax
+	leaq	.LC38(%rip), %rax
+	cmove	%rax, %rbp
+	call	tst_time
+	leaq	.LC6(%rip), %rcx
+	subq	$8, %rsp
+	.cfi_def_cfa_offset 56
+	movq	tst_title(%rip), %r9
+	leaq	.LC43(%rip), %rdx
+	pushq	%rbp
+	.cfi_def_cfa_offset 64
+	movq	stderr(%rip), %rdi
+	leaq	.LC42(%rip), %r8
+	addq	%rbx, %rdx
+	addq	%rcx, %rbx
+	movq	tst_str_file(%rip), %rcx
+	leaq	.LC44(%rip), %rsi
+	pushq	%rbx
+	.cfi_def_cfa_offset 72
+	pushq	%rax
+	.cfi_def_cfa_offset 80
+	xorl	%eax, %eax
+	call	fprintf@PLT
+	movzwl	tst_zero(%rip), %eax
+	addq	$32, %rsp
+	.cfi_def_cfa_offset 48
+	testw	%ax, %ax
+	je	.L172
+.L169:
+	movq	stderr(%rip), %rsi
+	movq	tst_str_file_end(%rip), %rdi
+	movzwl	tstdata(%rip), %eax
+	movzwl	tst_zero(%rip), %eax
+	xorl	%eax, %eax
+	movw	%ax, tst_zero(%rip)
+	call	fputs@PLT
+	movl	tst_pass(%rip), %esi
+	movl	tst_fail(%rip), %edi
+	xorl	%edx, %edx
+	call	tst_prt_results.isra.0
+	call	tst_time
+	movq	stderr(%rip), %rdi
+	leaq	.LC25(%rip), %rsi
+	movq	%rax, %rdx
+	xorl	%eax, %eax
+	call	fprintf@PLT
+	movl	tst_fail(%rip), %ecx
+	movswl	tst_report_err(%rip), %eax
+	xorl	%edx, %edx
+	testl	%ecx, %ecx
+	cmovle	%edx, %eax
+	addq	$24, %rsp
+	.cfi_remember_state
+	.cfi_def_cfa_offset 24
+	popq	%rbx
+	.cfi_def_cfa_offset 16
+	popq	%rbp
+	.cfi_def_cfa_offset 8
+	ret
+.L172:
+	.cfi_restore_state
+	call	tst__run
+	jmp	.L169
+	.cfi_endproc
+.LFE21:
+	.size	main, .-main
+	.local	tstr.0
+	.comm	tstr.0,32,32
+	.section	.rodata.str1.1
+.LC45:
+	.string	"_2"
+.LC46:
+	.string	"_3"
+.LC47:
+	.string	"_4"
+.LC48:
+	.string	"_5"
+.LC49:
+	.string	"_6"
+.LC50:
+	.string	"_7"
+.LC51:
+	.string	"_8"
+	.section	.data.rel.local,"aw"
+	.align 32
+	.type	tst_tag_names, @object
+	.size	tst_tag_names, 64
+tst_tag_names:
+	.quad	.LC38
+	.quad	.LC45
+	.quad	.LC46
+	.quad	.LC47
+	.quad	.LC48
+	.quad	.LC49
+	.quad	.LC50
+	.quad	.LC51
+	.local	last
+	.comm	last,24,16
+	.local	tstdata
+	.comm	tstdata,2,2
+	.local	tst_tags_val
+	.comm	tst_tags_val,1,1
+	.globl	tst_str_scrn_end
+	.section	.rodata.str1.1
+.LC52:
+	.string	">>>>>\n"
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_scrn_end, @object
+	.size	tst_str_scrn_end, 8
+tst_str_scrn_end:
+	.quad	.LC52
+	.globl	tst_str_scrn
+	.section	.rodata.str1.1
+.LC53:
+	.string	"<<<<< "
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_scrn, @object
+	.size	tst_str_scrn, 8
+tst_str_scrn:
+	.quad	.LC53
+	.globl	tst_str_sctn_end
+	.section	.rodata.str1.1
+.LC54:
+	.string	"    |`---"
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_sctn_end, @object
+	.size	tst_str_sctn_end, 8
+tst_str_sctn_end:
+	.quad	.LC54
+	.globl	tst_str_sctn
+	.section	.rodata.str1.1
+.LC55:
+	.string	"SCTN|,--"
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_sctn, @object
+	.size	tst_str_sctn, 8
+tst_str_sctn:
+	.quad	.LC55
+	.globl	tst_str_note
+	.section	.rodata.str1.1
+.LC56:
+	.string	"NOTE:"
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_note, @object
+	.size	tst_str_note, 8
+tst_str_note:
+	.quad	.LC56
+	.globl	tst_str_clck
+	.section	.rodata.str1.1
+.LC57:
+	.string	"CLCK:  %ld %ss "
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_clck, @object
+	.size	tst_str_clck, 8
+tst_str_clck:
+	.quad	.LC57
+	.globl	tst_str_file_abr
+	.section	.rodata.str1.1
+.LC58:
+	.string	"^^^^^ ABRT \\ "
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_file_abr, @object
+	.size	tst_str_file_abr, 8
+tst_str_file_abr:
+	.quad	.LC58
+	.globl	tst_str_file_end
+	.section	.rodata.str1.1
+.LC59:
+	.string	"^^^^^ RSLT \\ "
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_file_end, @object
+	.size	tst_str_file_end, 8
+tst_str_file_end:
+	.quad	.LC59
+	.globl	tst_str_file
+	.section	.rodata.str1.1
+.LC60:
+	.string	"SUIT /"
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_file, @object
+	.size	tst_str_file, 8
+tst_str_file:
+	.quad	.LC60
+	.globl	tst_str_case_end
+	.section	.rodata.str1.1
+.LC61:
+	.string	"    `--- "
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_case_end, @object
+	.size	tst_str_case_end, 8
+tst_str_case_end:
+	.quad	.LC61
+	.globl	tst_str_case
+	.section	.rodata.str1.1
+.LC62:
+	.string	"CASE,--"
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_case, @object
+	.size	tst_str_case, 8
+tst_str_case:
+	.quad	.LC62
+	.globl	tst_str_skip_end
+	.align 8
+	.type	tst_str_skip_end, @object
+	.size	tst_str_skip_end, 8
+tst_str_skip_end:
+	.quad	.LC54
+	.globl	tst_str_skip_tst
+	.section	.rodata.str1.1
+.LC63:
+	.string	"SKPT|,-(%s)"
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_skip_tst, @object
+	.size	tst_str_skip_tst, 8
+tst_str_skip_tst:
+	.quad	.LC63
+	.globl	tst_str_pass
+	.section	.rodata.str1.1
+.LC64:
+	.string	"PASS|  "
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_pass, @object
+	.size	tst_str_pass, 8
+tst_str_pass:
+	.quad	.LC64
+	.globl	tst_str_fail
+	.section	.rodata.str1.1
+.LC65:
+	.string	"FAIL|  "
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_fail, @object
+	.size	tst_str_fail, 8
+tst_str_fail:
+	.quad	.LC65
+	.globl	tst_str_skip
+	.section	.rodata.str1.1
+.LC66:
+	.string	"SKIP|  "
+	.section	.data.rel.local
+	.align 8
+	.type	tst_str_skip, @object
+	.size	tst_str_skip, 8
+tst_str_skip:
+	.quad	.LC66
+	.local	tst_title
+	.comm	tst_title,8,8
+	.local	tst_fail
+	.comm	tst_fail,4,4
+	.local	tst_pass
+	.comm	tst_pass,4,4
+	.local	tst_report_err
+	.comm	tst_report_err,2,2
+	.local	tst_color
+	.comm	tst_color,2,2
+	.local	tst_result
+	.comm	tst_result,2,2
+	.local	tst_zero
+	.comm	tst_zero,2,2
+	.section	.rodata.cst8,"aM",@progbits,8
+	.align 8
+.LC14:
+	.long	3
+	.long	4096
+	.align 8
+.LC20:
+	.long	0
+	.long	4096
+	.align 8
+.LC28:
+	.long	0
+	.long	16
+	.align 8
+.LC33:
+	.long	7
+	.long	1
+	.ident	"GCC: (Debian 12.2.0-14+deb12u1) 12.2.0"
+	.section	.note.GNU-stack,"",@progbits
@@ -0,0 +1,18 @@
+	.cfi_startproc
+	subq	$72, %rsp
+	.cfi_def_cfa_offset 80
+	leaq	.LC13(%rip), %rax
+	leaq	.LC15(%rip), %rdi
+	movq	%rax, 32(%rsp)
+	movq	.LC14(%rip), %rax
+	movl	$3, 48(%rsp)
+	movq	%rax, 40(%rsp)
+	movq	48(%rsp), %rax
+	movdqa	32(%rsp), %xmm0
+	movq	%rax, 16(%rsp)
+	movups	%xmm0, (%rsp)
+	call	open_file_kw
+	addq	$72, %rsp
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
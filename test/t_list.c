@@ -0,0 +1,111 @@
+#include "cli.h"
+#include "tst.h"
+
+static long long ids[16];
+static double    wgt[16];
+static int n_ids, n_wgt;
+
+static int parse(int argc, char **argv)
+{
+  n_ids = n_wgt = 0;
+  clioptions("list test") {
+    cliopt("-i ids") {
+      n_ids = cliints(cliarg, ids, 16);
+    }
+    cliopt("-w weights") {
+      n_wgt = clifloats(cliarg, wgt, 16);
+    }
+    cliopt();
+  }
+  return 0;
+}
+
+#define ints(s)   parse(3, (char *[]){"t_list", "-i", s, NULL})
+#define floats(s) parse(3, (char *[]){"t_list", "-w", s, NULL})
+
+tstsuite("Lists of numbers")
+{
+  tstcase("Integers") {
+    ints("1,2,3");
+    tstcheck(n_ids == 3 && ids[0] == 1 && ids[1] == 2 && ids[2] == 3);
+    ints(" 10  -20 , +30\t40\n");
+    tstcheck(n_ids == 4 && ids[0] == 10 && ids[1] == -20 && ids[2] == 30 && ids[3] == 40);
+    ints("123456789012,00000000000000000007,-98765432");
+    tstcheck(n_ids == 3 && ids[0] == 123456789012LL && ids[1] == 7 && ids[2] == -98765432);
+    tstcheck(cliints("", ids, 16) == 0);
+    tstcheck(cliints(" \t", ids, 16) == 0);
+  }
+
+  tstcase("Integer limits") {
+    tstcheck(cliints("-9223372036854775808 9223372036854775807", ids, 16) == 2);
+    tstcheck(ids[0] == LLONG_MIN && ids[1] == LLONG_MAX);
+    ints("9223372036854775808");
+    tstcheck(n_ids == -1 && strcmp(clierrormsg, CLI_STR_ERR_RANGE) == 0, "%s", clierrormsg);
+    ints("1,-92233720368547758080");
+    tstcheck(n_ids == -1 && strcmp(clierrormsg, CLI_STR_ERR_RANGE) == 0, "%s", clierrormsg);
+  }
+
+  tstcase("Format errors") {
+    char *bad[] = {"1,,2", "1,", ",1", "1x", "1 - 2", "12345678x", "-", "1.5"};
+    for (int k = 0; k < (int)(sizeof(bad)/sizeof(bad[0])); k++) {
+      ints(bad[k]);
+      tstcheck(n_ids == -1 && strcmp(clierrormsg, CLI_STR_ERR_NUMBER) == 0, "'%s'", bad[k]);
+    }
+  }
+
+  tstcase("Too many") {
+    tstcheck(cliints("1,2,3", ids, 2) == -1 && strcmp(clierrormsg, CLI_STR_ERR_TOOMANY) == 0);
+    tstcheck(cliints("1 2 3 4 5", NULL, 0) == 5);
+  }
+
+  tstcase("Same as strtoll") {
+    char buf[64];
+    long long v[3];
+    int errors = 0;
+    for (long long x = 1; x > 0 && x < LLONG_MAX / 7; x = x * 7 + 3) {
+      snprintf(buf, sizeof(buf), "%lld,%lld,%lld", x, -x, x / 3);
+      errors += (cliints(buf, v, 3) != 3 || v[0] != x || v[1] != -x || v[2] != x / 3);
+    }
+    tstcheck(errors == 0, "%d", errors);
+  }
+
+  tstcase("Floats") {
+    floats("0.5, 0.25 .125,-2,3.,1e3,-1.5E-2");
+    tstcheck(n_wgt == 7);
+    tstcheck(wgt[0] == 0.5 && wgt[1] == 0.25 && wgt[2] == 0.125 && wgt[3] == -2.0);
+    tstcheck(wgt[4] == 3.0 && wgt[5] == 1000.0 && wgt[6] == -0.015);
+    floats("3.14159265358979323846,123456.789012");
+    tstcheck(n_wgt == 2 && wgt[0] == strtod("3.14159265358979323846", NULL) && wgt[1] == 123456.789012);
+    floats("1e999");
+    tstcheck(n_wgt == -1 && strcmp(clierrormsg, CLI_STR_ERR_RANGE) == 0);
+    floats("1.2.3");
+    tstcheck(n_wgt == -1 && strcmp(clierrormsg, CLI_STR_ERR_NUMBER) == 0);
+    floats(".");
+    tstcheck(n_wgt == -1 && strcmp(clierrormsg, CLI_STR_ERR_NUMBER) == 0);
+  }
+
+  tstcase("Only decimal numbers") {
+    floats("1e3");
+    tstcheck(n_wgt == 1 && wgt[0] == 1000.0);
+    tstcheck(clifloats("-.5e1,+2E0", wgt, 16) == 2 && wgt[0] == -5.0 && wgt[1] == 2.0);
+    char *bad[] = {"inf", "-inf", "infinity", "nan", "+NAN", "0x10", "-0X1p3", "1,0x10", ".e1"};
+    for (int k = 0; k < (int)(sizeof(bad)/sizeof(bad[0])); k++) {
+      tstcheck(clifloats(bad[k], wgt, 16) == -1 && strcmp(clierrormsg, CLI_STR_ERR_NUMBER) == 0, "'%s'", bad[k]);
+    }
+  }
+
+  tstcase("Same as strtod") {
+    char num[32], buf[72];
+    double v[2];
+    int errors = 0;
+    for (unsigned long long x = 1; x < 1000000000000000ULL; x = x * 13 + 7) {
+      for (int d = 0; d < 16; d++) {
+        int n = snprintf(num, sizeof(num), "%llu", x);
+        if (d < n) memmove(num + n - d + 1, num + n - d, d + 1), num[n - d] = '.';
+        snprintf(buf, sizeof(buf), "%s,-%s", num, num);
+        errors += (clifloats(buf, v, 2) != 2 || v[0] != strtod(buf, NULL) || v[1] != -v[0]);
+      }
+    }
+    tstcheck(errors == 0, "%d", errors);
+  }
+}
@@ -0,0 +1,46 @@
+#include "tst.h"
+#include "vrg.h"
+
+#define sq(x)        ((x)*(x))
+#define idx(i,x)     ((i)*(x))
+#define scale(k,x)   ((k)*(x))
+#define same(x)      x
+#define count(x)     +1
+#define add_to(x)    total += (x)
+
+#define sum(...)     (0 VRG_map(count, (), __VA_ARGS__))
+
+tstsuite("Map over arguments")
+{
+  tstcase("Separators") {
+    tstcheck(VRG_map(sq, (+), 1, 2, 3) == 14);
+    tstcheck(VRG_map(sq, (*), 1, 2, 3) == 36);
+    tstcheck((VRG_map(same, (&&), 1, 1, 0)) == 0);
+  }
+
+  tstcase("Comma separator") {
+    int a[] = { VRG_map(sq, (,), 1, 2, 3, 4) };
+    tstcheck(sizeof(a)/sizeof(a[0]) == 4);
+    tstcheck(a[0] == 1 && a[1] == 4 && a[2] == 9 && a[3] == 16);
+  }
+
+  tstcase("Index and context") {
+    tstcheck(VRG_mapi(idx, (+), 5, 5, 5) == 15);
+    tstcheck(VRG_mapx(scale, 10, (+), 1, 2, 3) == 60);
+  }
+
+  tstcase("Number of arguments") {
+    tstcheck(sum() == 0);
+    tstcheck(sum(7) == 1);
+    tstcheck(sum((int)7) == 1);
+    tstcheck(sum((int)7, 8) == 2);
+    tstcheck(sum(1,2,3,4,5,6,7,8,9) == 9);
+    tstcheck(VRG_mapi(idx, (+), 1,1,1,1,1,1,1,1,1) == 36);
+  }
+
+  tstcase("Statements") {
+    int total = 0;
+    VRG_foreach(add_to, 1, 2, 3, 4);
+    tstcheck(total == 10);
+  }
+}
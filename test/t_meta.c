@@ -0,0 +1,70 @@
+#include "cli.h"
+#include "tst.h"
+
+static int n_long, n_short, n_cmd, n_ops, n_level;
+static char *value;
+
+static int parse(int argc, char **argv)
+{
+  n_long = n_short = n_cmd = n_ops = n_level = 0;
+  value = NULL;
+  clioptions("meta test", argc, argv) {
+    cliopt("-v, --a-rather-long-option-name\tA long name") { n_long++; }
+    cliopt("-q\tQuiet") { n_short++; }
+    cliopt("--level-of-detail [n]\tAn argument") { n_level++; value = cliarg; }
+    cliopt("<list>\tA command") { n_cmd++; }
+    cliopt() { n_ops++; }
+  }
+  return clindx;
+}
+
+#define args(...) (sizeof((char *[]){"t_meta", __VA_ARGS__}) / sizeof(char *)), \
+                  (char *[]){"t_meta", __VA_ARGS__, NULL}
+
+tstsuite("Classification of the arguments")
+{
+  tstcase("Hash and length of the names") {
+    cli_meta_t m;
+    cli_classify("--a-rather-long-option-name", &m);
+    tstcheck(m.kind == CLI_TOK_LONG && m.len == 27 && m.eq == 0);
+    tstcheck(m.hash == cli_hash("--a-rather-long-option-name=1", 27));
+    cli_classify("--level-of-detail=3", &m);
+    tstcheck(m.kind == CLI_TOK_LONG && m.len == 17 && m.eq == 1);
+    cli_classify("-qv", &m);
+    tstcheck(m.kind == CLI_TOK_SHORT && m.len == 3 && m.eq == 0);
+    cli_classify("-", &m);
+    tstcheck(m.kind == CLI_TOK_OPERAND);
+    cli_classify("--", &m);
+    tstcheck(m.kind == CLI_TOK_DASHDASH);
+    cli_classify("a=b=c", &m);
+    tstcheck(m.kind == CLI_TOK_OPERAND && m.len == 1 && m.eq == 1);
+  }
+
+  tstcase("Long names and values") {
+    parse(args("--a-rather-long-option-name", "-qv", "x"));
+    tstcheck(n_long == 2 && n_short == 1 && n_ops == 1);
+    parse(args("--level-of-detail=3", "--a-rather-long-option-nam", "--a-rather-long-option-namex"));
+    tstcheck(n_level == 1 && value && strcmp(value, "3") == 0 && n_long == 0 && n_ops == 2);
+    parse(args("--level-of-detail", "4"));
+    tstcheck(n_level == 1 && value && strcmp(value, "4") == 0);
+    parse(args("--level-of-detail", "-q"));
+    tstcheck(n_level == 1 && value && *value == '\0' && n_short == 1);
+  }
+
+  tstcase("Commands and operands") {
+    parse(args("list", "x"));
+    tstcheck(n_cmd == 1 && n_ops == 1);
+    parse(args("listing", "list"));
+    tstcheck(n_cmd == 1 && n_ops == 1);
+    parse(args("-", "--", "-q", "list"));
+    tstcheck(n_cmd == 0 && n_short == 0 && n_ops == 3);
+  }
+
+  tstcase("More arguments than CLI_META_MAX") {
+    static char *argv[3 * CLI_META_MAX + 1];
+    argv[0] = "t_meta";
+    for (int k = 1; k <= 3 * CLI_META_MAX; k++) argv[k] = (k % 3) ? "-q" : "op";
+    parse(3 * CLI_META_MAX + 1, argv);
+    tstcheck(n_short == 2 * CLI_META_MAX && n_ops == CLI_META_MAX);
+  }
+}
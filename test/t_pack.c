@@ -0,0 +1,57 @@
+#include "tst.h"
+#include "vrg.h"
+
+static int types[10];
+static char buf[256];
+
+static int collect(int argc, const vrg_val_t *argv)
+{
+  int n = 0;
+  buf[0] = '\0';
+  for (int k = 0; k < argc; k++) {
+    types[k] = argv[k].type;
+    switch (argv[k].type) {
+      case VRG_T_BOOL:   case VRG_T_CHAR:  case VRG_T_SCHAR:
+      case VRG_T_SHORT:  case VRG_T_INT:   case VRG_T_LONG:
+      case VRG_T_LLONG:  n += snprintf(buf+n, sizeof(buf)-n, "[%lld]", argv[k].v.i);  break;
+      case VRG_T_UCHAR:  case VRG_T_USHORT: case VRG_T_UINT:
+      case VRG_T_ULONG:  case VRG_T_ULLONG:
+                         n += snprintf(buf+n, sizeof(buf)-n, "[%llu]", argv[k].v.u);  break;
+      case VRG_T_FLOAT:  case VRG_T_DOUBLE:
+                         n += snprintf(buf+n, sizeof(buf)-n, "[%g]", argv[k].v.d);    break;
+      case VRG_T_STR:    n += snprintf(buf+n, sizeof(buf)-n, "[%s]", argv[k].v.s);    break;
+      case VRG_T_PTR:    n += snprintf(buf+n, sizeof(buf)-n, "[ptr]");                break;
+      default:           n += snprintf(buf+n, sizeof(buf)-n, "[?]");                  break;
+    }
+  }
+  return argc;
+}
+
+#define collect(...) collect(VRG_pack(__VA_ARGS__))
+
+tstsuite("Argument packs")
+{
+  tstcase("Count") {
+    tstcheck(collect() == 0);
+    tstcheck(collect(1) == 1);
+    tstcheck(collect((short)1) == 1);
+    tstcheck(collect(1,2,3,4,5,6,7,8,9) == 9);
+  }
+
+  tstcase("Types") {
+    char c = 'x'; unsigned char uc = 200; short s = -3; unsigned short us = 3;
+    unsigned u = 4; long l = -5; unsigned long ul = 5; long long ll = -6;
+    unsigned long long ull = 6; _Bool b = 1; float f = 0.5f; int *p = &types[0];
+
+    collect(c, uc, s, us, u, l, ul, ll, ull);
+    tstcheck(types[0] == VRG_T_CHAR && types[1] == VRG_T_UCHAR && types[2] == VRG_T_SHORT);
+    tstcheck(types[3] == VRG_T_USHORT && types[4] == VRG_T_UINT && types[5] == VRG_T_LONG);
+    tstcheck(types[6] == VRG_T_ULONG && types[7] == VRG_T_LLONG && types[8] == VRG_T_ULLONG);
+    tstcheck(strcmp(buf, "[120][200][-3][3][4][-5][5][-6][6]") == 0, "%s", buf);
+
+    collect(b, f, 2.5, "str", p, 'a', 42);
+    tstcheck(types[0] == VRG_T_BOOL && types[1] == VRG_T_FLOAT && types[2] == VRG_T_DOUBLE);
+    tstcheck(types[3] == VRG_T_STR && types[4] == VRG_T_PTR && types[5] == VRG_T_INT);
+    tstcheck(strcmp(buf, "[1][0.5][2.5][str][ptr][97][42]") == 0, "%s", buf);
+  }
+}
@@ -0,0 +1,151 @@
+#define _POSIX_C_SOURCE 200809L
+#define PRT_FD      9
+#define PRT_BUFSIZE 64
+#include <math.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <pthread.h>
+
+#include "tst.h"
+#include "prt.h"
+
+// Everything written to `PRT_FD` ends up in this file
+static char *fd_file = "t_prt_out.txt";
+
+// Each thread starts with its own buffer
+static void *thread_prt(void *arg)
+{
+  prtln("thread ", (int)(intptr_t)arg);
+  prtflush();
+  return NULL;
+}
+
+static char *read_back(void)
+{
+  static char text[1024];
+  FILE *f = fopen(fd_file, "rb");
+  size_t n = 0;
+  if (f != NULL) {
+    n = fread(text, 1, sizeof(text) - 1, f);
+    fclose(f);
+  }
+  text[n] = '\0';
+  return text;
+}
+
+tstsuite("Typed print")
+{
+  char buf[128], small[8];
+  prt_out_t o;
+  size_t n;
+  int fd;
+
+  tstcase("Integers") {
+    o = prtbuf(buf, sizeof(buf));
+    n = prtto(&o, 0, " ", 7, " ", -42, " ", 1234567890, " ", -1234567890123LL);
+    tstcheck(strcmp(buf, "0 7 -42 1234567890 -1234567890123") == 0, "%s", buf);
+    tstcheck(n == strlen(buf));
+    o = prtbuf(buf, sizeof(buf));
+    prtto(&o, LLONG_MIN, " ", ULLONG_MAX, " ", (unsigned char)200, " ");
+    prtto(&o, (short)-3, " ", 99u, " ", 100ul);
+    tstcheck(strcmp(buf, "-9223372036854775808 18446744073709551615 200 -3 99 100") == 0, "%s", buf);
+  }
+
+  tstcase("Characters and booleans") {
+    o = prtbuf(buf, sizeof(buf));
+    prtto(&o, (char)'a', 'a', (_Bool)1, " ", (_Bool)0, " ", (signed char)'a');
+    tstcheck(strcmp(buf, "a97true false 97") == 0, "%s", buf);
+  }
+
+  tstcase("Floating point") {
+    static const struct { double d; char *s; } num[] = {
+      {1.5, "1.5"}, {0.1, "0.1"}, {-0.001, "-0.001"}, {100, "100"}, {0, "0"},
+      {123456.789, "123456.789"}, {1e20, "1e+20"}, {0.1 + 0.2, "0.30000000000000004"},
+      {NAN, "nan"}, {INFINITY, "inf"}, {-INFINITY, "-inf"}, {-0.0, "-0"}
+    };
+    for (int k = 0; k < (int)(sizeof(num) / sizeof(num[0])); k++) {
+      o = prtbuf(buf, sizeof(buf));
+      prtto(&o, num[k].d);
+      tstcheck(strcmp(buf, num[k].s) == 0, "%s != %s", buf, num[k].s);
+    }
+    o = prtbuf(buf, sizeof(buf));
+    prtto(&o, 0.1f, " ", 1.0f / 3, " ", 2.5f);
+    tstcheck(strcmp(buf, "0.1 0.333333343 2.5") == 0, "%s", buf);
+    o = prtbuf(buf, sizeof(buf));
+    prtto(&o, -0.0f, " ", 0.0f, " ", -0.0 * 0.5);
+    tstcheck(strcmp(buf, "-0 0 -0") == 0, "%s", buf);
+  }
+
+  tstcase("Strings and pointers") {
+    char *null = NULL, name[] = "name";
+    const char *c = "const";
+    o = prtbuf(buf, sizeof(buf));
+    prtto(&o, name, " ", c, " ", null, " ", (void *)0x7ffc10, " ", (int *)NULL);
+    tstcheck(strcmp(buf, "name const (null) 0x7ffc10 0x0") == 0, "%s", buf);
+  }
+
+  tstcase("Appending to a buffer") {
+    o = prtbuf(buf, sizeof(buf));
+    prtto(&o, "a=", 1);
+    n = prtto(&o, ", b=", 2);
+    tstcheck(n == 8 && strcmp(buf, "a=1, b=2") == 0, "%s", buf);
+  }
+
+  tstcase("The buffer is too small") {
+    memset(small, 'x', sizeof(small));
+    o = prtbuf(small, sizeof(small));
+    n = prtto(&o, "value = ", 12345);
+    tstcheck(n == 13 && strcmp(small, "value =") == 0, "%s", small);
+    n = prtto(&o, "!");
+    tstcheck(n == 14 && strcmp(small, "value =") == 0, "%s", small);
+    o = prtbuf(small, 0);
+    tstcheck(prtto(&o, "abc") == 3);
+  }
+
+  fd = open(fd_file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  tstassert(fd >= 0 && dup2(fd, 9) == 9);
+  close(fd);
+
+  tstcase("Printing") {
+    prt("x = ", 3, ", y = ", 0.5);
+    prtln(" and", " z");
+    tstcheck(read_back()[0] == '\0');      // Still in the buffer
+    prtflush();
+    tstcheck(strcmp(read_back(), "x = 3, y = 0.5 and z\n") == 0, "%s", read_back());
+  }
+
+  tstcase("The buffer of the thread is full") {
+    for (int k = 0; k < 40; k++) prt(k, ",");
+    tstcheck(strlen(read_back()) > 21);    // Written when full
+    prtflush();
+    tstcheck(strstr(read_back(), "0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,") != NULL, "%s", read_back());
+    prt("A string longer than the buffer: ........................................................");
+    tstcheck(strstr(read_back(), ": .....") != NULL);
+    prtflush();
+  }
+
+  tstcase("The buffers of the threads") {
+    pthread_t th[4];
+    size_t before = strlen(read_back());
+    for (int k = 0; k < 4; k++) pthread_create(&th[k], NULL, thread_prt, (void *)(intptr_t)k);
+    for (int k = 0; k < 4; k++) pthread_join(th[k], NULL);
+    tstcheck(strlen(read_back()) == before + 4 * 9, "%s", read_back() + before);
+    tstcheck(strstr(read_back() + before, "thread 0\n") && strstr(read_back() + before, "thread 3\n"));
+  }
+
+  tstcase("Writing to a file descriptor") {
+    char fbuf[16];
+    prt_out_t f = prtfd(9, fbuf, sizeof(fbuf));
+    size_t before = strlen(read_back());
+    prtto(&f, "[", 1, "]");
+    tstcheck(strlen(read_back()) == before);
+    prtto(&f, "0123456789abcd");
+    tstcheck(strlen(read_back()) == before + 3);
+    prtflush(&f);
+    tstcheck(strlen(read_back()) == before + 17);
+    tstcheck(strcmp(read_back() + before, "[1]0123456789abcd") == 0, "%s", read_back());
+  }
+
+  close(9);
+  remove(fd_file);
+}
@@ -0,0 +1,115 @@
+#include <math.h>
+
+#include "tst.h"
+#include "rec.h"
+
+recdefine(point_t, (int32_t, x), (int32_t, y));
+
+recdefine(sample_t, (uint32_t, id), (int8_t, delta), (double, value), (float, ratio),
+                    (bool, valid), (rec_str_t, unit), (point_t, pos), (uint64_t, ts));
+
+recdefine(empty_t, (rec_str_t, s));
+
+recdefine(num_t, (double, d));
+
+tstsuite("Records")
+{
+  sample_t s = {.id = 7, .delta = -3, .value = 1.5, .ratio = 0.25f, .valid = true,
+                .unit = "ms", .pos = {-1, 2}, .ts = 1234567890123ULL};
+  unsigned char buf[256];
+  char txt[256];
+  size_t n;
+
+  tstcase("The structure") {
+    tstcheck(sizeof(s.id) == 4 && sizeof(s.pos.x) == 4 && sizeof(s.ts) == 8);
+    tstcheck(recsize(point_t, &s.pos) == 8);
+    tstcheck(recsize(sample_t, &s) == 4 + 1 + 8 + 4 + 1 + (4 + 3) + 8 + 8);
+  }
+
+  tstcase("Binary encoding") {
+    static const unsigned char point[] = {0xFF, 0xFF, 0xFF, 0xFF, 2, 0, 0, 0};
+    n = recencode(point_t, &s.pos, buf, sizeof(buf));
+    tstcheck(n == 8 && memcmp(buf, point, 8) == 0);
+    n = recencode(sample_t, &s, buf, sizeof(buf));
+    tstcheck(n == recsize(sample_t, &s));
+    tstcheck(buf[0] == 7 && buf[1] == 0 && buf[2] == 0 && buf[3] == 0 && buf[4] == 0xFD);
+    tstcheck(memcmp(buf + 18, "\x02\0\0\0ms", 7) == 0);
+  }
+
+  tstcase("The buffer is too small") {
+    memset(buf, 0xAA, sizeof(buf));
+    n = recencode(sample_t, &s, buf, 20);
+    tstcheck(n == recsize(sample_t, &s));
+    tstcheck(buf[0] == 0xAA);
+  }
+
+  tstcase("Decoding") {
+    sample_t d;
+    int ok = 1;
+    n = recencode(sample_t, &s, buf, sizeof(buf));
+    tstcheck(recdecode(sample_t, &d, buf, n) == n);
+    tstcheck(d.id == 7 && d.delta == -3 && d.value == 1.5 && d.ratio == 0.25f && d.valid);
+    tstcheck(d.pos.x == -1 && d.pos.y == 2 && d.ts == 1234567890123ULL);
+    tstcheck(strcmp(d.unit, "ms") == 0 && d.unit == (char *)buf + 22);
+    for (size_t k = 0; k < n; k++) ok &= recdecode(sample_t, &d, buf, k) == 0;
+    tstcheck(ok);
+    buf[24] = 'x';     // No `\0` at the end of the string
+    tstcheck(recdecode(sample_t, &d, buf, n) == 0);
+  }
+
+  tstcase("NULL strings") {
+    empty_t e = {NULL}, d = {"x"};
+    n = recencode(empty_t, &e, buf, sizeof(buf));
+    tstcheck(n == 4 && memcmp(buf, "\xFF\xFF\xFF\xFF", 4) == 0);
+    tstcheck(recdecode(empty_t, &d, buf, n) == 4 && d.s == NULL);
+    e.s = "";
+    n = recencode(empty_t, &e, buf, sizeof(buf));
+    tstcheck(recdecode(empty_t, &d, buf, n) == 5 && d.s != NULL && d.s[0] == '\0');
+  }
+
+  tstcase("JSON") {
+    char *expected = "{\"id\":7,\"delta\":-3,\"value\":1.5,\"ratio\":0.25,\"valid\":true,"
+                     "\"unit\":\"ms\",\"pos\":{\"x\":-1,\"y\":2},\"ts\":1234567890123}";
+    n = recjson(sample_t, &s, txt, sizeof(txt));
+    tstcheck(strcmp(txt, expected) == 0, "%s", txt);
+    tstcheck(n == strlen(expected));
+    s.value = 0.1; s.ratio = 1.0f / 3; s.valid = false; s.unit = NULL;
+    recjson(sample_t, &s, txt, sizeof(txt));
+    tstcheck(strstr(txt, "\"value\":0.1,\"ratio\":0.333333343,\"valid\":false,\"unit\":null") != NULL, "%s", txt);
+    s.ratio = 0.1f;
+    recjson(sample_t, &s, txt, sizeof(txt));
+    tstcheck(strstr(txt, "\"ratio\":0.1,") != NULL, "%s", txt);
+    s.value = NAN; s.ratio = INFINITY;
+    recjson(sample_t, &s, txt, sizeof(txt));
+    tstcheck(strstr(txt, "\"value\":null,\"ratio\":null") != NULL, "%s", txt);
+  }
+
+  tstcase("Numbers") {
+    static const struct { double d; char *s; } num[] = {
+      {123456.789, "123456.789"}, {-0.001, "-0.001"}, {100, "100"}, {0, "0"}, {-0.0, "-0"},
+      {1e20, "1e+20"}, {1.5e-7, "1.4999999999999999e-07"}, {0.1 + 0.2, "0.30000000000000004"},
+      {-45.000001, "-45.000001"}, {0.00001, "0.00001"}
+    };
+    num_t x;
+    for (int k = 0; k < (int)(sizeof(num) / sizeof(num[0])); k++) {
+      x.d = num[k].d;
+      recjson(num_t, &x, txt, sizeof(txt));
+      tstcheck(strncmp(txt + 5, num[k].s, strlen(num[k].s)) == 0 && txt[5 + strlen(num[k].s)] == '}', "%s", txt);
+    }
+  }
+
+  tstcase("Escaped strings") {
+    empty_t e = {"a\"b\\c\n\x01"};
+    recjson(empty_t, &e, txt, sizeof(txt));
+    tstcheck(strcmp(txt, "{\"s\":\"a\\\"b\\\\c\\u000a\\u0001\"}") == 0, "%s", txt);
+  }
+
+  tstcase("Truncated JSON") {
+    point_t p = {10, 20};
+    n = recjson(point_t, &p, txt, 8);
+    tstcheck(n == 15 && strcmp(txt, "{\"x\":10") == 0, "%s", txt);
+    tstcheck(recjson(point_t, &p, txt, 0) == 15);
+    tstcheck(recjson(point_t, &p, txt, 15) == 15 && strcmp(txt, "{\"x\":10,\"y\":20") == 0);
+    tstcheck(recjson(point_t, &p, txt, 16) == 15 && strcmp(txt, "{\"x\":10,\"y\":20}") == 0);
+  }
+}
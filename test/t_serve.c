@@ -0,0 +1,184 @@
+#define _POSIX_C_SOURCE 200809L
+#define CLI_SERVE
+#include "cli.h"
+#include "tst.h"
+
+#include <fcntl.h>
+#include <time.h>
+
+static int loaded = 0;    // Set only in the server
+static int calls = 0;     // Changes in a request must not be seen by the next one
+
+static int run(int argc, char **argv)
+{
+  int level = 0;
+  char *file = "";
+  char cwd[256];
+
+  calls++;
+  clioptions("serve test", argc, argv) {
+    cliopt("-l, --level n ($LEVEL,1)\tA level") {
+      level = atoi(cliarg);
+    }
+    cliopt("-q\tQuit with 7") {
+      exit(7);
+    }
+    cliopt("-k\tKill the server") {
+      kill(getppid(), SIGKILL);
+      exit(0);
+    }
+    cliopt("file\tA file") {
+      file = cliarg;
+    }
+    cliopt();
+  }
+  if (getcwd(cwd, sizeof(cwd)) == NULL) cwd[0] = '\0';
+  printf("%s %d %d %d %s\n", file, level, loaded, calls, cwd);
+  return level;
+}
+
+static char out[512];
+
+// Forwards the arguments with stdout and stderr redirected to a temporary file
+static int forward(char *sock, int argc, char **argv)
+{
+  char tmp[] = "/tmp/t_serveXXXXXX";
+  int fd = mkstemp(tmp);
+  int saved_out = dup(1), saved_err = dup(2);
+  fflush(stdout);
+  dup2(fd, 1);
+  dup2(fd, 2);
+  int rc = cliforward(sock, argc, argv);
+  dup2(saved_out, 1);
+  dup2(saved_err, 2);
+  close(saved_out);
+  close(saved_err);
+  lseek(fd, 0, SEEK_SET);
+  int n = read(fd, out, sizeof(out) - 1);
+  out[n > 0 ? n : 0] = '\0';
+  close(fd);
+  unlink(tmp);
+  return rc;
+}
+
+#ifdef __linux__
+#include <dirent.h>
+
+static int open_fds(pid_t pid)
+{
+  char dir[64];
+  int n = 0;
+  snprintf(dir, sizeof(dir), "/proc/%d/fd", (int)pid);
+  DIR *d = opendir(dir);
+  if (d == NULL) return -1;
+  while (readdir(d) != NULL) n++;
+  closedir(d);
+  return n;
+}
+
+// Sends a request with `n` file descriptors and waits for the server to close it
+static int send_fds(char *path, int n)
+{
+  struct sockaddr_un addr;
+  cli_serve_hdr_t hdr = {8, 1, 0};
+  int fds[4] = {0, 1, 2, 0};
+  union {struct cmsghdr h; char buf[CMSG_SPACE(sizeof(fds))];} ctl;
+  struct iovec iov = {&hdr, sizeof(hdr)};
+  struct msghdr msg = {0};
+  char c;
+  int sock = cli_serve_socket(&addr, path);
+  if (sock < 0 || connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) return -1;
+  msg.msg_iov = &iov; msg.msg_iovlen = 1;
+  msg.msg_control = ctl.buf; msg.msg_controllen = CMSG_SPACE(n * sizeof(int));
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type  = SCM_RIGHTS;
+  cmsg->cmsg_len   = CMSG_LEN(n * sizeof(int));
+  memcpy(CMSG_DATA(cmsg), fds, n * sizeof(int));
+  int rc = sendmsg(sock, &msg, MSG_NOSIGNAL) == (ssize_t)sizeof(hdr) && recv(sock, &c, 1, 0) == 0 ? 0 : -1;
+  close(sock);
+  return rc;
+}
+#endif
+
+#define fwd(...) forward(sock, sizeof((char *[]){"t_serve", __VA_ARGS__}) / sizeof(char *), \
+                               (char *[]){"t_serve", __VA_ARGS__, NULL})
+
+tstsuite("Warm server")
+{
+  char sock[] = "/tmp/t_serve.sock";
+  pid_t server;
+
+  tstcase("Only a socket is replaced") {
+    FILE *f = fopen(sock, "w");
+    tstassert(f != NULL);
+    fclose(f);
+    tstcheck(cliserve(sock, run) == -1);
+    tstcheck(access(sock, F_OK) == 0);
+  }
+
+  tstcase("No server") {
+    unlink(sock);
+    tstcheck(fwd("x") == -1);
+  }
+
+  server = fork();
+  if (server == 0) {
+    loaded = 1;
+    cliserve(sock, run);
+    _exit(99);
+  }
+  // Waits for the server to be listening
+  for (int k = 0; k < 100 && fwd("-l", "0", "probe") != 0; k++)
+    nanosleep(&(struct timespec){0, 10000000}, NULL);
+
+  tstcase("Arguments and exit code") {
+    tstcheck(fwd("-l", "3", "a.txt") == 3);
+    tstcheck(strncmp(out, "a.txt 3 1 1 ", 12) == 0, "%s", out);
+    tstcheck(fwd("-l2", "b.txt") == 2);
+    tstcheck(strncmp(out, "b.txt 2 1 1 ", 12) == 0, "%s", out);
+  }
+
+  tstcase("Environment and directory") {
+    setenv("LEVEL", "5", 1);
+    tstcheck(chdir("/tmp") == 0);
+    tstcheck(fwd("c.txt") == 5);
+    unsetenv("LEVEL");
+    tstcheck(strcmp(out, "c.txt 5 1 1 /tmp\n") == 0, "%s", out);
+  }
+
+  tstcase("Errors and exit() in handlers") {
+    tstcheck(fwd("-q", "d.txt") == 7);
+    tstcheck(fwd("-l", "4") == 1);
+    tstcheck(strcmp(out, "t_serve: ERROR: Missing or invalid value for 'file'\n\n") == 0, "%s", out);
+    tstcheck(fwd("-l", "1", "e.txt") == 1);
+    tstcheck(strncmp(out, "e.txt 1 1 1 ", 12) == 0, "%s", out);
+  }
+
+  tstcase("No directory") {
+    char dir[] = "/tmp/t_serveXXXXXX";
+    tstassert(mkdtemp(dir) != NULL && chdir(dir) == 0);
+    rmdir(dir);
+    tstcheck(fwd("-l", "3", "f.txt") == -1);   // Not run in the directory of the server
+    tstcheck(out[0] == '\0', "%s", out);
+    tstcheck(chdir("/tmp") == 0);
+  }
+
+#ifdef __linux__
+  tstcase("Malformed requests") {
+    int before = open_fds(server), wrong[] = {1, 2, 4};
+    for (int k = 0; k < 3; k++) tstcheck(send_fds(sock, wrong[k]) == 0);
+    tstcheck(open_fds(server) == before, "%d != %d", open_fds(server), before);
+  }
+#endif
+
+  tstcase("The server is gone") {
+    tstcheck(fwd("-k", "g.txt") == -2);
+    waitpid(server, NULL, 0);
+    tstcheck(fwd("h.txt") == -1);
+  }
+
+  kill(server, SIGTERM);
+  waitpid(server, NULL, 0);
+  unlink(sock);
+}
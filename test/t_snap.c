@@ -0,0 +1,107 @@
+#define _POSIX_C_SOURCE 200809L
+#define CLI_SNAPSHOT
+#define CLITEST_PROG "t_snap"
+#include "clitest.h"
+#include "tst.h"
+
+static char res[256];   // What the handlers have seen
+static int  checks;     // Validations run
+
+static char *count_chk(char *arg)
+{
+  checks++;
+  return NULL;
+}
+
+static int parse_args(int argc, char **argv)
+{
+  int verbose = 0, level = 0, env = -1, def = -1, rest = 0, fndx = 0;
+  char *name = "", *file = "";
+  checks = 0;
+  res[0] = '\0';
+  clitest_catch();
+  clioptions("snapshot test", argc, argv) {
+    cliopt("-v, --verbose\tMore output") { verbose++; }
+    cliopt("-l, --level n ($SNAP_LEVEL,1)\tA level", count_chk) {
+      level = atoi(cliarg);
+      env = cliisenv();
+      def = cliisdefault();
+    }
+    cliopt("-n, --name name (nobody)\tA name") { name = cliarg; }
+    cliopt("file\tA file", count_chk) { file = cliarg; fndx = clindx; }
+    cliopt() { rest++; }
+  }
+  snprintf(res, sizeof(res), "v=%d l=%d env=%d def=%d n=%s f=%s@%d r=%d",
+                             verbose, level, env, def, name, file, fndx, rest);
+  return 0;
+}
+
+// The arguments must still be there when the snapshot is taken
+#define parse_argv(a_) parse_args(sizeof(a_) / sizeof(char *) - 1, a_)
+
+tstsuite("Snapshots of the parsed options")
+{
+  static char copy[4096];
+  static char first[256];
+  char *args1[] = {"t_snap", "-vv", "--name=bob", "a.txt", "x", NULL};
+  char *args2[] = {"t_snap", "-l", "7", "-vn", "ann", "c.txt", NULL};
+  size_t len = 0;
+  char *blob;
+
+  tstcase("Replay from memory") {
+    setenv("SNAP_LEVEL", "5", 1);
+    tstcheck(parse_argv(args1) == 0);
+    tstcheck(strcmp(res, "v=2 l=5 env=1 def=1 n=bob f=a.txt@3 r=1") == 0, "%s", res);
+    tstcheck(checks == 2);
+    strcpy(first, res);
+
+    blob = clisnapshot(&len);
+    tstassert(blob != NULL && len < sizeof(copy));
+    memcpy(copy, blob, len);
+    memset(blob, 0, len);
+    unsetenv("SNAP_LEVEL");
+
+    tstcheck(clirestore(copy, len) == 0);
+    tstcheck(parse("-l", "9", "b.txt") == 0);
+    tstcheck(strcmp(res, first) == 0, "%s", res);
+    tstcheck(checks == 0, "checks: %d", checks);
+
+    // The replay records the same snapshot
+    blob = clisnapshot(&len);
+    tstcheck(blob != NULL && memcmp(blob, copy, len) == 0);
+  }
+
+  tstcase("Only the next block is replayed") {
+    tstcheck(parse("b.txt") == 0);
+    tstcheck(strcmp(res, "v=0 l=1 env=0 def=1 n=nobody f=b.txt@1 r=0") == 0, "%s", res);
+    tstcheck(checks == 2);
+  }
+
+  tstcase("Replay from a file") {
+    tstcheck(parse_argv(args2) == 0);
+    strcpy(first, res);
+    int fd = clisnapfd();
+    tstassert(fd >= 0);
+    tstcheck(clirestore(fd) == 0);
+    close(fd);
+    tstcheck(parse_args(1, (char *[]){"t_snap", NULL}) == 0);
+    tstcheck(strcmp(res, first) == 0, "%s", res);
+    tstcheck(strcmp(res, "v=1 l=7 env=0 def=0 n=ann f=c.txt@5 r=0") == 0, "%s", res);
+    tstcheck(checks == 0);
+  }
+
+  tstcase("Invalid snapshots") {
+    tstcheck(clirestore(copy, len - 1) == -1);
+    tstcheck(clirestore(NULL, len) == -1);
+    tstcheck(clirestore(-1) == -1);
+    ((cli_snap_hdr_t *)copy)->version++;
+    tstcheck(clirestore(copy, len) == -1);
+    ((cli_snap_hdr_t *)copy)->version--;
+    ((cli_snap_rec_t *)(copy + sizeof(cli_snap_hdr_t)))->val = (unsigned int)len;
+    tstcheck(clirestore(copy, len) == -1);
+
+    // Nothing to replay: the arguments are parsed
+    tstcheck(parse("d.txt") == 0);
+    tstcheck(strcmp(res, "v=0 l=1 env=0 def=1 n=nobody f=d.txt@1 r=0") == 0, "%s", res);
+  }
+}
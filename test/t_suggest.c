@@ -0,0 +1,117 @@
+#define CLITEST_PROG "t_suggest"
+#include "clitest.h"
+#include "tst.h"
+
+static char *names[8];
+static int   found = -1;
+
+// `found` is the number of suggestions for the last unknown argument.
+static int parse_args(int argc, char **argv)
+{
+  found = -1;
+  clitest_catch();
+  clioptions("suggest test", argc, argv) {
+    cliopt("-v, --verbose\tBe verbose") { }
+    cliopt("--version\tPrint the version") { }
+    cliopt("--verse\tIn verse") { }
+    cliopt("-o, --output file\tOutput file") { }
+    cliopt("--color [when]\tColorize") { }
+    cliopt("-x\tShort only") { }
+    cliopt("<build>\tBuild") { }
+    cliopt("<bench>\tBenchmark") { }
+    cliopt("<test>\tTest") { }
+    cliopt() {
+      if (cliarg[0] == '!') found = clisuggest(cliarg + 1, names, 8);
+      else cliunknown();
+    }
+  }
+  return 0;
+}
+
+// Plain dynamic programming, to check the bit-parallel version
+static int levenshtein(const char *a, int m, const char *b, int n)
+{
+  int row[65];
+  for (int i = 0; i <= m; i++) row[i] = i;
+  for (int j = 1; j <= n; j++) {
+    int diag = row[0];
+    row[0] = j;
+    for (int i = 1; i <= m; i++) {
+      int up = row[i];
+      int d = diag + (a[i-1] != b[j-1]);
+      if (row[i-1] + 1 < d) d = row[i-1] + 1;
+      if (up + 1 < d) d = up + 1;
+      row[i] = d;
+      diag = up;
+    }
+  }
+  return row[m];
+}
+
+tstsuite("Suggestions for unknown options")
+{
+  cliwrite = to_buffer;
+
+  tstcase("Distance") {
+    unsigned int x = 1;
+    int errors = 0;
+    char a[64], b[64];
+    for (int t = 0; t < 2000; t++) {
+      int m = (x = x * 1664525u + 1013904223u) >> 26;   // 0..63
+      int n = (x = x * 1664525u + 1013904223u) >> 26;
+      for (int k = 0; k < m; k++) a[k] = 'a' + ((x = x * 1664525u + 1013904223u) >> 30);
+      for (int k = 0; k < n; k++) b[k] = 'a' + ((x = x * 1664525u + 1013904223u) >> 30);
+      cli_bk_pattern(a, m, 1);
+      errors += cli_bk_dist(m, b, n) != levenshtein(a, m, b, n);
+      cli_bk_pattern(a, m, 0);
+    }
+    tstcheck(errors == 0, "%d", errors);
+  }
+
+  tstcase("Closest first") {
+    tstcheck(parse("!--versio") == 0);
+    tstcheck(found == 2 && strcmp(names[0], "--version") == 0 && strcmp(names[1], "--verse") == 0);
+    tstcheck(parse("!--verbse") == 0);   // Same distance: in order of definition
+    tstcheck(found == 2 && strcmp(names[0], "--verbose") == 0 && strcmp(names[1], "--verse") == 0);
+    tstcheck(parse("!--vresion") == 0);
+    tstcheck(found == 1 && strcmp(names[0], "--version") == 0);
+    tstcheck(parse("!--outptu=x.txt") == 0);
+    tstcheck(found == 1 && strcmp(names[0], "--output") == 0);
+    tstcheck(parse("!-color") == 0);
+    tstcheck(found == 1 && strcmp(names[0], "--color") == 0);
+  }
+
+  tstcase("Commands") {
+    tstcheck(parse("!biuld") == 0);
+    tstcheck(found == 1 && strcmp(names[0], "build") == 0);
+    tstcheck(parse("!bensh") == 0);
+    tstcheck(found == 1 && strcmp(names[0], "bench") == 0);
+    tstcheck(parse("!tst") == 0);
+    tstcheck(found == 1 && strcmp(names[0], "test") == 0);
+  }
+
+  tstcase("Nothing close enough") {
+    tstcheck(parse("!--frobnicate") == 0 && found == 0);
+    tstcheck(parse("!-y") == 0 && found == 0);
+    tstcheck(parse("!ab") == 0 && found == 0);
+  }
+
+  tstcase("Unknown option message") {
+    tstcheck(parse("--verbos") == 2);
+    tstcheck(strcmp(out, "t_suggest: ERROR: Unknown option '--verbos' (did you mean '--verbose'?)\n\n") == 0, "%s", out);
+    tstcheck(parse("--versio=3") == 2);
+    tstcheck(strcmp(out, "t_suggest: ERROR: Unknown option '--versio=3' (did you mean '--version', '--verse'?)\n\n") == 0, "%s", out);
+    tstcheck(parse("--nope") == 2);
+    tstcheck(strcmp(out, "t_suggest: ERROR: Unknown option '--nope'\n\n") == 0, "%s", out);
+  }
+
+  tstcase("Options of another block") {
+    char *argv[] = {"t_suggest", "!--verbatin", NULL};
+    found = -1;
+    clioptions(2, argv) {
+      cliopt("--verbatim\tVerbatim") { }
+      cliopt() { found = clisuggest(cliarg + 1, names, 8); }
+    }
+    tstcheck(found == 1 && strcmp(names[0], "--verbatim") == 0);
+  }
+}
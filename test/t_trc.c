@@ -0,0 +1,73 @@
+#include "trc.h"
+#include "cli.h"
+#include "tst.h"
+
+static char line[1024];
+
+// Reads the traces written so far in `trc_out`
+static int read_traces(FILE *f, char *last)
+{
+  int n = 0;
+  trcflush();
+  rewind(f);
+  while (fgets(line, sizeof(line), f)) {
+    if (last) strcpy(last, line);
+    n++;
+  }
+  rewind(f);
+  return n;
+}
+
+static int trace_cli(int argc, char **argv)
+{
+  clioptions("trace test") {
+    cliopt("-t name") {
+      cli_trace("%s (%d)", cliarg, 3);
+    }
+    cliopt();
+  }
+  return 0;
+}
+
+tstsuite("Deferred traces")
+{
+  char last[1024];
+  trc_out = tmpfile();
+
+  tstcase("Formatting") {
+    trcdebug("x=%d s=%s d=%.2f c=%c u=%x", -3, "abc", 1.5, 'z', 255u);
+    tstcheck(read_traces(trc_out, last) == 1);
+    tstcheck(strncmp(last, "x=-3 s=abc d=1.50 c=z u=ff :", 28) == 0, "%s", last);
+  }
+
+  tstcase("Wrong format") {
+    trc_out = freopen(NULL, "w+", trc_out);
+    trcdebug("%d %s %ld %%", "str", 42, (short)7);
+    tstcheck(read_traces(trc_out, last) == 1);
+    tstcheck(strncmp(last, "str 42 7 % :", 12) == 0, "%s", last);
+  }
+
+  tstcase("Strings are copied") {
+    char buf[16] = "before";
+    trc_out = freopen(NULL, "w+", trc_out);
+    trcinfo("%s", buf);
+    strcpy(buf, "after");
+    tstcheck(read_traces(trc_out, last) == 1);
+    tstcheck(strncmp(last, "INFO: before :", 14) == 0, "%s", last);
+  }
+
+  tstcase("More traces than the ring size") {
+    trc_out = freopen(NULL, "w+", trc_out);
+    for (int k = 0; k < 3 * TRC_RING_SIZE + 10; k++)
+      trcdebug("%d", k);
+    tstcheck(read_traces(trc_out, last) == 3 * TRC_RING_SIZE + 10);
+    tstcheck(atoi(last) == 3 * TRC_RING_SIZE + 9, "%s", last);
+  }
+
+  tstcase("cli_trace") {
+    trc_out = freopen(NULL, "w+", trc_out);
+    trace_cli(3, (char *[]){"t_trc", "-t", "arg", NULL});
+    tstcheck(read_traces(trc_out, last) == 1);
+    tstcheck(strncmp(last, "arg (3) :t_trc.c:", 17) == 0, "%s", last);
+  }
+}
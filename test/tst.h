@@ -1,9 +1,9 @@
 //  SPDX-FileCopyrightText: © 2023 Remo Dentato (rdentato@gmail.com)
 //  SPDX-License-Identifier: MIT
-//  SPDX-PackageVersion: 0.7.4-rc
+//  SPDX-PackageVersion: 0.7.5-rc
 
 #ifndef TST_VERSION
-#define TST_VERSION 0x0007004C
+#define TST_VERSION 0x0007005C
 
 #ifdef _MSC_VER
   /* Microsoft cl compiler */
@@ -54,6 +54,7 @@ const char *tst_str_file      = "SUIT /";
 const char *tst_str_file_end  = "^^^^^ RSLT \\ ";
 const char *tst_str_file_abr  = "^^^^^ ABRT \\ ";
 const char *tst_str_clck      = "CLCK:  %ld %ss ";
+const char *tst_str_bnch      = "BNCH:  %.2f ns min | %.2f ns median | %.2f ns p99 | %.4g ops/s  %s";
 const char *tst_str_note      = "NOTE:";
 const char *tst_str_sctn      = "SCTN|,--";
 const char *tst_str_sctn_end  = "    |`---";
@@ -111,9 +112,21 @@ static unsigned char tst_tags_val = 0x00; // All tags are "off" by default
 
 static inline int tst_tags_zero(); // tst_tags_zero() always returns 0 and is used just to avoid compiler warnings.
 
-#define TST_STR_HELP_NOTAGS "[--help] [--color] [--report-error] [--list]"
+#define TST_STR_HELP_NOTAGS "[--help] [--color] [--report-error] [--list] [--save=file] [--baseline=file]"
 #define TST_STR_HELP_TAGS   " [+/-]tag ... ]\ntags:" 
 
+static char tst_bench_save[256] = "";  // Where to append the results of `tstbench()`
+static char tst_bench_base[256] = "";  // Where to read the baseline for `tstbench()`
+
+// Copies the value of an option (after '=', up to the first space) in `buf`
+static inline void tst_optval(const char *arg, char *buf, int size) {
+  int n = 0;
+  while (*arg && *arg != '=' && !isspace(*arg)) arg++;
+  if (*arg == '=') arg++;
+  while (n < size - 1 && arg[n] && !isspace(arg[n])) { buf[n] = arg[n]; n++; }
+  buf[n] = '\0';
+}
+
 static inline short tst_parse_tags(int argc, const char **argv, int ntags, const char **names) {
   unsigned char v;
   const char *arg;
@@ -128,6 +141,8 @@ static inline short tst_parse_tags(int argc, const char **argv, int ntags, const
         switch (arg[2]) {
           case 'r': report_error = 1; break;
           case 'c': tst_color ^= 1; break;
+          case 's': tst_optval(arg, tst_bench_save, sizeof(tst_bench_save)); break;
+          case 'b': tst_optval(arg, tst_bench_base, sizeof(tst_bench_base)); break;
           case 'h': fprintf(stderr,"Test suite: \"%s\"\n%s %s", tst_title, argv[0], TST_STR_HELP_NOTAGS);
                     if (ntags>0) fputs(TST_STR_HELP_TAGS,stderr);
                     goto prttags;
@@ -239,6 +254,158 @@ static clock_t tstelapsed = 0;
       tstelapsed=(clock()-tst_clk), \
         tst_prtln(""), fprintf(stderr, tst_str_clck, tstelapsed, tst_clock_unit), tst_clk=tst_prtf(__VA_ARGS__))
 
+// ## Benchmarks
+// `tstbench(name [, samples]) { ... }` runs the block many times and reports the time
+// of one execution: minimum, median and 99th percentile over `samples` timed samples
+// (`TST_BENCH_SAMPLES` by default), and the operations per second for the median.
+//
+// The number of executions in each sample is doubled until a sample lasts at least
+// `TST_BENCH_MIN_NS`; then `TST_BENCH_WARMUP` samples are run and discarded before the
+// timed ones. The clock is `CLOCK_MONOTONIC` if it's available (define `_POSIX_C_SOURCE`
+// as 200809L before including any header), `timespec_get()` otherwise. Keep the results
+// of the block in a `volatile` variable, or the compiler could remove it.
+//
+// With `--save=file` a line for each benchmark is appended to the file ("-" for stdout):
+//
+//     <source file> <TAB> <name> <TAB> <min> <TAB> <median> <TAB> <p99> <TAB> <ops/s>
+//
+// With `--baseline=file` (a file written with `--save`), the median of each benchmark is
+// compared with the one in the file and is checked as `tstcheck()` does: it fails if it
+// is more than `TST_BENCH_TOLERANCE` percent slower.
+
+#ifndef TST_BENCH_SAMPLES
+#define TST_BENCH_SAMPLES   50
+#endif
+
+#ifndef TST_BENCH_MAX
+#define TST_BENCH_MAX       1000
+#endif
+
+#ifndef TST_BENCH_MIN_NS
+#define TST_BENCH_MIN_NS    200000.0
+#endif
+
+#ifndef TST_BENCH_WARMUP
+#define TST_BENCH_WARMUP    3
+#endif
+
+#ifndef TST_BENCH_TOLERANCE
+#define TST_BENCH_TOLERANCE 10.0
+#endif
+
+typedef struct {
+  const char *name;
+  const char *file;
+  int         line;
+  int         samples;
+  int         k;                   // Samples taken in the current phase
+  int         phase;               // 0: calibration, 1: warm up, 2: timed samples
+  int         result;              // 1/0: faster/slower than the baseline, -1: no baseline
+  long        batch;               // Executions of the block in a sample
+  double      t0;                  // Start of the current sample (ns)
+  double      ns[TST_BENCH_MAX];   // Time of one execution in each timed sample
+} tst_bench_t;
+
+static inline double tst_now_ns(void) {
+#if defined(CLOCK_MONOTONIC)
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+#elif defined(TIME_UTC)
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+#else
+  return clock() * (1e9 / CLOCKS_PER_SEC);
+#endif
+}
+
+static inline tst_bench_t *tst_bench_init(tst_bench_t *b, const char *name, const char *file, int line, int samples) {
+  b->name = name; b->file = file; b->line = line;
+  b->samples = samples < 1 ? 1 : samples > TST_BENCH_MAX ? TST_BENCH_MAX : samples;
+  b->k = 0; b->phase = 0; b->result = -1; b->batch = 1; b->t0 = 0;
+  return b;
+}
+
+static inline int tst_cmp_double(const void *a, const void *b) {
+  return (*(const double *)a > *(const double *)b) - (*(const double *)a < *(const double *)b);
+}
+
+// Median of the benchmark in the baseline file (-1 if it's not there)
+static inline double tst_bench_baseline(tst_bench_t *b) {
+  char line[512];
+  double median = -1;
+  size_t flen = strlen(b->file), nlen = strlen(b->name);
+  FILE *f = fopen(tst_bench_base, "r");
+  if (f == NULL) return -1;
+  while (median < 0 && fgets(line, sizeof(line), f)) {
+    if (strncmp(line, b->file, flen) == 0 && line[flen] == '\t' &&
+        strncmp(line + flen + 1, b->name, nlen) == 0 && line[flen + 1 + nlen] == '\t')
+      sscanf(line + flen + 1 + nlen, "%*f %lf", &median);
+  }
+  fclose(f);
+  return median;
+}
+
+static inline void tst_bench_report(tst_bench_t *b) {
+  int n = b->samples;
+  double min, median, p99, base;
+  qsort(b->ns, n, sizeof(double), tst_cmp_double);
+  min = b->ns[0]; median = b->ns[n / 2]; p99 = b->ns[(n * 99) / 100 < n ? (n * 99) / 100 : n - 1];
+
+  fprintf(stderr, "%5d ", b->line);
+  tst_prtf(tst_str_bnch, min, median, p99, 1e9 / median, b->name);
+
+  if (tst_bench_save[0]) {
+    FILE *f = strcmp(tst_bench_save, "-") == 0 ? stdout : fopen(tst_bench_save, "a");
+    if (f != NULL) {
+      fprintf(f, "%s\t%s\t%.3f\t%.3f\t%.3f\t%.0f\n", b->file, b->name, min, median, p99, 1e9 / median);
+      if (f != stdout) fclose(f);
+    }
+  }
+
+  if (tst_bench_base[0]) {
+    if ((base = tst_bench_baseline(b)) <= 0) {
+      fprintf(stderr, "%5d %s No baseline for \"%s\"\n", b->line, tst_str_note, b->name);
+      return;
+    }
+    tst_result = (short)(b->result = (median <= base * (1 + TST_BENCH_TOLERANCE / 100)));
+    fprintf(stderr, "%5d %s%s%s%+.1f%% vs baseline (%.2f ns) \"%s\"\n", b->line,
+            tst_color + (tst_result ? tst_str_green : tst_str_red), tst_result ? tst_str_pass : tst_str_fail,
+            tst_str_normal + tst_color, (median / base - 1) * 100, base, b->name);
+  }
+}
+
+// Called before each sample: returns 0 when all the samples have been taken.
+static inline int tst_bench_next(tst_bench_t *b) {
+  double now = tst_now_ns(), dt = now - b->t0;
+  if (b->t0 > 0) {
+    switch (b->phase) {
+      case 0: if (dt < TST_BENCH_MIN_NS && b->batch < (1L << 30)) b->batch *= 2;
+              else b->phase = 1;
+              break;
+      case 1: if (++b->k >= TST_BENCH_WARMUP) { b->phase = 2; b->k = 0; }
+              break;
+      case 2: b->ns[b->k++] = dt / b->batch;
+              if (b->k >= b->samples) { tst_bench_report(b); return 0; }
+              break;
+    }
+  }
+  b->t0 = tst_now_ns();
+  return 1;
+}
+
+#define tstbench(...) tst_vrg(tstbench_,__VA_ARGS__)
+#define tstbench_1(name_) tstbench_2(name_, TST_BENCH_SAMPLES)
+#define tstbench_2(name_, samples_) \
+  for (tst_bench_t tst_bench, *tst_b = tst_bench_init(&tst_bench, name_, __FILE__, __LINE__, samples_); \
+       tst_bench_next(tst_b) || (tst_bench_count(tst_b->result), 0); ) \
+    for (long tst_i = tst_b->batch; tst_i > 0; tst_i--)
+
+// The counters of the current `tstcase()` are visible only here
+#define tst_bench_count(r_) \
+  ((r_) > 0 ? (tst_pass++, tst_case_pass++) : (r_) == 0 ? (tst_fail++, tst_case_fail++) : 0)
+
 #define tstnote(...) (tst_prtln(tst_str_note), tst_prtf( " " __VA_ARGS__))
 
 #define tstouterr(...) for (int tst_k = (tst_prtln(tst_str_scrn),tst_prtf(" " __VA_ARGS__ ),1); \
@@ -279,6 +446,7 @@ static volatile unsigned short tstdata[1]={0};
 #define tst_note(...)
 #define tst_skpif(...)    if ( tst_zero) ; else
 #define tst_clock(...)    if ( tst_zero) ; else
+#define tst_bench(...)    if (!tst_zero) ; else
 #define tst_case(...)     if (!tst_zero) ; else
 #define tst_section(...)  if (!tst_zero) ; else
 